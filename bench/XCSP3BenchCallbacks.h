@@ -0,0 +1,139 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XCSP3BENCHCALLBACKS_H
+#define XCSP3BENCHCALLBACKS_H
+
+#include "XCSP3CoreCallbacks.h"
+
+/**
+ * Callbacks doing nothing, used to measure the cost of the parser itself.
+ * Every constraint produced by the generated instances (see XCSP3BenchInstances.h) is accepted.
+ * nbConstraints counts them, so that a scenario can be checked quickly.
+ */
+
+namespace XCSP3Core {
+
+    class XCSP3BenchCallbacks : public XCSP3CoreCallbacks {
+    public:
+        long nbVariables = 0;
+        long nbConstraints = 0;
+
+
+        void buildVariableInteger(string, int, int) override { nbVariables++; }
+
+
+        void skippedConstraint(string, string, int, size_t) override { nbConstraints++; }
+
+
+        void buildVariableInteger(string, vector<int> &) override { nbVariables++; }
+
+
+        void buildConstraintExtension(string, vector<XVariable *>, vector<vector<int>> &, bool, bool) override { nbConstraints++; }
+
+
+        void buildConstraintExtension(string, XVariable *, vector<int> &, bool, bool) override { nbConstraints++; }
+
+
+        void buildConstraintExtensionAs(string, vector<XVariable *>, bool, bool) override { nbConstraints++; }
+
+
+        void buildConstraintIntension(string, string) override { nbConstraints++; }
+
+
+        void buildConstraintIntension(string, Tree *) override { nbConstraints++; }
+
+
+        void buildConstraintPrimitive(string, OrderType, XVariable *, int, XVariable *) override { nbConstraints++; }
+
+
+        void buildConstraintPrimitive(string, OrderType, XVariable *, int) override { nbConstraints++; }
+
+
+        void buildConstraintPrimitive(string, XVariable *, bool, int, int) override { nbConstraints++; }
+
+
+        void buildConstraintMult(string, XVariable *, XVariable *, XVariable *) override { nbConstraints++; }
+
+
+        void buildConstraintRegular(string, vector<XVariable *> &, string, vector<string> &, vector<XTransition> &) override { nbConstraints++; }
+        void buildConstraintRegular(string, vector<XVariable *> &, int, vector<int> &, XAutomaton &) override { nbConstraints++; }
+        void buildConstraintRegularAs(string, vector<XVariable *> &, int, vector<int> &, XAutomaton &) override { nbConstraints++; }
+
+
+        void buildConstraintMDD(string, vector<XVariable *> &, vector<XTransition> &) override { nbConstraints++; }
+        void buildConstraintMDD(string, vector<XVariable *> &, XAutomaton &) override { nbConstraints++; }
+        void buildConstraintMDDAs(string, vector<XVariable *> &, XAutomaton &) override { nbConstraints++; }
+
+
+        void buildConstraintAlldifferent(string, vector<XVariable *> &) override { nbConstraints++; }
+
+
+        void buildConstraintAllEqual(string, vector<XVariable *> &) override { nbConstraints++; }
+
+
+        void buildConstraintNotAllEqual(string, vector<XVariable *> &) override { nbConstraints++; }
+
+
+        void buildConstraintSum(string, vector<XVariable *> &, vector<int> &, XCondition &) override { nbConstraints++; }
+
+
+        void buildConstraintSum(string, vector<XVariable *> &, XCondition &) override { nbConstraints++; }
+
+
+        void buildConstraintSum(string, vector<XVariable *> &, vector<XVariable *> &, XCondition &) override { nbConstraints++; }
+
+
+        void buildConstraintSum(string, vector<Tree *> &, XCondition &) override { nbConstraints++; }
+
+
+        void buildConstraintSum(string, vector<Tree *> &, vector<int> &, XCondition &) override { nbConstraints++; }
+
+
+        void buildConstraintCount(string, vector<XVariable *> &, vector<int> &, XCondition &) override { nbConstraints++; }
+
+
+        void buildConstraintAtMost(string, vector<XVariable *> &, int, int) override { nbConstraints++; }
+
+
+        void buildConstraintAtLeast(string, vector<XVariable *> &, int, int) override { nbConstraints++; }
+
+
+        void buildConstraintExactlyK(string, vector<XVariable *> &, int, int) override { nbConstraints++; }
+
+
+        void buildConstraintElement(string, vector<XVariable *> &, int, XVariable *, RankType, int) override { nbConstraints++; }
+
+
+        void buildObjectiveMinimizeVariable(XVariable *) override { }
+
+
+        void buildObjectiveMinimize(ExpressionObjective, vector<XVariable *> &, vector<int> &) override { }
+
+
+        void buildObjectiveMinimize(ExpressionObjective, vector<XVariable *> &) override { }
+    };
+}
+
+#endif /* XCSP3BENCHCALLBACKS_H */
@@ -0,0 +1,254 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#include "XCSP3BenchInstances.h"
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+    // Small deterministic generator (same instances on all platforms)
+    class Random {
+        unsigned long long state;
+    public:
+        explicit Random(unsigned long long seed) : state(seed) { }
+
+
+        int next(int bound) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<int>((state >> 33) % static_cast<unsigned long long>(bound));
+        }
+    };
+
+
+    void header(ostream &out, const char *type = "CSP") {
+        out << "<instance format=\"XCSP3\" type=\"" << type << "\">\n";
+    }
+
+
+    void arrays(int scale, ostream &out) {
+        header(out);
+        out << "<variables>\n";
+        out << "  <array id=\"x\" size=\"[" << 100 * scale << "][10][10]\"> 0..100 </array>\n";
+        out << "  <array id=\"y\" size=\"[" << 10 * scale << "][100]\">\n";
+        out << "    <domain for=\"y[][0..49]\"> 0..9 </domain>\n";
+        out << "    <domain for=\"others\"> 1 3 5 7 11 13 17 19 23 29 </domain>\n";
+        out << "  </array>\n";
+        for(int i = 0 ; i < 100 * scale ; i++)
+            out << "  <var id=\"v" << i << "\"> 0.." << 10 + i % 50 << " </var>\n";
+        out << "</variables>\n<constraints>\n";
+        for(int i = 0 ; i < 10 * scale ; i++)
+            out << "  <allDifferent> x[" << i << "][][" << i % 10 << "] y[" << i << "][3..12] </allDifferent>\n";
+        out << "</constraints>\n</instance>\n";
+    }
+
+
+    void extension(int scale, ostream &out) {
+        Random random(1);
+        header(out);
+        out << "<variables>\n  <array id=\"x\" size=\"[20]\"> 0..9 </array>\n</variables>\n<constraints>\n";
+        for(int c = 0 ; c < 10 ; c++) {
+            out << "  <extension>\n    <list> x[" << c << ".." << c + 9 << "] </list>\n    <supports> ";
+            for(int t = 0 ; t < 1000 * scale ; t++) {
+                out << '(';
+                for(int i = 0 ; i < 10 ; i++) {
+                    if(i > 0) out << ',';
+                    if(random.next(20) == 0) out << '*'; else out << random.next(10);
+                }
+                out << ')';
+            }
+            out << " </supports>\n  </extension>\n";
+        }
+        for(int c = 0 ; c < 20 ; c++)
+            out << "  <extension>\n    <list> x[" << c << "] </list>\n    <conflicts> 1 3..5 " << c % 10 << " </conflicts>\n  </extension>\n";
+        out << "</constraints>\n</instance>\n";
+    }
+
+
+    void expression(Random &random, int depth, int nbVars, ostream &out) {
+        static const char *binary[] = {"add", "sub", "mul", "dist", "max", "min"};
+        if(depth == 0) {
+            if(random.next(4) == 0)
+                out << random.next(10);
+            else
+                out << "x[" << random.next(nbVars) << "]";
+            return;
+        }
+        if(random.next(8) == 0) {
+            out << "abs(";
+            expression(random, depth - 1, nbVars, out);
+            out << ')';
+            return;
+        }
+        out << binary[random.next(6)] << '(';
+        expression(random, depth - 1, nbVars, out);
+        out << ',';
+        expression(random, depth > 1 ? depth - 1 - random.next(2) : 0, nbVars, out);
+        out << ')';
+    }
+
+
+    void intension(int scale, ostream &out) {
+        static const char *relational[] = {"lt", "le", "eq", "ne", "ge", "gt"};
+        Random random(2);
+        header(out);
+        out << "<variables>\n  <array id=\"x\" size=\"[100]\"> 0..20 </array>\n</variables>\n<constraints>\n";
+        for(int c = 0 ; c < 200 * scale ; c++) {
+            out << "  <intension> " << relational[random.next(6)] << '(';
+            expression(random, 2 + c % 6, 100, out);
+            out << ',';
+            expression(random, 1, 100, out);
+            out << ") </intension>\n";
+        }
+        // simple ones (recognized as primitives)
+        for(int c = 0 ; c < 200 * scale ; c++)
+            out << "  <intension> le(add(x[" << c % 100 << "]," << c % 7 << "),x[" << (c + 1) % 100 << "]) </intension>\n";
+        out << "</constraints>\n</instance>\n";
+    }
+
+
+    void group(int scale, ostream &out) {
+        Random random(3);
+        int n = 1000 * scale;
+        header(out);
+        out << "<variables>\n  <array id=\"x\" size=\"[" << n << "]\"> 0..9 </array>\n</variables>\n<constraints>\n";
+        out << "  <group>\n    <intension> ne(add(%0,%1),%2) </intension>\n";
+        for(int i = 0 ; i < n ; i++)
+            out << "    <args> x[" << i << "] x[" << (i + 1) % n << "] x[" << random.next(n) << "] </args>\n";
+        out << "  </group>\n";
+        out << "  <group>\n    <extension>\n      <list> %0 %1 </list>\n      <supports> ";
+        for(int a = 0 ; a < 10 ; a++)
+            for(int b = 0 ; b < 10 ; b++)
+                if(a != b) out << '(' << a << ',' << b << ')';
+        out << " </supports>\n    </extension>\n";
+        for(int i = 0 ; i < n ; i++)
+            out << "    <args> x[" << i << "] x[" << random.next(n) << "] </args>\n";
+        out << "  </group>\n";
+        out << "  <group>\n    <sum>\n      <list> %... </list>\n      <coeffs> 1 2 3 4 </coeffs>\n      <condition> (le,30) </condition>\n    </sum>\n";
+        for(int i = 0 ; i + 3 < n ; i += 4)
+            out << "    <args> x[" << i << ".." << i + 3 << "] </args>\n";
+        out << "  </group>\n";
+        out << "</constraints>\n</instance>\n";
+    }
+
+
+    void slide(int scale, ostream &out) {
+        int n = 5000 * scale;
+        header(out);
+        out << "<variables>\n  <array id=\"x\" size=\"[" << n << "]\"> 0..9 </array>\n</variables>\n<constraints>\n";
+        out << "  <slide>\n    <list> x[] </list>\n    <intension> lt(%0,%1) </intension>\n  </slide>\n";
+        out << "  <slide circular=\"true\">\n    <list> x[] </list>\n    <intension> ne(add(%0,%1),%2) </intension>\n  </slide>\n";
+        out << "</constraints>\n</instance>\n";
+    }
+
+
+    void sum(int scale, ostream &out) {
+        Random random(4);
+        int n = 10000 * scale;
+        header(out, "COP");
+        out << "<variables>\n  <array id=\"x\" size=\"[" << n << "]\"> 0..1 </array>\n</variables>\n<constraints>\n";
+        for(int c = 0 ; c < 5 ; c++) {
+            out << "  <sum>\n    <list> x[] ";
+            for(int i = 0 ; i < n / 10 ; i++)  // repeated variables, to be merged
+                out << "x[" << random.next(n) << "] ";
+            out << "</list>\n    <coeffs> ";
+            for(int i = 0 ; i < n + n / 10 ; i++)
+                out << random.next(21) - 10 << ' ';
+            out << "</coeffs>\n    <condition> (le," << n << ") </condition>\n  </sum>\n";
+        }
+        out << "  <sum>\n    <list> x[] x[0..99] </list>\n    <condition> (ge,1) </condition>\n  </sum>\n";
+        out << "</constraints>\n<objectives>\n  <minimize type=\"sum\">\n    <list> x[] </list>\n    <coeffs> ";
+        for(int i = 0 ; i < n ; i++)
+            out << 1 + random.next(100) << ' ';
+        out << "</coeffs>\n  </minimize>\n</objectives>\n</instance>\n";
+    }
+
+
+    void shortSums(int scale, ostream &out) {
+        Random random(6);
+        int n = 1000;
+        header(out);
+        out << "<variables>\n  <array id=\"x\" size=\"[" << n << "]\"> 0..9 </array>\n</variables>\n<constraints>\n";
+        for(int c = 0 ; c < 20000 * scale ; c++) {
+            int arity = 2 + c % 7;
+            out << "  <sum>\n    <list> ";
+            for(int i = 0 ; i < arity ; i++)  // some repeated variables, to be merged
+                out << "x[" << (random.next(4) == 0 ? c % n : random.next(n)) << "] ";
+            out << "</list>\n    <coeffs> ";
+            for(int i = 0 ; i < arity ; i++)
+                out << random.next(11) - 5 << ' ';
+            out << "</coeffs>\n    <condition> (le," << random.next(50) << ") </condition>\n  </sum>\n";
+        }
+        out << "  <group>\n    <sum>\n      <list> %... </list>\n      <condition> (ge,1) </condition>\n    </sum>\n";
+        for(int c = 0 ; c < 20000 * scale ; c++)
+            out << "    <args> x[" << random.next(n) << "] x[" << random.next(n) << "] x[" << random.next(n) << "] </args>\n";
+        out << "  </group>\n";
+        out << "</constraints>\n</instance>\n";
+    }
+
+
+    void automata(int scale, ostream &out) {
+        Random random(5);
+        int nbStates = 100 * scale, length = 50;
+        header(out);
+        out << "<variables>\n  <array id=\"x\" size=\"[" << length << "]\"> 0..4 </array>\n</variables>\n<constraints>\n";
+        for(int c = 0 ; c < 5 ; c++) {
+            out << "  <regular>\n    <list> x[] </list>\n    <transitions> ";
+            for(int s = 0 ; s < nbStates ; s++)
+                for(int v = 0 ; v < 5 ; v++)
+                    out << "(q" << s << ',' << v << ",q" << random.next(nbStates) << ')';
+            out << " </transitions>\n    <start> q0 </start>\n    <final> q1 q" << nbStates / 2 << " </final>\n  </regular>\n";
+        }
+        // A layered mdd: nbStates nodes per layer
+        out << "  <mdd>\n    <list> x[0..9] </list>\n    <transitions> ";
+        for(int v = 0 ; v < 5 ; v++)
+            out << "(r," << v << ",n1_" << random.next(nbStates) << ')';
+        for(int layer = 1 ; layer < 9 ; layer++)
+            for(int s = 0 ; s < nbStates ; s++)
+                for(int v = 0 ; v < 5 ; v += 2)
+                    out << "(n" << layer << '_' << s << ',' << v << ",n" << layer + 1 << '_' << random.next(nbStates) << ')';
+        for(int s = 0 ; s < nbStates ; s++)
+            out << "(n9_" << s << ',' << s % 5 << ",t)";
+        out << " </transitions>\n  </mdd>\n";
+        out << "</constraints>\n</instance>\n";
+    }
+}
+
+
+vector<string> XCSP3Core::benchScenarios() {
+    return {"arrays", "extension", "intension", "group", "slide", "sum", "shortsums", "automata"};
+}
+
+
+void XCSP3Core::generateBenchInstance(const string &scenario, int scale, ostream &out) {
+    if(scenario == "arrays") arrays(scale, out);
+    else if(scenario == "extension") extension(scale, out);
+    else if(scenario == "intension") intension(scale, out);
+    else if(scenario == "group") group(scale, out);
+    else if(scenario == "slide") slide(scale, out);
+    else if(scenario == "sum") sum(scale, out);
+    else if(scenario == "shortsums") shortSums(scale, out);
+    else if(scenario == "automata") automata(scale, out);
+    else throw runtime_error("unknown scenario: " + scenario);
+}
@@ -0,0 +1,56 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XCSP3BENCHINSTANCES_H
+#define XCSP3BENCHINSTANCES_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Synthetic XCSP3 instances used by the benchmarks.
+ * Each scenario stresses one part of the parser, its size grows linearly with scale.
+ * The generation is deterministic: same scenario and scale give the same document.
+ *
+ *  arrays     : large multi-dimensional arrays of variables (several domains)
+ *  extension  : wide tables of tuples (with stars) and unary extensions
+ *  intension  : deep random expressions
+ *  group      : large groups of intension and extension constraints
+ *  slide      : long slides
+ *  sum        : big weighted sums, with repeated variables
+ *  shortsums  : many short weighted sums (some repeated variables) and a group of short sums
+ *  automata   : regular and mdd constraints with many states
+ */
+
+namespace XCSP3Core {
+
+    std::vector<std::string> benchScenarios();
+
+
+    // Throws a runtime_error if the scenario is unknown
+    void generateBenchInstance(const std::string &scenario, int scale, std::ostream &out);
+}
+
+#endif /* XCSP3BENCHINSTANCES_H */
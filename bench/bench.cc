@@ -0,0 +1,313 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#include "XCSP3CoreParser.h"
+#include "XCSP3BenchCallbacks.h"
+#include "XCSP3BenchInstances.h"
+#include "XCSP3WriterCallbacks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define BENCH_POSIX
+#endif
+
+/**
+ * Parse the synthetic instances with callbacks doing nothing and print, for each scenario, a JSON object:
+ * wall time (best of the repetitions), throughput, number and size of allocations (one parse) and peak RSS.
+ *
+ * usage: xcsp3bench [-scale n] [-repeat n] [scenario...]       (all scenarios by default)
+ * -unfold n unfolds the large groups on n threads (see XCSP3CoreCallbacks::unfoldThreads).
+ *
+ * On POSIX systems each scenario runs in its own process, so peak RSS is not polluted by the previous ones.
+ */
+
+using namespace XCSP3Core;
+
+//------------------------------------------------------------------------------------------
+//  Allocation counters
+//------------------------------------------------------------------------------------------
+
+static std::atomic<unsigned long long> nbAllocations(0);
+static std::atomic<unsigned long long> allocatedBytes(0);
+
+void *operator new(size_t size) {
+    nbAllocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if(p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+
+void *operator new[](size_t size) { return operator new(size); }
+
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+
+void operator delete[](void *p) noexcept { std::free(p); }
+
+
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+
+void operator delete[](void *p, size_t) noexcept { std::free(p); }
+
+
+//------------------------------------------------------------------------------------------
+
+static long peakRSS() {  // in KB
+#ifdef BENCH_POSIX
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
+
+
+// Counts and discards what the writer produces
+class DiscardBuffer : public std::streambuf {
+   public:
+    unsigned long long count = 0;
+
+
+   protected:
+    int overflow(int c) override {
+        count++;
+        return c;
+    }
+
+
+    std::streamsize xsputn(const char *, std::streamsize n) override {
+        count += n;
+        return n;
+    }
+};
+
+
+// Counts the bytes read from another buffer (std::cin), it cannot seek like a pipe
+class CountingBuffer : public std::streambuf {
+    std::streambuf *source;
+
+   public:
+    unsigned long long count = 0;
+
+
+    explicit CountingBuffer(std::streambuf *s) : source(s) {}
+
+
+   protected:
+    std::streamsize xsgetn(char *s, std::streamsize n) override {
+        std::streamsize length = source->sgetn(s, n);
+        count += length;
+        return length;
+    }
+
+
+    int underflow() override { return source->sgetc(); }
+
+
+    int uflow() override {
+        int c = source->sbumpc();
+        if(c != traits_type::eof())
+            count++;
+        return c;
+    }
+};
+
+
+// Parse the standard input once: xcsp3generate extension 20 | xcsp3bench -stdin
+static void runStdin(size_t chunk, size_t maxChunk, ReadAheadMode readAhead, int skip) {
+    std::ios::sync_with_stdio(false);
+    CountingBuffer counting(std::cin.rdbuf());
+    std::istream in(&counting);
+    XCSP3BenchCallbacks cb;
+    cb.skip = skip;
+    XCSP3CoreParser parser(&cb);
+    if(chunk > 0)
+        parser.setChunkSize(chunk, std::max(chunk, maxChunk));
+    parser.setReadAhead(readAhead);
+    auto start = std::chrono::steady_clock::now();
+    parser.parse(in);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    static const char *modes[] = {"auto", "never", "always"};
+    std::printf("[\n  {\"scenario\": \"stdin\", \"bytes\": %llu, \"constraints\": %ld, \"chunk\": %zu, \"max_chunk\": %zu, "
+                "\"read_ahead\": \"%s\", \"wall_ms\": %.3f, \"mb_per_s\": %.2f, \"peak_rss_kb\": %ld}\n]\n",
+                counting.count, cb.nbConstraints, chunk, maxChunk, modes[readAhead], elapsed * 1000,
+                counting.count / (1024.0 * 1024.0) / elapsed, peakRSS());
+}
+
+
+static void runScenario(const std::string &scenario, int scale, int repeat, bool write, int skip, int unfoldThreads) {
+    std::ostringstream generated;
+    generateBenchInstance(scenario, scale, generated);
+    const std::string document = generated.str();
+
+    double best = -1;
+    unsigned long long allocations = 0, bytes = 0;
+    long nbConstraints = 0;
+    unsigned long long written = 0;
+    if(write) {   // The writer does not count constraints
+        std::istringstream in(document);
+        XCSP3BenchCallbacks cb;
+        XCSP3CoreParser parser(&cb);
+        parser.parse(in);
+        nbConstraints = cb.nbConstraints;
+    }
+    for(int r = 0 ; r < repeat ; r++) {
+        std::istringstream in(document);
+        XCSP3BenchCallbacks cb;
+        cb.skip = skip;
+        cb.unfoldThreads = unfoldThreads;
+        DiscardBuffer discard;
+        std::ostream out(&discard);
+        XCSP3WriterCallbacks writer(out);
+        XCSP3CoreParser parser(write ? (XCSP3CoreCallbacks *) &writer : &cb);
+        unsigned long long a = nbAllocations, b = allocatedBytes;
+        auto start = std::chrono::steady_clock::now();
+        parser.parse(in);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        allocations = nbAllocations - a;
+        bytes = allocatedBytes - b;
+        if(write == false)
+            nbConstraints = cb.nbConstraints;
+        written = discard.count;
+        if(best < 0 || elapsed < best)
+            best = elapsed;
+    }
+
+    std::printf("  {\"scenario\": \"%s\", \"scale\": %d, \"bytes\": %zu, \"constraints\": %ld, \"wall_ms\": %.3f, "
+                "\"mb_per_s\": %.2f, \"allocations\": %llu, \"allocated_bytes\": %llu, \"peak_rss_kb\": %ld",
+                scenario.c_str(), scale, document.size(), nbConstraints, best * 1000,
+                document.size() / (1024.0 * 1024.0) / best, allocations, bytes, peakRSS());
+    if(write)
+        std::printf(", \"written_bytes\": %llu, \"out_mb_per_s\": %.2f", written, written / (1024.0 * 1024.0) / best);
+    if(unfoldThreads > 1)
+        std::printf(", \"unfold_threads\": %d", unfoldThreads);
+    std::printf("}");
+    std::fflush(stdout);
+}
+
+
+int main(int argc, char **argv) {
+    int scale = 1, repeat = 3;
+    bool write = false, fromStdin = false;
+    int skip = SKIP_NOTHING, unfoldThreads = 1;
+    size_t chunk = 0, maxChunk = 0;
+    ReadAheadMode readAhead = READ_AHEAD_AUTO;
+    std::vector<std::string> scenarios;
+    for(int i = 1 ; i < argc ; i++) {
+        if(std::strcmp(argv[i], "-scale") == 0 && i + 1 < argc)
+            scale = std::atoi(argv[++i]);
+        else if(std::strcmp(argv[i], "-repeat") == 0 && i + 1 < argc)
+            repeat = std::atoi(argv[++i]);
+        else if(std::strcmp(argv[i], "-write") == 0)
+            write = true;
+        else if(std::strcmp(argv[i], "-skip") == 0 && i + 1 < argc)
+            skip = std::atoi(argv[++i]);
+        else if(std::strcmp(argv[i], "-unfold") == 0 && i + 1 < argc)
+            unfoldThreads = std::atoi(argv[++i]);
+        else if(std::strcmp(argv[i], "-stdin") == 0)
+            fromStdin = true;
+        else if(std::strcmp(argv[i], "-chunk") == 0 && i + 1 < argc)
+            chunk = std::atol(argv[++i]);
+        else if(std::strcmp(argv[i], "-maxchunk") == 0 && i + 1 < argc)
+            maxChunk = std::atol(argv[++i]);
+        else if(std::strcmp(argv[i], "-readahead") == 0 && i + 1 < argc) {
+            i++;
+            readAhead = std::strcmp(argv[i], "never") == 0 ? READ_AHEAD_NEVER : (std::strcmp(argv[i], "always") == 0 ? READ_AHEAD_ALWAYS : READ_AHEAD_AUTO);
+        }
+        else
+            scenarios.push_back(argv[i]);
+    }
+    if(fromStdin) {
+        try {
+            runStdin(chunk, maxChunk, readAhead, skip);
+        } catch(std::exception &e) {
+            std::fprintf(stderr, "stdin: %s\n", e.what());
+            return 1;
+        }
+        return 0;
+    }
+    if(scenarios.empty())
+        scenarios = benchScenarios();
+    if(scale < 1 || repeat < 1) {
+        std::fprintf(stderr, "scale and repeat must be positive\n");
+        return 1;
+    }
+
+    int status = 0;
+    std::printf("[\n");
+    for(size_t i = 0 ; i < scenarios.size() ; i++) {
+        if(i > 0)
+            std::printf(",\n");
+        std::fflush(stdout);
+#ifdef BENCH_POSIX
+        pid_t pid = fork();
+        if(pid == 0) {
+            try {
+                runScenario(scenarios[i], scale, repeat, write, skip, unfoldThreads);
+            } catch(std::exception &e) {
+                std::fprintf(stderr, "%s: %s\n", scenarios[i].c_str(), e.what());
+                _exit(1);
+            }
+            _exit(0);
+        }
+        int childStatus = 1;
+        if(pid < 0 || waitpid(pid, &childStatus, 0) < 0 || !WIFEXITED(childStatus) || WEXITSTATUS(childStatus) != 0) {
+            std::printf("  {\"scenario\": \"%s\", \"error\": true}", scenarios[i].c_str());
+            status = 1;
+        }
+#else
+        try {
+            runScenario(scenarios[i], scale, repeat, write, skip, unfoldThreads);
+        } catch(std::exception &e) {
+            std::fprintf(stderr, "%s: %s\n", scenarios[i].c_str(), e.what());
+            std::printf("  {\"scenario\": \"%s\", \"error\": true}", scenarios[i].c_str());
+            status = 1;
+        }
+#endif
+    }
+    std::printf("\n]\n");
+    return status;
+}
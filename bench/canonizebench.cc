@@ -0,0 +1,459 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#include "XCSP3Tree.h"
+#include "XCSP3TreeNode.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#define BENCH_POSIX
+#endif
+
+/**
+ * Parse and canonize intension expressions and print a JSON object with the throughput of
+ * Tree(string) and Tree::canonize (expressions per second) and the peak RSS.
+ * The expressions are those of samples/testCanonization.cc (or the lines of a file), repeated
+ * until the requested number of expressions is reached.
+ *
+ * usage: xcsp3canonizebench [-n expressions] [-file expressions.txt]       (1000000 expressions by default)
+ */
+
+using namespace XCSP3Core;
+
+static const char *corpus[] = {
+        "not(eq(y[3],y[2]))",
+        "and(not(not(eq(y[0],3))),0)",
+        "abs(sub(y[0],y[1]))",
+        "eq(mul(3,y[3]),6)",
+        "and(lt(10,y[3]),lt(y[3],20))",
+        "or(lt(y[3],10),gt(y[3],20))",
+        "le(sub(x[0],4),y[3])",
+        "lt(5,x[0])",
+        "lt(x[0],5)",
+        "lt(add(y[4],5),8)",
+        "lt(8,add(5,y[4]))",
+        "lt(sub(y[4],5),8)",
+        "lt(8,sub(5,y[4]))",
+        "lt(8,sub(y[4],5))",
+        "lt(mod(4,y[0]),10)",
+        "lt(12,div(y[4],2))",
+        "lt(10,div(4,y[0]))",
+        "lt(dist(5,y[3]),4)",
+        "lt(mul(y[0],3),9)",
+        "lt(9,mul(3,y[0]))",
+        "lt(9,mul(y[0],3))",
+        "lt(add(3,4,7),x[0])",
+        "lt(x[0],add(4,3,7))",
+        "lt(mul(3,4,7),x[0])",
+        "le(5,x[0])",
+        "le(x[0],5)",
+        "le(add(y[4],5),8)",
+        "le(8,add(5,y[4]))",
+        "le(sub(y[4],5),8)",
+        "le(8,sub(5,y[4]))",
+        "le(8,sub(y[4],5))",
+        "le(mod(4,y[0]),10)",
+        "le(12,div(y[4],2))",
+        "le(10,div(4,y[0]))",
+        "le(dist(5,y[3]),4)",
+        "le(mul(y[0],3),9)",
+        "le(9,mul(3,y[0]))",
+        "le(9,mul(y[0],3))",
+        "le(add(3,4,7),x[0])",
+        "le(x[0],add(4,3,7))",
+        "le(mul(3,4,7),x[0])",
+        "ge(5,x[0])",
+        "ge(x[0],5)",
+        "ge(add(y[4],5),8)",
+        "ge(8,add(5,y[4]))",
+        "ge(sub(y[4],5),8)",
+        "ge(8,sub(5,y[4]))",
+        "ge(8,sub(y[4],5))",
+        "ge(mod(4,y[0]),10)",
+        "ge(12,div(y[4],2))",
+        "ge(10,div(4,y[0]))",
+        "ge(dist(5,y[3]),4)",
+        "ge(mul(y[0],3),9)",
+        "ge(9,mul(3,y[0]))",
+        "ge(9,mul(y[0],3))",
+        "ge(add(3,4,7),x[0])",
+        "ge(x[0],add(4,3,7))",
+        "ge(mul(3,4,7),x[0])",
+        "gt(5,x[0])",
+        "gt(x[0],5)",
+        "gt(add(y[4],5),8)",
+        "gt(8,add(5,y[4]))",
+        "gt(sub(y[4],5),8)",
+        "gt(8,sub(5,y[4]))",
+        "gt(8,sub(y[4],5))",
+        "gt(mod(4,y[0]),10)",
+        "gt(12,div(y[4],2))",
+        "gt(10,div(4,y[0]))",
+        "gt(dist(5,y[3]),4)",
+        "gt(mul(y[0],3),9)",
+        "gt(9,mul(3,y[0]))",
+        "gt(9,mul(y[0],3))",
+        "gt(add(3,4,7),x[0])",
+        "gt(x[0],add(4,3,7))",
+        "gt(mul(3,4,7),x[0])",
+        "eq(5,x[0])",
+        "eq(x[0],5)",
+        "eq(add(y[4],5),8)",
+        "eq(8,add(5,y[4]))",
+        "eq(sub(y[4],5),8)",
+        "eq(8,sub(5,y[4]))",
+        "eq(8,sub(y[4],5))",
+        "eq(mod(4,y[0]),10)",
+        "eq(12,div(y[4],2))",
+        "eq(10,div(4,y[0]))",
+        "eq(dist(5,y[3]),4)",
+        "eq(mul(y[0],3),9)",
+        "eq(9,mul(3,y[0]))",
+        "eq(9,mul(y[0],3))",
+        "eq(add(3,4,7),x[0])",
+        "eq(x[0],add(4,3,7))",
+        "eq(mul(3,4,7),x[0])",
+        "ne(5,x[0])",
+        "ne(x[0],5)",
+        "ne(add(y[4],5),8)",
+        "ne(8,add(5,y[4]))",
+        "ne(sub(y[4],5),8)",
+        "ne(8,sub(5,y[4]))",
+        "ne(8,sub(y[4],5))",
+        "ne(mod(4,y[0]),10)",
+        "ne(12,div(y[4],2))",
+        "ne(10,div(4,y[0]))",
+        "ne(dist(5,y[3]),4)",
+        "ne(mul(y[0],3),9)",
+        "ne(9,mul(3,y[0]))",
+        "ne(9,mul(y[0],3))",
+        "ne(add(3,4,7),x[0])",
+        "ne(x[0],add(4,3,7))",
+        "ne(mul(3,4,7),x[0])",
+        "in(y[3],set(2,3,4))",
+        "in(add(y[3],2),set(2,3,4))",
+        "in(add(2,y[3]),set(4,3,2))",
+        "in(mod(5,y[3]),set(3,2,4))",
+        "lt(y[3],y[4])",
+        "lt(y[3],y[4])",
+        "lt(y[3],y[2])",
+        "lt(x[0],abs(x[1]))",
+        "lt(abs(x[1]),x[0])",
+        "lt(x[0],sub(x[1],4))",
+        "lt(x[0],sub(4,x[1]))",
+        "lt(4,sub(x[0],x[1]))",
+        "lt(sub(x[1],4),x[0])",
+        "lt(sub(4,x[1]),x[0])",
+        "lt(sub(4,y[2]),sub(y[1],3))",
+        "lt(sub(y[1],3),sub(4,y[2]))",
+        "lt(add(y[2],2),add(y[4],5))",
+        "lt(add(2,y[2]),add(5,y[4]))",
+        "lt(dist(y[2],2),y[4])",
+        "lt(y[4],dist(y[2],2))",
+        "lt(pow(y[3],y[4]),10)",
+        "lt(10,pow(y[3],y[4]))",
+        "lt(neg(y[2]),y[1])",
+        "lt(sqr(y[2]),y[1])",
+        "lt(not(y[2]),y[1])",
+        "le(y[3],y[4])",
+        "le(y[3],y[4])",
+        "le(y[3],y[2])",
+        "le(x[0],abs(x[1]))",
+        "le(abs(x[1]),x[0])",
+        "le(x[0],sub(x[1],4))",
+        "le(x[0],sub(4,x[1]))",
+        "le(4,sub(x[0],x[1]))",
+        "le(sub(x[1],4),x[0])",
+        "le(sub(4,x[1]),x[0])",
+        "le(sub(4,y[2]),sub(y[1],3))",
+        "le(sub(y[1],3),sub(4,y[2]))",
+        "le(add(y[2],2),add(y[4],5))",
+        "le(add(2,y[2]),add(5,y[4]))",
+        "le(dist(y[2],2),y[4])",
+        "le(y[4],dist(y[2],2))",
+        "le(pow(y[3],y[4]),10)",
+        "le(10,pow(y[3],y[4]))",
+        "le(neg(y[2]),y[1])",
+        "le(sqr(y[2]),y[1])",
+        "le(not(y[2]),y[1])",
+        "ge(y[3],y[4])",
+        "ge(y[3],y[4])",
+        "ge(y[3],y[2])",
+        "ge(x[0],abs(x[1]))",
+        "ge(abs(x[1]),x[0])",
+        "ge(x[0],sub(x[1],4))",
+        "ge(x[0],sub(4,x[1]))",
+        "ge(4,sub(x[0],x[1]))",
+        "ge(sub(x[1],4),x[0])",
+        "ge(sub(4,x[1]),x[0])",
+        "ge(sub(4,y[2]),sub(y[1],3))",
+        "ge(sub(y[1],3),sub(4,y[2]))",
+        "ge(add(y[2],2),add(y[4],5))",
+        "ge(add(2,y[2]),add(5,y[4]))",
+        "ge(dist(y[2],2),y[4])",
+        "ge(y[4],dist(y[2],2))",
+        "ge(pow(y[3],y[4]),10)",
+        "ge(10,pow(y[3],y[4]))",
+        "ge(neg(y[2]),y[1])",
+        "ge(sqr(y[2]),y[1])",
+        "ge(not(y[2]),y[1])",
+        "gt(y[3],y[4])",
+        "gt(y[3],y[4])",
+        "gt(y[3],y[2])",
+        "gt(x[0],abs(x[1]))",
+        "gt(abs(x[1]),x[0])",
+        "gt(x[0],sub(x[1],4))",
+        "gt(x[0],sub(4,x[1]))",
+        "gt(4,sub(x[0],x[1]))",
+        "gt(sub(x[1],4),x[0])",
+        "gt(sub(4,x[1]),x[0])",
+        "gt(sub(4,y[2]),sub(y[1],3))",
+        "gt(sub(y[1],3),sub(4,y[2]))",
+        "gt(add(y[2],2),add(y[4],5))",
+        "gt(add(2,y[2]),add(5,y[4]))",
+        "gt(dist(y[2],2),y[4])",
+        "gt(y[4],dist(y[2],2))",
+        "gt(pow(y[3],y[4]),10)",
+        "gt(10,pow(y[3],y[4]))",
+        "gt(neg(y[2]),y[1])",
+        "gt(sqr(y[2]),y[1])",
+        "gt(not(y[2]),y[1])",
+        "eq(y[3],y[4])",
+        "eq(y[3],y[4])",
+        "eq(y[3],y[2])",
+        "eq(x[0],abs(x[1]))",
+        "eq(abs(x[1]),x[0])",
+        "eq(x[0],sub(x[1],4))",
+        "eq(x[0],sub(4,x[1]))",
+        "eq(4,sub(x[0],x[1]))",
+        "eq(sub(x[1],4),x[0])",
+        "eq(sub(4,x[1]),x[0])",
+        "eq(sub(4,y[2]),sub(y[1],3))",
+        "eq(sub(y[1],3),sub(4,y[2]))",
+        "eq(add(y[2],2),add(y[4],5))",
+        "eq(add(2,y[2]),add(5,y[4]))",
+        "eq(dist(y[2],2),y[4])",
+        "eq(y[4],dist(y[2],2))",
+        "eq(pow(y[3],y[4]),10)",
+        "eq(10,pow(y[3],y[4]))",
+        "eq(neg(y[2]),y[1])",
+        "eq(sqr(y[2]),y[1])",
+        "eq(not(y[2]),y[1])",
+        "ne(y[3],y[4])",
+        "ne(y[3],y[4])",
+        "ne(y[3],y[2])",
+        "ne(x[0],abs(x[1]))",
+        "ne(abs(x[1]),x[0])",
+        "ne(x[0],sub(x[1],4))",
+        "ne(x[0],sub(4,x[1]))",
+        "ne(4,sub(x[0],x[1]))",
+        "ne(sub(x[1],4),x[0])",
+        "ne(sub(4,x[1]),x[0])",
+        "ne(sub(4,y[2]),sub(y[1],3))",
+        "ne(sub(y[1],3),sub(4,y[2]))",
+        "ne(add(y[2],2),add(y[4],5))",
+        "ne(add(2,y[2]),add(5,y[4]))",
+        "ne(dist(y[2],2),y[4])",
+        "ne(y[4],dist(y[2],2))",
+        "ne(pow(y[3],y[4]),10)",
+        "ne(10,pow(y[3],y[4]))",
+        "ne(neg(y[2]),y[1])",
+        "ne(sqr(y[2]),y[1])",
+        "ne(not(y[2]),y[1])",
+        "lt(y[8],abs(sub(y[7],y[6])))",
+        "lt(sub(x[1],4),sub(x[2],x[3]))",
+        "lt(add(y[0],y[1]),y[2])",
+        "lt(y[3],sub(y[4],y[5]))",
+        "lt(y[3],add(y[4],y[5]))",
+        "lt(add(y[3],10),add(10,y[4],y[5],6))",
+        "lt(y[3],mul(y[4],y[5],3,5))",
+        "lt(y[1],pow(y[3],y[2]))",
+        "le(y[8],abs(sub(y[7],y[6])))",
+        "le(sub(x[1],4),sub(x[2],x[3]))",
+        "le(add(y[0],y[1]),y[2])",
+        "le(y[3],sub(y[4],y[5]))",
+        "le(y[3],add(y[4],y[5]))",
+        "le(add(y[3],10),add(10,y[4],y[5],6))",
+        "le(y[3],mul(y[4],y[5],3,5))",
+        "le(y[1],pow(y[3],y[2]))",
+        "ge(y[8],abs(sub(y[7],y[6])))",
+        "ge(sub(x[1],4),sub(x[2],x[3]))",
+        "ge(add(y[0],y[1]),y[2])",
+        "ge(y[3],sub(y[4],y[5]))",
+        "ge(y[3],add(y[4],y[5]))",
+        "ge(add(y[3],10),add(10,y[4],y[5],6))",
+        "ge(y[3],mul(y[4],y[5],3,5))",
+        "ge(y[1],pow(y[3],y[2]))",
+        "gt(y[8],abs(sub(y[7],y[6])))",
+        "gt(sub(x[1],4),sub(x[2],x[3]))",
+        "gt(add(y[0],y[1]),y[2])",
+        "gt(y[3],sub(y[4],y[5]))",
+        "gt(y[3],add(y[4],y[5]))",
+        "gt(add(y[3],10),add(10,y[4],y[5],6))",
+        "gt(y[3],mul(y[4],y[5],3,5))",
+        "gt(y[1],pow(y[3],y[2]))",
+        "eq(y[8],abs(sub(y[7],y[6])))",
+        "eq(sub(x[1],4),sub(x[2],x[3]))",
+        "eq(add(y[0],y[1]),y[2])",
+        "eq(y[3],sub(y[4],y[5]))",
+        "eq(y[3],add(y[4],y[5]))",
+        "eq(add(y[3],10),add(10,y[4],y[5],6))",
+        "eq(y[3],mul(y[4],y[5],3,5))",
+        "eq(y[1],pow(y[3],y[2]))",
+        "ne(y[8],abs(sub(y[7],y[6])))",
+        "ne(sub(x[1],4),sub(x[2],x[3]))",
+        "ne(add(y[0],y[1]),y[2])",
+        "ne(y[3],sub(y[4],y[5]))",
+        "ne(y[3],add(y[4],y[5]))",
+        "ne(add(y[3],10),add(10,y[4],y[5],6))",
+        "ne(y[3],mul(y[4],y[5],3,5))",
+        "ne(y[1],pow(y[3],y[2]))",
+        "and(x[0],x[1])",
+        "and(x[0],not(eq(x[1],x[2])))",
+        "and(gt(y[2],10),le(y[2],20))",
+        "and(lt(y[2],100),ge(y[2],1))",
+        "and(gt(y[2],10),lt(y[2],20))",
+        "and(le(y[2],100),ge(y[2],1))",
+        "and(x[0],not(in(x[1],set(4,3,8))))",
+        "or(x[3],x[4],x[1])",
+        "iff(x[2],x[1])",
+        "not(not(eq(x[3],x[4])))",
+        "eq(x[0],iff(x[1],x[2],x[3]))",
+        "ne(x[3],imp(x[1],x[2]))",
+        "eq(5,add(y[0],y[1],y[9]),sub(y[2],y[6]),y[8],mul(y[5],y[6]))",
+        "eq(x[0],min(x[1],min(x[2],x[3])))",
+        "eq(add(add(x[1],x[2],min(x[2],x[3]),add(x[3],x[4])),add(add(y[1],y[2]),y[3])),y[2])",
+};
+
+
+static double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+static long peakRSS() {  // in KB
+#ifdef BENCH_POSIX
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
+
+
+// Nodes are shared between an expression and its canonized form: collect them before deleting
+static void collect(Node *node, std::set<Node *> &nodes) {
+    if(nodes.insert(node).second)
+        for(Node *n : node->parameters)
+            collect(n, nodes);
+}
+
+
+int main(int argc, char **argv) {
+    long nbExpressions = 1000000;
+    std::vector<std::string> expressions;
+    for(int i = 1 ; i < argc ; i++) {
+        if(std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            nbExpressions = std::atol(argv[++i]);
+        else if(std::strcmp(argv[i], "-file") == 0 && i + 1 < argc) {
+            std::ifstream file(argv[++i]);
+            if(!file) {
+                std::fprintf(stderr, "unable to open %s\n", argv[i]);
+                return 1;
+            }
+            std::string line;
+            while(std::getline(file, line))
+                if(line.empty() == false)
+                    expressions.push_back(line);
+        } else {
+            std::fprintf(stderr, "usage: xcsp3canonizebench [-n expressions] [-file expressions.txt]\n");
+            return 1;
+        }
+    }
+    if(expressions.empty())
+        expressions.assign(corpus, corpus + sizeof(corpus) / sizeof(corpus[0]));
+    if(nbExpressions < 1 || expressions.empty()) {
+        std::fprintf(stderr, "no expression to canonize\n");
+        return 1;
+    }
+
+    // One batch is the whole corpus: parse it, canonize it, then delete the trees (not timed)
+    double parse = 0, canonize = 0;
+    long nbNodes = 0, done = 0;
+    std::vector<Tree *> trees;
+    std::vector<Node *> roots;
+    std::set<Node *> nodes;
+    try {
+        while(done < nbExpressions) {
+            size_t batch = std::min((long) expressions.size(), nbExpressions - done);
+            auto start = std::chrono::steady_clock::now();
+            for(size_t i = 0 ; i < batch ; i++)
+                trees.push_back(new Tree(expressions[i]));
+            parse += seconds(start);
+
+            for(Tree *t : trees)
+                roots.push_back(t->root);
+            start = std::chrono::steady_clock::now();
+            for(Tree *t : trees)
+                t->canonize();
+            canonize += seconds(start);
+
+            for(size_t i = 0 ; i < batch ; i++) {
+                collect(roots[i], nodes);
+                collect(trees[i]->root, nodes);
+                nbNodes += (long) nodes.size();
+                for(Node *n : nodes)
+                    delete n;
+                nodes.clear();
+                delete trees[i];
+            }
+            trees.clear();
+            roots.clear();
+            done += (long) batch;
+        }
+    } catch(std::exception &e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    std::printf("{\"expressions\": %ld, \"corpus\": %zu, \"nodes\": %ld, \"parse_s\": %.3f, \"canonize_s\": %.3f, "
+                "\"parse_per_s\": %.0f, \"canonize_per_s\": %.0f, \"peak_rss_kb\": %ld}\n",
+                done, expressions.size(), nbNodes, parse, canonize, done / parse, done / canonize, peakRSS());
+    return 0;
+}
@@ -0,0 +1,137 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#include "XCSP3CoreParser.h"
+#include "XCSP3SolutionChecker.h"
+#include "XCSP3BenchInstances.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+/**
+ * Check random assignments of the synthetic instances and print, for each scenario, a JSON object
+ * with the throughput (assignments per second) of:
+ *   check          : one call to XCSP3SolutionChecker::check per assignment (one thread)
+ *   batch          : XCSP3SolutionChecker::checkBatch on all assignments (one thread)
+ *   batch_parallel : XCSP3SolutionChecker::checkBatch with all hardware threads
+ *
+ * usage: xcsp3checkbench [-scale n] [-rows n] [scenario...]       (all scenarios by default)
+ */
+
+using namespace XCSP3Core;
+
+static double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+static void runScenario(const std::string &scenario, int scale, int nbRows) {
+    std::ostringstream generated;
+    generateBenchInstance(scenario, scale, generated);
+    std::istringstream in(generated.str());
+    XCSP3SolutionChecker checker;
+    XCSP3CoreParser parser(&checker);
+    parser.parse(in);
+
+    // Random values in the bounds of the domains (deterministic)
+    int n = checker.nbVariables();
+    vector<int> assignments((size_t) nbRows * n);
+    unsigned long long state = 42;
+    for(int r = 0 ; r < nbRows ; r++)
+        for(int x = 0 ; x < n ; x++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            int width = checker.maxValue(x) - checker.minValue(x) + 1;
+            assignments[(size_t) r * n + x] = checker.minValue(x) + (int) ((state >> 33) % width);
+        }
+
+    checker.nbThreads = 1;
+    vector<int> assignment(n), violated;
+    int nbFeasible = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0 ; r < nbRows ; r++) {
+        assignment.assign(assignments.begin() + (size_t) r * n, assignments.begin() + (size_t) (r + 1) * n);
+        nbFeasible += checker.check(assignment, violated);
+    }
+    double check = seconds(start);
+
+    vector<char> feasible;
+    vector<long long> objectives;
+    start = std::chrono::steady_clock::now();
+    int nbBatch = checker.checkBatch(assignments, feasible, objectives);
+    double batch = seconds(start);
+
+    checker.nbThreads = std::max(1, (int) std::thread::hardware_concurrency());
+    start = std::chrono::steady_clock::now();
+    checker.checkBatch(assignments, feasible, objectives);
+    double parallel = seconds(start);
+
+    if(nbBatch != nbFeasible)
+        throw std::runtime_error("check and checkBatch disagree");
+
+    std::printf("  {\"scenario\": \"%s\", \"scale\": %d, \"variables\": %d, \"constraints\": %d, \"rows\": %d, \"feasible\": %d, "
+                "\"check_per_s\": %.0f, \"batch_per_s\": %.0f, \"batch_parallel_per_s\": %.0f, \"threads\": %d}",
+                scenario.c_str(), scale, n, checker.nbConstraints(), nbRows, nbFeasible,
+                nbRows / check, nbRows / batch, nbRows / parallel, checker.nbThreads);
+    std::fflush(stdout);
+}
+
+
+int main(int argc, char **argv) {
+    int scale = 1, nbRows = 10000;
+    std::vector<std::string> scenarios;
+    for(int i = 1 ; i < argc ; i++) {
+        if(std::strcmp(argv[i], "-scale") == 0 && i + 1 < argc)
+            scale = std::atoi(argv[++i]);
+        else if(std::strcmp(argv[i], "-rows") == 0 && i + 1 < argc)
+            nbRows = std::atoi(argv[++i]);
+        else
+            scenarios.push_back(argv[i]);
+    }
+    if(scenarios.empty())
+        scenarios = benchScenarios();
+    if(scale < 1 || nbRows < 1) {
+        std::fprintf(stderr, "scale and rows must be positive\n");
+        return 1;
+    }
+
+    int status = 0;
+    std::printf("[\n");
+    for(size_t i = 0 ; i < scenarios.size() ; i++) {
+        if(i > 0)
+            std::printf(",\n");
+        try {
+            runScenario(scenarios[i], scale, nbRows);
+        } catch(std::exception &e) {
+            std::fprintf(stderr, "%s: %s\n", scenarios[i].c_str(), e.what());
+            std::printf("  {\"scenario\": \"%s\", \"error\": true}", scenarios[i].c_str());
+            status = 1;
+        }
+    }
+    std::printf("\n]\n");
+    return status;
+}
@@ -0,0 +1,118 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#include "XCSP3utils.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Cost of the classification of the tokens of a list: for each kind of token, print a JSON object with the
+ * nanoseconds per token of classifyToken and of the former classification (std::stoi, invalid_argument caught
+ * for each token that is not an integer).
+ *
+ * usage: xcsp3tokenbench [-n tokens]       (1000000 tokens per kind by default)
+ */
+
+using namespace XCSP3Core;
+
+static double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+// The classification done by XMLParser::parseSequence before classifyToken (trees, sets, parameters, arrays
+// and ranges were detected the same way, by searching a character)
+static int stoiClassify(const std::string &token) {
+    if(token.find('(') != std::string::npos || token[0] == '{' || token.find('%') != std::string::npos ||
+       token.find('[') != std::string::npos)
+        return 0;
+    if(token.find('.') != std::string::npos)
+        return std::stoi(token.substr(0, token.find('.'))) + std::stoi(token.substr(token.find('.') + 2));
+    try {
+        std::vector<std::string> compact;
+        split(token, 'x', compact);
+        if(compact.size() == 2)
+            return (compact[0] == "*" ? 0 : std::stoi(compact[0])) + std::stoi(compact[1]);
+        return std::stoi(token);
+    } catch(std::invalid_argument &) {
+        return token == "*" ? 1 : 2;
+    }
+}
+
+
+int main(int argc, char **argv) {
+    long nbTokens = 1000000;
+    for(int i = 1 ; i < argc ; i++) {
+        if(std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            nbTokens = std::atol(argv[++i]);
+        else {
+            std::fprintf(stderr, "usage: xcsp3tokenbench [-n tokens]\n");
+            return 1;
+        }
+    }
+    if(nbTokens < 1) {
+        std::fprintf(stderr, "the number of tokens must be positive\n");
+        return 1;
+    }
+
+    const std::vector<std::pair<std::string, std::vector<std::string> > > kinds = {
+            {"variable", {"x", "y3", "queen", "b12", "col7", "z"}},
+            {"integer",  {"0", "12", "-7", "1024", "65536", "3"}},
+            {"compact",  {"0x5", "*x3", "1x10", "-2x4", "7x2", "0x100"}},
+            {"range",    {"0..9", "-5..5", "10..100", "1..2", "0..1000", "3..4"}},
+            {"array",    {"x[0]", "y[2][]", "q[]", "m[1..3][4]", "x[9]", "z[][0]"}},
+            {"star",     {"*", "*", "*", "*", "*", "*"}}
+    };
+
+    long checksum = 0;
+    std::printf("[\n");
+    for(size_t k = 0 ; k < kinds.size() ; k++) {
+        const std::vector<std::string> &tokens = kinds[k].second;
+        int first, second;
+        auto start = std::chrono::steady_clock::now();
+        for(long i = 0 ; i < nbTokens ; i++) {
+            const std::string &token = tokens[i % tokens.size()];
+            checksum += classifyToken(token, first, second);
+        }
+        double classify = seconds(start);
+
+        start = std::chrono::steady_clock::now();
+        for(long i = 0 ; i < nbTokens ; i++)
+            checksum += stoiClassify(tokens[i % tokens.size()]);
+        double stoi = seconds(start);
+
+        std::printf("  {\"kind\": \"%s\", \"tokens\": %ld, \"classify_ns\": %.1f, \"stoi_catch_ns\": %.1f}%s\n", kinds[k].first.c_str(),
+                    nbTokens, classify * 1e9 / nbTokens, stoi * 1e9 / nbTokens, k + 1 < kinds.size() ? "," : "");
+    }
+    std::printf("]\n");
+    volatile long sink = checksum; // keep the loops
+    (void) sink;
+    return 0;
+}
@@ -78,6 +78,14 @@ namespace XCSP3Core {
         void clear();
 
 
+        /**
+         * white space characters are ASCII, so a byte can be tested
+         */
+        static inline bool isSpace(Byte b) {
+            return b == ' ' || b == '\n' || b == '\r' || b == '\t' || b == '\v' || b == '\f';
+        }
+
+
         /**
          * an iterator on characters
          */
@@ -113,8 +121,7 @@ namespace XCSP3Core {
 
 
             inline bool isWhiteSpace() const {
-                return *p < 128 && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'
-                                    || *p == '\v' || *p == '\f');
+                return isSpace(*p);
             }
 
 
@@ -128,7 +135,7 @@ namespace XCSP3Core {
                     return 1; // only one byte
                 else if(ch < 0xC2)
                     throw runtime_error("invalid UTF8 character");
-                else if(ch < 0xD0)
+                else if(ch < 0xE0)
                     return 2; // 2 bytes
                 else if(ch < 0xF0)
                     return 3; // 3 bytes
@@ -139,12 +146,13 @@ namespace XCSP3Core {
             }
 
 
-            inline void addNextByte(int &ch) {
+            // q runs on the bytes of the current code point, p does not move
+            inline void addNextByte(const Byte *&q, int &ch) {
                 ch <<= 6;
-                ++p;
-                if(*p < 0x80 || *p >= 0xC0)
+                ++q;
+                if(*q < 0x80 || *q >= 0xC0)
                     throw runtime_error("invalid UTF8 character");
-                ch |= *p & 0x3F;
+                ch |= *q & 0x3F;
             }
 
         };
@@ -163,6 +171,13 @@ namespace XCSP3Core {
          */
         bool isWhiteSpace() const;
 
+
+        /**
+         * returns true iff all the bytes of the string are ASCII (< 128).
+         * Then each byte is a character and the iterator can be replaced by a byte pointer
+         */
+        bool isAscii() const;
+
         int firstChar() const;
 
         int find(UTF8String sub) const;
@@ -197,6 +212,8 @@ namespace XCSP3Core {
         private:
             iterator it, end;
             vector<int> separators;
+            bool ascii;            // the string is pure ASCII: bytes are characters
+            bool asciiSeparator[128];
         public:
             Tokenizer(const UTF8String s);
             void addSeparator(int ch);
@@ -220,6 +237,13 @@ namespace XCSP3Core {
 
 
             inline void skipWhiteSpace() {
+                if(ascii) {
+                    const Byte *p = it.getPointer(), *e = end.getPointer();
+                    while(p != e && isSpace(*p))
+                        ++p;
+                    it = iterator(p);
+                    return;
+                }
                 while(it != end && *it && it.isWhiteSpace())
                     ++it;
             }
@@ -0,0 +1,130 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XCSP3_ARENA_H
+#define XCSP3_ARENA_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace XCSP3Core {
+
+    /**
+     * A bump allocator for the small objects created during parsing (XInteger, XTree, XIntegerValue...).
+     * Objects are placed one after the other in large blocks and are all destroyed at once by reset().
+     * Blocks are kept between two resets: once warm, the arena does not call malloc anymore.
+     */
+    class XArena {
+        struct Finalizer {
+            void *object;
+            void (*destroy)(void *);
+        };
+
+        struct Block {
+            char *data;
+            size_t size;  // blockSize, or more for an object larger than blockSize
+        };
+
+        std::vector<Block> blocks;
+        std::vector<Finalizer> finalizers;
+        size_t current;   // index of the block in use
+        size_t offset;    // first free byte in this block
+        size_t blockSize;
+
+
+        template<class T>
+        static void destroy(void *object) { static_cast<T *>(object)->~T(); }
+
+
+        void *allocate(size_t size, size_t align) {
+            while(true) {
+                if(current < blocks.size()) {
+                    size_t start = (offset + align - 1) & ~(align - 1);
+                    if(start + size <= blocks[current].size) {
+                        offset = start + size;
+                        return blocks[current].data + start;
+                    }
+                    current++;
+                    offset = 0;
+                    continue;
+                }
+                size_t bs = size > blockSize ? size : blockSize;
+                char *block = static_cast<char *>(std::malloc(bs));
+                if(block == nullptr)
+                    throw std::bad_alloc();
+                blocks.push_back({block, bs});
+            }
+        }
+
+
+    public :
+        explicit XArena(size_t bs = 64 * 1024) : current(0), offset(0), blockSize(bs) { }
+
+
+        XArena(const XArena &) = delete;
+
+
+        XArena &operator=(const XArena &) = delete;
+
+
+        ~XArena() {
+            reset();
+            for(Block &block : blocks)
+                std::free(block.data);
+        }
+
+
+        /**
+         * Build a new object inside the arena.
+         * Its destructor is called by reset() (only if it is not trivial).
+         */
+        template<class T, class... Args>
+        T *make(Args &&... args) {
+            void *place = allocate(sizeof(T), alignof(T));
+            T *object = new(place) T(std::forward<Args>(args)...);
+            if(!std::is_trivially_destructible<T>::value)
+                finalizers.push_back({object, &destroy<T>});
+            return object;
+        }
+
+
+        /**
+         * Destroy all objects, keep the memory for the next ones.
+         */
+        void reset() {
+            for(size_t i = finalizers.size() ; i > 0 ; i--)
+                finalizers[i - 1].destroy(finalizers[i - 1].object);
+            finalizers.clear();
+            current = 0;
+            offset = 0;
+        }
+    };
+}
+
+#endif /* XCSP3_ARENA_H */
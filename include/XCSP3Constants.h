@@ -45,6 +45,11 @@ namespace XCSP3Core {
     } OperandType;
 
 
+    typedef enum entitykind {
+        VARIABLE_E, ARRAY_E, INTEGER_E, INTERVAL_E, TREE_E, SET_E, PARAMETER_E
+    } EntityKind;
+
+
     typedef enum tag {
         UNKNOWNTAG, LISTTAG, FUNCTIONALTAG, VALUESTAG, VALUETAG, CONDITIONTAG, INDEXTAG, LENGTHSTAG
     } Tag;
@@ -61,6 +66,47 @@ namespace XCSP3Core {
         EXPRESSION_O, SUM_O, PRODUCT_O, MINIMUM_O, MAXIMUM_O, NVALUES_O, LEX_O
     } ExpressionObjective;
 
+    // Parts of the instance that are not parsed (see XCSP3CoreCallbacks::skip), they can be combined
+    typedef enum skipMode {
+        SKIP_NOTHING = 0, SKIP_TUPLES = 1, SKIP_INTENSIONS = 2, SKIP_CONSTRAINTS = 4, SKIP_OBJECTIVES = 8
+    } SkipMode;
+
+    // Value returned by XCSP3CoreParser::parse
+    typedef enum parseStatus {
+        PARSE_COMPLETE, PARSE_STOPPED, PARSE_CANCELLED
+    } ParseStatus;
+
+    // Reading of the input in XCSP3CoreParser::parse(istream &): by a second thread that reads the next chunk
+    // while the current one is parsed, AUTO uses it for the streams that cannot seek (pipes, sockets...)
+    typedef enum readAhead {
+        READ_AHEAD_AUTO, READ_AHEAD_NEVER, READ_AHEAD_ALWAYS
+    } ReadAheadMode;
+
+    // Kinds of the tokens of a list (see classifyToken in XCSP3utils.h)
+    typedef enum tokenKind {
+        TOKEN_INTEGER, TOKEN_STAR, TOKEN_RANGE, TOKEN_COMPACT, TOKEN_ARRAY, TOKEN_PARAMETER, TOKEN_TREE, TOKEN_SET, TOKEN_VARIABLE
+    } TokenKind;
+
+    // Callbacks for special cases of constraints: when they are not implemented (see XCSP3CoreParserT), the parser
+    // does not look for these cases and calls the general callback (intension, extension, count, nValues) instead
+    typedef enum specialCallback {
+        CALLBACK_PRIMITIVE_XKY = 1 << 0,    // buildConstraintPrimitive(id, op, x, k, y)
+        CALLBACK_PRIMITIVE_XK = 1 << 1,     // buildConstraintPrimitive(id, op, x, k)
+        CALLBACK_PRIMITIVE_IN = 1 << 2,     // buildConstraintPrimitive(id, x, in, min, max)
+        CALLBACK_MULT = 1 << 3,             // buildConstraintMult
+        CALLBACK_UNARY_EXTENSION = 1 << 4,  // buildConstraintExtension(id, x, values, support, hasStar)
+        CALLBACK_SUM = 1 << 5,              // buildConstraintSum(id, list, coeffs, condition)
+        CALLBACK_AT_MOST = 1 << 6,
+        CALLBACK_AT_LEAST = 1 << 7,
+        CALLBACK_EXACTLY_K = 1 << 8,
+        CALLBACK_EXACTLY_VARIABLE = 1 << 9,
+        CALLBACK_AMONG = 1 << 10,
+        CALLBACK_NOT_ALL_EQUAL = 1 << 11,
+        CALLBACK_ALL_EQUAL = 1 << 12,       // lists of variables and of expressions
+        CALLBACK_ALL_DIFFERENT = 1 << 13,   // lists of variables and of expressions
+        CALLBACK_ALL = (1 << 14) - 1
+    } SpecialCallback;
+
 #define STAR INT_MAX
 }
 #endif	/* XCSP3CONSTANTS_H */
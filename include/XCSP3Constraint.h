@@ -28,9 +28,13 @@
 #include "XCSP3Variable.h"
 #include "XCSP3utils.h"
 #include "XCSP3Constants.h"
+#include "XCSP3Views.h"
+#include <cstddef>
 #include <typeinfo>
 #include <regex>
 #include<map>
+#include <mutex>
+#include <unordered_map>
 
 namespace XCSP3Core {
 
@@ -56,7 +60,103 @@ namespace XCSP3Core {
         virtual ~XConstraint() {}
 
 
-        virtual void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original);
+        virtual void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original);
+    };
+
+
+    /***************************************************************************
+     * The arguments of a group or a slide: a matrix of variables, one row per constraint.
+     * Rows of a group are stored one after the other in a single vector (they may have different sizes).
+     * A slide is implicit: row i is made of the arity variables of its list that start at i * offset
+     * (the list is extended with its first variables when it is circular).
+     * Rows are views on this storage, valid as long as the group.
+     **************************************************************************/
+
+    class XArguments {
+        vector<XVariable *> cells;               // the rows of a group, one after the other, or the list of a slide
+        vector<size_t> starts;                   // group: start of each row in cells, then cells.size()
+        size_t nbRows, width, step;              // slide: number of rows, arity and offset (step is 0 for a group)
+        vector<vector<XVariable *> > copied;     // see toVectors
+        std::once_flag copiedOnce;
+
+    public :
+        XArguments() : starts(1, 0), nbRows(0), width(0), step(0) { }
+
+
+        void addRow(const vector<XVariable *> &row) {
+            cells.insert(cells.end(), row.begin(), row.end());
+            starts.push_back(cells.size());
+            nbRows++;
+        }
+
+
+        void setSlide(const vector<XVariable *> &list, size_t arity, size_t offset, bool circular);
+
+
+        size_t size() const { return nbRows; }
+
+
+        bool isSlide() const { return step != 0; }
+
+
+        // For a slide: the arity of its constraints and the offset between two rows
+        size_t arity() const { return width; }
+
+
+        size_t offset() const { return step; }
+
+
+        // For a slide: its list (followed by its first variables if it is circular)
+        XSpan<XVariable *> list() { return XSpan<XVariable *>(cells); }
+
+
+        XSpan<XVariable *> operator[](size_t row) {
+            if(step != 0)
+                return XSpan<XVariable *>(cells.data() + row * step, width);
+            return XSpan<XVariable *>(cells.data() + starts[row], starts[row + 1] - starts[row]);
+        }
+
+
+        // The rows as vectors, built once on demand (see XCSP3CoreCallbacks::arguments)
+        vector<vector<XVariable *> > &toVectors();
+    };
+
+
+    /**
+     * The former type of XCSP3CoreCallbacks::_arguments (vector<vector<XVariable *> > *), kept for the callbacks
+     * that use this protected member: it can still be compared to nullptr, dereferenced or converted to this pointer.
+     * The rows are copied into vectors at the first dereference only (see XArguments::toVectors),
+     * get() gives them without copy.
+     */
+    class XArgumentsPointer {
+        XArguments *arguments;
+
+    public :
+        XArgumentsPointer(XArguments *a = nullptr) : arguments(a) { }
+
+
+        XArgumentsPointer &operator=(XArguments *a) {
+            arguments = a;
+            return *this;
+        }
+
+
+        XArguments *get() const { return arguments; }
+
+
+        operator vector<vector<XVariable *> > *() const { return arguments == nullptr ? nullptr : &arguments->toVectors(); }
+
+
+        vector<vector<XVariable *> > *operator->() const { return &arguments->toVectors(); }
+
+
+        vector<vector<XVariable *> > &operator*() const { return arguments->toVectors(); }
+
+
+        bool operator==(std::nullptr_t) const { return arguments == nullptr; }
+
+
+        bool operator!=(std::nullptr_t) const { return arguments != nullptr; }
     };
 
 
@@ -68,7 +168,7 @@ namespace XCSP3Core {
     class XConstraintGroup : public XConstraint {
     public :
         XConstraint *constraint;                 // A Constraint group contains a constraint
-        vector<vector<XVariable *> > arguments; // The list of all arguments
+        XArguments arguments;                    // The list of all arguments
         ConstraintType type;                     // Use it to discover the type of constraint... and perform cast
         map<string, XVariable *> toArguments;
 
@@ -79,8 +179,8 @@ namespace XCSP3Core {
         virtual ~XConstraintGroup() { delete constraint; }
 
 
-        void unfoldVector(vector<XVariable *> &toUnfold, vector<XVariable *> &args, vector<XVariable *> &initial);
-        void unfoldString(string &toUnfold, vector<XVariable *> &args);
+        void unfoldVector(vector<XVariable *> &toUnfold, XSpan<XVariable *> args, vector<XVariable *> &initial);
+        void unfoldString(string &toUnfold, XSpan<XVariable *> args);
         void unfoldArgumentNumber(int, XConstraint *builtConstraint);
     };
 
@@ -107,7 +207,7 @@ namespace XCSP3Core {
     public :
         string condition;
 
-        virtual void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original);
+        virtual void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original);
         void extractCondition(XCondition &xc);  // Create the op and the operand (which can be a value, an interval or a XVariable)
         static void extract(XCondition &xc, string &c);
     };
@@ -116,7 +216,7 @@ namespace XCSP3Core {
     public :
         vector<XVariable *> values; // Only XVariable or XInteger
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original);
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original);
 
     };
 
@@ -128,7 +228,7 @@ namespace XCSP3Core {
         XValue() : value(0) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original);
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original);
     };
 
     class XIndex {
@@ -139,14 +239,14 @@ namespace XCSP3Core {
         XIndex() : index(0) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original);
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original);
     };
 
     class XLengths {
     public :
         vector<XVariable *> lengths;
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original);
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original);
     };
 
 
@@ -159,12 +259,13 @@ namespace XCSP3Core {
         vector<vector<int> > tuples;
         bool isSupport;
         bool containsStar;
+        size_t skippedBytes;     // length of the tuples that were not parsed (see SKIP_TUPLES)
 
 
-        XConstraintExtension(std::string idd, std::string c) : XConstraint(idd, c), containsStar(false) {}
+        XConstraintExtension(std::string idd, std::string c) : XConstraint(idd, c), containsStar(false), skippedBytes(0) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
     /***************************************************************************
@@ -174,12 +275,13 @@ namespace XCSP3Core {
 
     public :
         string function;
+        Tree *tree;  // canonized function, already built when the group is unfolded in parallel (nullptr otherwise)
 
 
-        XConstraintIntension(std::string idd, std::string c) : XConstraint(idd, c) {}
+        XConstraintIntension(std::string idd, std::string c) : XConstraint(idd, c), tree(nullptr) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
 
@@ -206,18 +308,48 @@ namespace XCSP3Core {
         string to;
     };
 
-    extern vector<XTransition> tr; // Not beautiful but remove code to fixed data in group constraint.
-    extern string st;
-    extern vector<string> fi;
+    /**
+     * The automaton of a regular or mdd constraint.
+     * States are interned to dense integers (their index in states)
+     * and transitions are stored flat: from0 val0 to0 from1 val1 to1...
+     */
+    class XAutomaton {
+    public :
+        vector<string> states;
+        vector<int> transitions;
+
+
+        int state(const string &name);                // returns the id of the state (added if unknown)
+        void toTransitions(vector<XTransition> &list) const;
+        void clear();
+
+
+        void addTransition(int from, int val, int to) {
+            transitions.push_back(from);
+            transitions.push_back(val);
+            transitions.push_back(to);
+        }
+
+
+        int nbStates() const { return states.size(); }
+
+
+        int nbTransitions() const { return transitions.size() / 3; }
+
+
+    protected :
+        unordered_map<string, int> ids;
+    };
 
     class XConstraintRegular : public XConstraint {
     public :
-        string &start;
-        vector<string> &final;
-        vector<XTransition> &transitions;
+        string start;
+        vector<string> final;
+        XAutomaton *automaton; // owned by the parser, shared by all constraints of a group
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
-        XConstraintRegular(std::string idd, std::string c) : XConstraint(idd, c), start(st), final(fi), transitions(tr) {}
+        bool hasParameters() const; // start or final states depend on the arguments of the group?
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
+        XConstraintRegular(std::string idd, std::string c) : XConstraint(idd, c), automaton(nullptr) {}
     };
 
     /***************************************************************************
@@ -226,10 +358,10 @@ namespace XCSP3Core {
 
     class XConstraintMDD : public XConstraint {
     public :
-        vector<XTransition> &transitions;
-
+        XAutomaton *automaton; // owned by the parser, shared by all constraints of a group
 
-        XConstraintMDD(std::string idd, std::string c) : XConstraint(idd, c), transitions(tr) {}
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
+        XConstraintMDD(std::string idd, std::string c) : XConstraint(idd, c), automaton(nullptr) {}
     };
 
     /***************************************************************************
@@ -245,7 +377,7 @@ namespace XCSP3Core {
 
 
         XConstraintAllDiff(std::string idd, std::string c) : XConstraint(idd, c) {}
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
 
     };
 
@@ -265,7 +397,7 @@ namespace XCSP3Core {
         }
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
     typedef XConstraintAllDiffMatrix XConstraintAllDiffList;
@@ -283,7 +415,7 @@ namespace XCSP3Core {
         OrderType &op;
 
         XConstraintOrdered(std::string idd, std::string c) : XConstraint(idd, c), op(_op) {}
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
 
@@ -296,7 +428,7 @@ namespace XCSP3Core {
         XConstraintLex(std::string idd, std::string c) : XConstraintOrdered(idd, c) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
     class XConstraintLexMatrix : public XConstraintOrdered {
@@ -307,7 +439,7 @@ namespace XCSP3Core {
         XConstraintLexMatrix(std::string idd, std::string c) : XConstraintOrdered(idd, c) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
     /***************************************************************************
@@ -331,7 +463,7 @@ namespace XCSP3Core {
         XConstraintSum(std::string idd, std::string c) : XConstraint(idd, c) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
 
@@ -343,7 +475,7 @@ namespace XCSP3Core {
         XConstraintNValues(std::string idd, std::string c) : XConstraint(idd, c), except(___except) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
 
@@ -356,7 +488,7 @@ namespace XCSP3Core {
         XConstraintCardinality(std::string idd, std::string c) : XConstraint(idd, c) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
     /***************************************************************************
@@ -368,7 +500,7 @@ namespace XCSP3Core {
         XConstraintCount(std::string idd, std::string c) : XConstraint(idd, c) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
 
@@ -393,7 +525,7 @@ namespace XCSP3Core {
         XConstraintMaximum(std::string idd, std::string c) : XConstraint(idd, c), startIndex(0), rank(ANY) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
     typedef XConstraintMaximum XConstraintMinimum;
@@ -411,7 +543,7 @@ namespace XCSP3Core {
         XConstraintElement(std::string idd, std::string c) : XConstraint(idd, c), startIndex(0), rank(ANY) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
     class XConstraintElementMatrix : public XConstraintElement {
@@ -429,7 +561,7 @@ namespace XCSP3Core {
         }
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
     /***************************************************************************
@@ -446,7 +578,7 @@ namespace XCSP3Core {
         XConstraintChannel(std::string idd, std::string c) : XConstraint(idd, c), startIndex1(0), startIndex2(0) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
 
@@ -471,7 +603,7 @@ namespace XCSP3Core {
         XConstraintNoOverlap(std::string idd, std::string c) : XConstraint(idd, c), origins(list) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
     /***************************************************************************
@@ -488,7 +620,7 @@ namespace XCSP3Core {
         XConstraintCumulative(std::string idd, std::string c) : XConstraint(idd, c), origins(list) {}
 
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
     /***************************************************************************
@@ -502,7 +634,7 @@ namespace XCSP3Core {
         int startIndex;
 
         XConstraintBinPacking(std::string idd, std::string c) : XConstraint(idd, c) {}
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
     /***************************************************************************
      * constraint stretch
@@ -517,7 +649,7 @@ namespace XCSP3Core {
         XConstraintStretch(std::string idd, std::string c) : XConstraint(idd, c) {}
 
         // Group is valied with lists only.
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
     /***************************************************************************
@@ -527,7 +659,7 @@ namespace XCSP3Core {
 
     class XConstraintInstantiation : public XConstraint, public XValues {
     public :
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
         XConstraintInstantiation(std::string idd, std::string c) : XConstraint(idd, c) {}
     };
 
@@ -544,7 +676,7 @@ namespace XCSP3Core {
 
 
         XConstraintClause(std::string idd, std::string c) : XConstraint(idd, c) { }
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     };
 
     /***************************************************************************
@@ -558,14 +690,14 @@ namespace XCSP3Core {
         XConstraintCircuit(std::string idd, std::string c) : XConstraint(idd, c) {}
         int startIndex;
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
 
     };
 
 
     class XConstraintPrecedence :  public XConstraint, public XValues {
 
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
 
     public:
         bool covered;
@@ -574,7 +706,7 @@ namespace XCSP3Core {
 
 
     class XConstraintFlow :  public XConstraint, public XInitialCondition {
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     public:
         vector<vector<int> > arcs;
         vector<XVariable *>balance;
@@ -585,7 +717,7 @@ namespace XCSP3Core {
 
 
     class XConstraintKnapsack :  public XConstraint, public XInitialCondition {
-        void unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) override;
+        void unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) override;
     public:
         vector<XVariable *>profits;
         vector<XVariable *> weights;
@@ -29,6 +29,7 @@
 #include "XCSP3Variable.h"
 #include "XCSP3Constraint.h"
 #include "XCSP3Tree.h"
+#include "XCSP3Views.h"
 #include <vector>
 #include <string>
 
@@ -37,12 +38,18 @@ namespace XCSP3Core {
 
     using namespace std;
 
+    template<class Callbacks> class XCSP3CoreParserT;
+
     class XCSP3CoreCallbacks {
         friend class XCSP3Manager;
+        friend class XCSP3CoreParser;
+        template<class Callbacks> friend class XCSP3CoreParserT;
 
     protected :
         vector<string> classesToDiscard;
-        vector<vector<XVariable*> >* _arguments;
+        XArgumentsPointer _arguments;  // the arguments of the current group/slide (see arguments and groupArguments)
+        bool stopRequested;
+        int implemented;     // SpecialCallback overridden by the callbacks (all of them unless set by XCSP3CoreParserT)
     public :
 
         /**
@@ -75,6 +82,40 @@ namespace XCSP3Core {
          */
         bool normalizeSum;
 
+        /**
+         * Parts of the instance that are skipped (a combination of SkipMode, SKIP_NOTHING by default).
+         * Their text is counted but never tokenized, which makes quick triage of large instances possible:
+         *  - SKIP_TUPLES: tuples of extension constraints
+         *  - SKIP_INTENSIONS: intension constraints are neither parsed as trees nor canonized
+         *  - SKIP_CONSTRAINTS: the whole <constraints> section (blocks, groups...)
+         *  - SKIP_OBJECTIVES: the content of the <objectives> section (beginObjectives/endObjectives are still called)
+         * Skipped constraints are reported with #skippedConstraint
+         */
+        int skip;
+
+        /**
+         * Number of threads that unfold the groups of at least 4096 constraints (1 by default: sequential unfolding).
+         * The constraints of such a group are unfolded by batches (and intension ones parsed and canonized) on these
+         * threads, but the callbacks are still called from the parsing thread, in the order of the group.
+         * Groups of extension, regular and mdd constraints are always unfolded sequentially.
+         */
+        int unfoldThreads;
+
+        /**
+         * If true (and unfoldThreads > 1), the callbacks of the constraints of a large group are directly called from
+         * the unfolding threads: concurrently and in any order (false by default).
+         */
+        bool threadSafeCallbacks;
+
+#ifdef XCSP3_VIEWS
+        /**
+         * If true, the zero-copy callbacks (string_view ids, XSpan containers) are called instead of the classical ones
+         * for extension, intension (with intensionUsingString), regular, mdd, sum, count, nValues, element (over a list)
+         * and cardinality constraints over variables, and for objectives given as expressions.
+         * Only available when the parser is built with XCSP3_VIEWS (C++17).
+         */
+        bool useViews;
+#endif
 
         XCSP3CoreCallbacks() {
             intensionUsingString = false;
@@ -82,11 +123,21 @@ namespace XCSP3Core {
             recognizeSpecialCountCases = true;
             recognizeNValuesCases = true;
             normalizeSum = true;
+            skip = SKIP_NOTHING;
+            unfoldThreads = 1;
+            threadSafeCallbacks = false;
+            stopRequested = false;
+            implemented = CALLBACK_ALL;
+#ifdef XCSP3_VIEWS
+            useViews = false;
+#endif
         }
 
 
         /**
          * remove specific classes such as symmetryBreaking, clues...
+         * Classes are declared before the parsing: the elements of the constraints section with one of them
+         * (in their class attribute) are not even parsed.
          * @param cl
          */
         void addClassToDiscard(string cl) {
@@ -94,14 +145,50 @@ namespace XCSP3Core {
         }
 
 
-        bool discardedClasses(string classes) {
-            if(classes == "")
-                return false;
+        /**
+         * The classes to discard that occur in a class attribute (names separated by spaces), as a mask:
+         * bit i for the ith class given to addClassToDiscard (the 63th and the next ones share the last bit).
+         * @return 0 if the element is kept
+         */
+        unsigned long long classMask(const string &classes) const {
+            unsigned long long mask = 0;
+            if(classesToDiscard.empty())
+                return mask;
+            size_t i = 0, n = classes.size();
+            while(i < n) {
+                while(i < n && (classes[i] == ' ' || classes[i] == '\t' || classes[i] == '\n' || classes[i] == '\r'))
+                    i++;
+                size_t start = i;
+                while(i < n && classes[i] != ' ' && classes[i] != '\t' && classes[i] != '\n' && classes[i] != '\r')
+                    i++;
+                for(size_t c = 0 ; i > start && c < classesToDiscard.size() ; c++)
+                    if(classes.compare(start, i - start, classesToDiscard[c]) == 0)
+                        mask |= 1ULL << (c < 63 ? c : 63);
+            }
+            return mask;
+        }
+
+
+        /**
+         * Are all these special callbacks (a combination of SpecialCallback) implemented?
+         */
+        bool implements(int callbacks) const {
+            return (implemented & callbacks) == callbacks;
+        }
+
 
-            for(string c : classesToDiscard)
-                if(classes.find(c) != std::string::npos)
-                    return true;
-            return false;
+        /**
+         * Ask the parser to stop as soon as the current callback returns, for example in endVariables
+         * once enough is known about the instance.
+         * No other callback is called (not even endInstance) and XCSP3CoreParser::parse returns PARSE_STOPPED.
+         */
+        void stopParsing() {
+            stopRequested = true;
+        }
+
+
+        bool discardedClasses(const string &classes) const {
+            return classes.empty() == false && classMask(classes) != 0;
         }
 
 
@@ -192,12 +279,24 @@ namespace XCSP3Core {
          * Retrieve the  arguments of a group/slide  of constraints
          * Arguments are available juste before the first constraint is called
          * that is, after the beginGroup/beginSlide callback
+         * The rows are copied into vectors at the first call: #groupArguments gives them without copy
          * @return
          */
         vector<vector<XVariable*> > *arguments() {
             return _arguments;
         }
 
+
+        /**
+         * The arguments of a group/slide, given just before its first constraint is called.
+         * Rows are views on the flat storage of the group (a slide is not even unfolded: see XArguments::isSlide),
+         * they are valid until endGroup/endSlide.
+         *
+         * @param id the id of the group/slide
+         * @param arguments one row of variables per constraint
+         */
+        virtual void groupArguments(string id, XArguments &arguments) { (void)id; (void)arguments; }
+
         /**
          * The end of parsing group of constraints
          * Related to tag </group>
@@ -276,6 +375,26 @@ namespace XCSP3Core {
          */
         virtual void endAnnotations() {}
 
+
+        /**
+         * A constraint that was not parsed (see #skip).
+         * With SKIP_TUPLES and SKIP_INTENSIONS, this is called instead of the related callback
+         * (for each constraint of a group/slide).
+         * With SKIP_CONSTRAINTS, it is called for each child of <constraints> (or of a block): groups and slides
+         * are reported once, their type is group or slide.
+         *
+         * @param id the id of the constraint (can be empty)
+         * @param type the tag of the constraint: extension, intension, sum, group...
+         * @param arity the size of the scope, -1 if it is unknown (SKIP_CONSTRAINTS)
+         * @param bytes the length of the text that was skipped (0 for the constraints of a group that share it)
+         */
+        virtual void skippedConstraint(string id, string type, int arity, size_t bytes) {
+            (void)id;
+            (void)type;
+            (void)arity;
+            (void)bytes;
+        }
+
         //--------------------------------------------------------------------------------------
         // Build Variable. Must be implemented.
         //--------------------------------------------------------------------------------------
@@ -536,6 +655,49 @@ namespace XCSP3Core {
         }
 
 
+        /**
+         * The callback function related to a regular constraint, with interned states.
+         * This is the one called by the parser. By default, states are converted back
+         * to strings and the previous callback is called.
+         * Override it to build the automaton without hashing state names.
+         *
+         * @param id the id (name) of the constraint
+         * @param list the scope of the constraint
+         * @param start the id of the starting state
+         * @param final the ids of the final states
+         * @param automaton automaton.states[i] is the name of state i,
+         * automaton.transitions contains the transitions as flat triples (from, val, to).
+         * In a group, the automaton is shared by all constraints.
+         */
+        virtual void buildConstraintRegular(string id, vector<XVariable *> &list, int start, vector<int> &final, XAutomaton &automaton) {
+            vector<string> finalStates;
+            for(int f : final)
+                finalStates.push_back(automaton.states[f]);
+            vector<XTransition> transitions;
+            automaton.toTransitions(transitions);
+            buildConstraintRegular(id, list, automaton.states[start], finalStates, transitions);
+        }
+
+
+        /**
+         * The callback function related to a regular constraint where the automaton (transitions, start and final states)
+         * is exactly the same than the previous one: only the scope changes.
+         * It is the case when a group of constraints (or a slide) contains a regular constraint whose start and
+         * final states do not depend on the arguments.
+         * This is useful to build the automaton only once and share it between all constraints.
+         * By default, the previous callback is called.
+         *
+         * @param id the id (name) of the constraint
+         * @param list the scope of the constraint
+         * @param start the id of the starting state
+         * @param final the ids of the final states
+         * @param automaton the same automaton than in the previous call
+         */
+        virtual void buildConstraintRegularAs(string id, vector<XVariable *> &list, int start, vector<int> &final, XAutomaton &automaton) {
+            buildConstraintRegular(id, list, start, final, automaton);
+        }
+
+
         /**
          * The callback function related to a MDD constraint.
          * See http://xcsp.org/specifications/mdd
@@ -560,6 +722,36 @@ namespace XCSP3Core {
         }
 
 
+        /**
+         * The callback function related to a MDD constraint, with interned states.
+         * This is the one called by the parser. By default, states are converted back
+         * to strings and the previous callback is called.
+         *
+         * @param id the id (name) of the constraint
+         * @param list the scope of the constraint
+         * @param automaton the states and the flat (from, val, to) transitions (see regular)
+         */
+        virtual void buildConstraintMDD(string id, vector<XVariable *> &list, XAutomaton &automaton) {
+            vector<XTransition> transitions;
+            automaton.toTransitions(transitions);
+            buildConstraintMDD(id, list, transitions);
+        }
+
+
+        /**
+         * The callback function related to a MDD constraint where the automaton is exactly the same
+         * than the previous one: only the scope changes (MDD in a group of constraints or a slide).
+         * By default, the previous callback is called.
+         *
+         * @param id the id (name) of the constraint
+         * @param list the scope of the constraint
+         * @param automaton the same automaton than in the previous call
+         */
+        virtual void buildConstraintMDDAs(string id, vector<XVariable *> &list, XAutomaton &automaton) {
+            buildConstraintMDD(id, list, automaton);
+        }
+
+
 //--------------------------------------------------------------------------------------
 // Comparison constraints
 //--------------------------------------------------------------------------------------
@@ -592,7 +784,7 @@ namespace XCSP3Core {
          * </allDifferent>
          *
          * @param id the id (name) of the constraint
-         * @param list the trees of the constraint
+         * @param list the trees of the constraint (new trees for each call, the callbacks may keep them)
          */
         virtual void buildConstraintAlldifferent(string id, vector<Tree *> &list) {
             (void)id; (void)list;
@@ -690,7 +882,7 @@ namespace XCSP3Core {
          * </allEqual>
          *
          * @param id the id (name) of the constraint
-         * @param list the trees of the constraint
+         * @param list the trees of the constraint (new trees for each call, the callbacks may keep them)
           */
         virtual void buildConstraintAllEqual(string id, vector<Tree *> &list) {
             (void)id; (void)list;
@@ -909,7 +1101,7 @@ namespace XCSP3Core {
          * </sum>
          *
          * @param id the id (name) of the constraint
-         * @param list the different trees
+         * @param list the different trees (new trees for each call, the callbacks may keep them)
          * @param cond the condition (See XCondition object)
          */
         virtual void buildConstraintSum(string id, vector<Tree *> &trees, XCondition &cond) {
@@ -929,7 +1121,7 @@ namespace XCSP3Core {
          * </sum>
          *
          * @param id the id (name) of the constraint
-         * @param list the different trees
+         * @param list the different trees (new trees for each call, the callbacks may keep them)
          * @param coefs the coefs.
          * @param cond the condition (See XCondition object)
          */
@@ -1124,7 +1316,7 @@ namespace XCSP3Core {
          * </count>
          *
          * @param id the id (name) of the constraint
-         * @param trees the trees
+         * @param trees the trees (new trees for each call, the callbacks may keep them)
          * @param value the set of  integer values
          * @param k the  number of variables
          * @param xc the condition (see #XCondition)
@@ -1146,7 +1338,7 @@ namespace XCSP3Core {
          * </count>
          *
          * @param id the id (name) of the constraint
-         * @param trees the trees
+         * @param trees the trees (new trees for each call, the callbacks may keep them)
          * @param value the set of  Variable values
          * @param k the  number of variables
          * @param xc the condition (see #XCondition)
@@ -1187,7 +1379,7 @@ namespace XCSP3Core {
          * </nValues>
          *
          * @param id the id (name) of the constraint
-         * @param list the scope of the constraint
+         * @param list the scope of the constraint (new trees for each call, the callbacks may keep them)
          * @param except the set of excepted values
          * @param xc the condition (see #XCondition)
          */
@@ -1389,7 +1581,7 @@ namespace XCSP3Core {
          * </minimum>
          *
          * @param id the id (name) of the constraint
-         * @param list set of expression
+         * @param list set of expression (new trees for each call, the callbacks may keep them)
          * @param xc the condition (see #XCondition)
          */
         virtual void buildConstraintMinimum(string id, vector<Tree *> &list, XCondition &xc) {
@@ -1453,7 +1645,7 @@ namespace XCSP3Core {
                 * </maximum>
                 *
                 * @param id the id (name) of the constraint
-                * @param list the expressions of the constraint
+                * @param list the expressions of the constraint (new trees for each call, the callbacks may keep them)
                 * @param xc the condition (see #XCondition)
                 */
         virtual void buildConstraintMaximum(string id, vector<Tree*> &list, XCondition &xc) {
@@ -1485,6 +1677,10 @@ namespace XCSP3Core {
         }
 
 
+        /**
+         * The callback functions related to maximumArg and minimumArg constraints over expressions
+         * @param list the expressions (new trees for each call, the callbacks may keep them)
+         */
         virtual void buildConstraintMaximumArg(string id, vector<Tree*> &list, RankType rank, XCondition &xc) {
             (void)id; (void)list; (void)xc; (void)rank;
             throw runtime_error("maximum Arg constraint over trees is not yet supported");
@@ -2397,6 +2593,246 @@ namespace XCSP3Core {
         }
 
 
+#ifdef XCSP3_VIEWS
+//--------------------------------------------------------------------------------------
+// Zero-copy callbacks (only called if useViews is set to true)
+// ids are given as string_view and containers as XSpan (see XCSP3Views.h).
+// Views are only valid during the call. By default, each one copies its arguments
+// and forwards to the classical callback: override only the ones you need.
+//--------------------------------------------------------------------------------------
+
+        /**
+         * Zero-copy version of #buildConstraintExtension
+         * @param tuples a view over the tuples (tuples[i] is the ith tuple)
+         */
+        virtual void buildConstraintExtension(XStringView id, XSpan<XVariable *> list, XSpan<vector<int> > tuples, bool support, bool hasStar) {
+            vector<vector<int> > tpls = tuples.toVector();
+            buildConstraintExtension(string(id), list.toVector(), tpls, support, hasStar);
+        }
+
+
+        /**
+         * Zero-copy version of the unary #buildConstraintExtension
+         */
+        virtual void buildConstraintExtension(XStringView id, XVariable *variable, XSpan<int> tuples, bool support, bool hasStar) {
+            vector<int> tpls = tuples.toVector();
+            buildConstraintExtension(string(id), variable, tpls, support, hasStar);
+        }
+
+
+        /**
+         * Zero-copy version of #buildConstraintExtensionAs
+         */
+        virtual void buildConstraintExtensionAs(XStringView id, XSpan<XVariable *> list, bool support, bool hasStar) {
+            buildConstraintExtensionAs(string(id), list.toVector(), support, hasStar);
+        }
+
+
+        /**
+         * Zero-copy version of #buildConstraintIntension (with intensionUsingString)
+         */
+        virtual void buildConstraintIntension(XStringView id, XStringView expr) {
+            buildConstraintIntension(string(id), string(expr));
+        }
+
+
+        /**
+         * Zero-copy versions of #buildConstraintCardinality
+         */
+        virtual void buildConstraintCardinality(XStringView id, XSpan<XVariable *> list, XSpan<int> values, XSpan<int> occurs, bool closed) {
+            vector<XVariable *> l = list.toVector();
+            vector<int> o = occurs.toVector();
+            buildConstraintCardinality(string(id), l, values.toVector(), o, closed);
+        }
+
+
+        virtual void buildConstraintCardinality(XStringView id, XSpan<XVariable *> list, XSpan<int> values, XSpan<XVariable *> occurs, bool closed) {
+            vector<XVariable *> l = list.toVector();
+            vector<XVariable *> o = occurs.toVector();
+            buildConstraintCardinality(string(id), l, values.toVector(), o, closed);
+        }
+
+
+        virtual void buildConstraintCardinality(XStringView id, XSpan<XVariable *> list, XSpan<int> values, XSpan<XInterval> occurs, bool closed) {
+            vector<XVariable *> l = list.toVector();
+            vector<XInterval> o = occurs.toVector();
+            buildConstraintCardinality(string(id), l, values.toVector(), o, closed);
+        }
+
+
+        virtual void buildConstraintCardinality(XStringView id, XSpan<XVariable *> list, XSpan<XVariable *> values, XSpan<int> occurs, bool closed) {
+            vector<XVariable *> l = list.toVector();
+            vector<int> o = occurs.toVector();
+            buildConstraintCardinality(string(id), l, values.toVector(), o, closed);
+        }
+
+
+        virtual void buildConstraintCardinality(XStringView id, XSpan<XVariable *> list, XSpan<XVariable *> values, XSpan<XVariable *> occurs, bool closed) {
+            vector<XVariable *> l = list.toVector();
+            vector<XVariable *> o = occurs.toVector();
+            buildConstraintCardinality(string(id), l, values.toVector(), o, closed);
+        }
+
+
+        virtual void buildConstraintCardinality(XStringView id, XSpan<XVariable *> list, XSpan<XVariable *> values, XSpan<XInterval> occurs, bool closed) {
+            vector<XVariable *> l = list.toVector();
+            vector<XInterval> o = occurs.toVector();
+            buildConstraintCardinality(string(id), l, values.toVector(), o, closed);
+        }
+
+
+        /**
+         * Zero-copy versions of #buildConstraintRegular, #buildConstraintRegularAs (flat automaton),
+         * #buildConstraintMDD and #buildConstraintMDDAs
+         */
+        virtual void buildConstraintRegular(XStringView id, XSpan<XVariable *> list, int start, XSpan<int> final, XAutomaton &automaton) {
+            vector<XVariable *> l = list.toVector();
+            vector<int> f = final.toVector();
+            buildConstraintRegular(string(id), l, start, f, automaton);
+        }
+
+
+        virtual void buildConstraintRegularAs(XStringView id, XSpan<XVariable *> list, int start, XSpan<int> final, XAutomaton &automaton) {
+            vector<XVariable *> l = list.toVector();
+            vector<int> f = final.toVector();
+            buildConstraintRegularAs(string(id), l, start, f, automaton);
+        }
+
+
+        virtual void buildConstraintMDD(XStringView id, XSpan<XVariable *> list, XAutomaton &automaton) {
+            vector<XVariable *> l = list.toVector();
+            buildConstraintMDD(string(id), l, automaton);
+        }
+
+
+        virtual void buildConstraintMDDAs(XStringView id, XSpan<XVariable *> list, XAutomaton &automaton) {
+            vector<XVariable *> l = list.toVector();
+            buildConstraintMDDAs(string(id), l, automaton);
+        }
+
+
+        /**
+         * Zero-copy versions of #buildConstraintSum over variables
+         */
+        virtual void buildConstraintSum(XStringView id, XSpan<XVariable *> list, XCondition &cond) {
+            vector<XVariable *> l = list.toVector();
+            buildConstraintSum(string(id), l, cond);
+        }
+
+
+        virtual void buildConstraintSum(XStringView id, XSpan<XVariable *> list, XSpan<int> coeffs, XCondition &cond) {
+            vector<XVariable *> l = list.toVector();
+            vector<int> c = coeffs.toVector();
+            buildConstraintSum(string(id), l, c, cond);
+        }
+
+
+        virtual void buildConstraintSum(XStringView id, XSpan<XVariable *> list, XSpan<XVariable *> coeffs, XCondition &cond) {
+            vector<XVariable *> l = list.toVector();
+            vector<XVariable *> c = coeffs.toVector();
+            buildConstraintSum(string(id), l, c, cond);
+        }
+
+
+        /**
+         * Zero-copy versions of #buildConstraintCount over variables
+         */
+        virtual void buildConstraintCount(XStringView id, XSpan<XVariable *> list, XSpan<int> values, XCondition &xc) {
+            vector<XVariable *> l = list.toVector();
+            vector<int> v = values.toVector();
+            buildConstraintCount(string(id), l, v, xc);
+        }
+
+
+        virtual void buildConstraintCount(XStringView id, XSpan<XVariable *> list, XSpan<XVariable *> values, XCondition &xc) {
+            vector<XVariable *> l = list.toVector();
+            vector<XVariable *> v = values.toVector();
+            buildConstraintCount(string(id), l, v, xc);
+        }
+
+
+        /**
+         * Zero-copy versions of #buildConstraintNValues over variables
+         */
+        virtual void buildConstraintNValues(XStringView id, XSpan<XVariable *> list, XCondition &xc) {
+            vector<XVariable *> l = list.toVector();
+            buildConstraintNValues(string(id), l, xc);
+        }
+
+
+        virtual void buildConstraintNValues(XStringView id, XSpan<XVariable *> list, XSpan<int> except, XCondition &xc) {
+            vector<XVariable *> l = list.toVector();
+            vector<int> e = except.toVector();
+            buildConstraintNValues(string(id), l, e, xc);
+        }
+
+
+        /**
+         * Zero-copy versions of #buildConstraintElement over a list (the matrix forms are not concerned)
+         */
+        virtual void buildConstraintElement(XStringView id, XSpan<XVariable *> list, int value) {
+            vector<XVariable *> l = list.toVector();
+            buildConstraintElement(string(id), l, value);
+        }
+
+
+        virtual void buildConstraintElement(XStringView id, XSpan<XVariable *> list, XVariable *value) {
+            vector<XVariable *> l = list.toVector();
+            buildConstraintElement(string(id), l, value);
+        }
+
+
+        virtual void buildConstraintElement(XStringView id, XSpan<int> list, XVariable *index, int startIndex, XCondition &xc) {
+            vector<int> l = list.toVector();
+            buildConstraintElement(string(id), l, index, startIndex, xc);
+        }
+
+
+        virtual void buildConstraintElement(XStringView id, XSpan<XVariable *> list, XVariable *index, int startIndex, XCondition &xc) {
+            vector<XVariable *> l = list.toVector();
+            buildConstraintElement(string(id), l, index, startIndex, xc);
+        }
+
+
+        virtual void buildConstraintElement(XStringView id, XSpan<int> list, int startIndex, XVariable *index, RankType rank, int value) {
+            vector<int> l = list.toVector();
+            buildConstraintElement(string(id), l, startIndex, index, rank, value);
+        }
+
+
+        virtual void buildConstraintElement(XStringView id, XSpan<XVariable *> list, int startIndex, XVariable *index, RankType rank, int value) {
+            vector<XVariable *> l = list.toVector();
+            buildConstraintElement(string(id), l, startIndex, index, rank, value);
+        }
+
+
+        virtual void buildConstraintElement(XStringView id, XSpan<int> list, int startIndex, XVariable *index, RankType rank, XVariable *value) {
+            vector<int> l = list.toVector();
+            buildConstraintElement(string(id), l, startIndex, index, rank, value);
+        }
+
+
+        virtual void buildConstraintElement(XStringView id, XSpan<XVariable *> list, int startIndex, XVariable *index, RankType rank, XVariable *value) {
+            vector<XVariable *> l = list.toVector();
+            buildConstraintElement(string(id), l, startIndex, index, rank, value);
+        }
+
+
+        /**
+         * Zero-copy versions of #buildObjectiveMinimizeExpression and #buildObjectiveMaximizeExpression
+         * (the other objectives already get their lists by reference)
+         */
+        virtual void buildObjectiveMinimizeExpression(XStringView expr) {
+            buildObjectiveMinimizeExpression(string(expr));
+        }
+
+
+        virtual void buildObjectiveMaximizeExpression(XStringView expr) {
+            buildObjectiveMaximizeExpression(string(expr));
+        }
+
+#endif
+
 //--------------------------------------------------------------------------------------
 // Objectives
 //--------------------------------------------------------------------------------------
@@ -2608,7 +3044,7 @@ namespace XCSP3Core {
          * <objectives>
          *
          * @param type SUM, PRODUCT...
-         * @param trees the expressions
+         * @param trees the expressions (new trees for each call, the callbacks may keep them)
          * @param coefs the vector of coefficients
          */
         virtual void buildObjectiveMinimize(ExpressionObjective type, vector<Tree *> &trees, vector<int> &coefs) {
@@ -2629,7 +3065,7 @@ namespace XCSP3Core {
          * <objectives>
          *
          * @param type SUM, PRODUCT...
-         * @param trees the expressions
+         * @param trees the expressions (new trees for each call, the callbacks may keep them)
          * @param coefs the vector of coefficients (variables)
          */
         virtual void buildObjectiveMinimize(ExpressionObjective type, vector<Tree *> &trees, vector<XVariable*> &coefs) {
@@ -2650,7 +3086,7 @@ namespace XCSP3Core {
          * <objectives>
          *
          * @param type SUM, PRODUCT...
-         * @param list the scope
+         * @param list the scope (new trees for each call, the callbacks may keep them)
          * @param coefs the vector of coefficients
          */
         virtual void buildObjectiveMaximize(ExpressionObjective type, vector<Tree *> &trees, vector<int> &coefs) {
@@ -2671,10 +3107,10 @@ namespace XCSP3Core {
          * <objectives>
          *
          * @param type SUM, PRODUCT...
-         * @param list the scope
+         * @param list the scope (new trees for each call, the callbacks may keep them)
          * @param coefs the vector of coefficients (variables)
          */
-         void buildObjectiveMaximize(ExpressionObjective type, vector<Tree *> &trees, vector<XVariable *> &coefs) {
+        virtual void buildObjectiveMaximize(ExpressionObjective type, vector<Tree *> &trees, vector<XVariable *> &coefs) {
             (void)type; (void)trees; (void)coefs;
             throw runtime_error("maximize objective with expression  not yet supported");
         }
@@ -2691,7 +3127,7 @@ namespace XCSP3Core {
          * <objectives>
          *
          * @param type SUM, PRODUCT...
-         * @param list the scope
+         * @param list the scope (new trees for each call, the callbacks may keep them)
          */
         virtual void buildObjectiveMinimize(ExpressionObjective type, vector<Tree *> &trees) {
             (void)type; (void)trees;
@@ -2711,7 +3147,7 @@ namespace XCSP3Core {
          * <objectives>
          *
          * @param type SUM, PRODUCT...
-         * @param list the scope
+         * @param list the scope (new trees for each call, the callbacks may keep them)
          */
         virtual void buildObjectiveMaximize(ExpressionObjective type, vector<Tree *> &trees) {
             (void)type; (void)trees;
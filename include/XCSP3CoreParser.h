@@ -26,10 +26,13 @@
 #ifndef _XMLParser_libxml2_h_
 #define _XMLParser_libxml2_h_
 
+#include <atomic>
+#include <exception>
 #include <iostream>
 #include <stdexcept>
 #include <cerrno>
 #include <climits>
+#include <type_traits>
 #include <libxml/parser.h>
 
 #include "XMLParser.h"
@@ -42,6 +45,27 @@ namespace XCSP3Core {
     using namespace std;
 
 
+    /**
+     * A token shared with another thread (a scheduler, a watchdog...) to abort the parsing.
+     * It is checked between chunks of the input and between XML events.
+     */
+    class XCSP3CancellationToken {
+        std::atomic<bool> cancelled;
+
+    public:
+        XCSP3CancellationToken() : cancelled(false) { }
+
+
+        void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+
+
+        void reset() { cancelled.store(false, std::memory_order_relaxed); }
+
+
+        bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+    };
+
+
     /**
      * @brief the parser using the libxml2 library
      */
@@ -49,14 +73,56 @@ namespace XCSP3Core {
 
     protected:
         XMLParser cspParser;
+        XCSP3CoreCallbacks *callbacks;
+        XCSP3CancellationToken *token;
+        xmlParserCtxtPtr context;          // the libxml2 context of the current parse
+        int status;                        // ParseStatus of the current parse
+        std::exception_ptr error;          // exception thrown by a callback, rethrown once libxml2 is cleaned
+        size_t chunkSize, maxChunkSize;    // size of the chunks given to libxml2 (see setChunkSize)
+        ReadAheadMode readAhead;
 
     public:
 
-        XCSP3CoreParser(XCSP3CoreCallbacks *cb) : cspParser(cb) {
+        XCSP3CoreParser(XCSP3CoreCallbacks *cb) : cspParser(cb), callbacks(cb), token(nullptr), context(nullptr),
+                                                  status(PARSE_COMPLETE), chunkSize(1 << 16), maxChunkSize(1 << 20),
+                                                  readAhead(READ_AHEAD_AUTO) {
+            cb->implemented = CALLBACK_ALL; // see XCSP3CoreParserT
             LIBXML_TEST_VERSION
         }
 
 
+        /**
+         * The input is read by chunks of initial bytes, doubled each time the stream fills a whole chunk
+         * up to maximum bytes (64KB and 1MB by default, larger chunks are slower with libxml2 on warm caches)
+         */
+        void setChunkSize(size_t initial, size_t maximum) {
+            if(initial < 4 || maximum < initial || maximum > INT_MAX)
+                throw runtime_error("chunk sizes must satisfy 4 <= initial <= maximum <= INT_MAX");
+            chunkSize = initial;
+            maxChunkSize = maximum;
+        }
+
+
+        /**
+         * Read the next chunk in a second thread while the current one is parsed (see ReadAheadMode).
+         * Note that a stopped parse waits for the pending read to end.
+         */
+        void setReadAhead(ReadAheadMode mode) { readAhead = mode; }
+
+
+        /**
+         * Abort the parsing when the token is cancelled (nullptr to remove it)
+         */
+        void setCancellationToken(XCSP3CancellationToken *t) { token = t; }
+
+
+        /**
+         * Parse the instance.
+         * The parsing ends early if a callback calls stopParsing (PARSE_STOPPED is returned) or if the
+         * cancellation token is cancelled (PARSE_CANCELLED). An exception thrown by a callback also stops it,
+         * and is rethrown. In all cases, the libxml2 context is freed and the parser can be used again.
+         * @return a ParseStatus, PARSE_COMPLETE if the whole instance was parsed
+         */
         int parse(istream &in);
 
 
@@ -65,6 +131,13 @@ namespace XCSP3Core {
 
     protected:
 
+        // Stop libxml2 if an exception was thrown, a callback asked to stop or the token is cancelled
+        void checkStop();
+
+
+        bool stopped() const { return status != PARSE_COMPLETE || error; }
+
+
 
         /*************************************************************************
          *
@@ -88,6 +161,90 @@ namespace XCSP3Core {
         static void endElement(void *parser, const xmlChar *name);
     };
 
+
+    /*************************************************************************
+     *
+     * Callbacks known at compile time
+     *
+     *************************************************************************/
+
+    // Owner<Args...>::of(&C::method) is the class that declares the overload method(Args...) seen from C
+    template<class... Args>
+    struct XCSP3CallbackOwner {
+        template<class C>
+        static C of(void (C::*)(Args...));
+    };
+
+// Name<C>::value is true if C, or one of its bases other than XCSP3CoreCallbacks, overrides method(Args...)
+#define XCSP3_OVERRIDES(Name, method, ...)                                                                        \
+    template<class C, class = void>                                                                             \
+    struct Name : std::false_type { };                                                                          \
+    template<class C>                                                                                           \
+    struct Name<C, typename std::enable_if<std::is_same<XCSP3CoreCallbacks,                                      \
+            decltype(XCSP3CallbackOwner<__VA_ARGS__>::of(&C::method))>::value == false>::type> : std::true_type { };
+
+    XCSP3_OVERRIDES(OverridesPrimitiveXKY, buildConstraintPrimitive, string, OrderType, XVariable *, int, XVariable *)
+    XCSP3_OVERRIDES(OverridesPrimitiveXK, buildConstraintPrimitive, string, OrderType, XVariable *, int)
+    XCSP3_OVERRIDES(OverridesPrimitiveIn, buildConstraintPrimitive, string, XVariable *, bool, int, int)
+    XCSP3_OVERRIDES(OverridesMult, buildConstraintMult, string, XVariable *, XVariable *, XVariable *)
+    XCSP3_OVERRIDES(OverridesUnaryExtension, buildConstraintExtension, string, XVariable *, vector<int> &, bool, bool)
+    XCSP3_OVERRIDES(OverridesSum, buildConstraintSum, string, vector<XVariable *> &, vector<int> &, XCondition &)
+    XCSP3_OVERRIDES(OverridesAtMost, buildConstraintAtMost, string, vector<XVariable *> &, int, int)
+    XCSP3_OVERRIDES(OverridesAtLeast, buildConstraintAtLeast, string, vector<XVariable *> &, int, int)
+    XCSP3_OVERRIDES(OverridesExactlyK, buildConstraintExactlyK, string, vector<XVariable *> &, int, int)
+    XCSP3_OVERRIDES(OverridesExactlyVariable, buildConstraintExactlyVariable, string, vector<XVariable *> &, int, XVariable *)
+    XCSP3_OVERRIDES(OverridesAmong, buildConstraintAmong, string, vector<XVariable *> &, vector<int> &, int)
+    XCSP3_OVERRIDES(OverridesNotAllEqual, buildConstraintNotAllEqual, string, vector<XVariable *> &)
+    XCSP3_OVERRIDES(OverridesAllEqual, buildConstraintAllEqual, string, vector<XVariable *> &)
+    XCSP3_OVERRIDES(OverridesAllDifferent, buildConstraintAlldifferent, string, vector<XVariable *> &)
+
+#undef XCSP3_OVERRIDES
+
+
+    /**
+     * The SpecialCallback overridden by the class C
+     */
+    template<class C>
+    constexpr int implementedCallbacks() {
+        return (OverridesPrimitiveXKY<C>::value ? CALLBACK_PRIMITIVE_XKY : 0) |
+               (OverridesPrimitiveXK<C>::value ? CALLBACK_PRIMITIVE_XK : 0) |
+               (OverridesPrimitiveIn<C>::value ? CALLBACK_PRIMITIVE_IN : 0) |
+               (OverridesMult<C>::value ? CALLBACK_MULT : 0) |
+               (OverridesUnaryExtension<C>::value ? CALLBACK_UNARY_EXTENSION : 0) |
+               (OverridesSum<C>::value ? CALLBACK_SUM : 0) |
+               (OverridesAtMost<C>::value ? CALLBACK_AT_MOST : 0) |
+               (OverridesAtLeast<C>::value ? CALLBACK_AT_LEAST : 0) |
+               (OverridesExactlyK<C>::value ? CALLBACK_EXACTLY_K : 0) |
+               (OverridesExactlyVariable<C>::value ? CALLBACK_EXACTLY_VARIABLE : 0) |
+               (OverridesAmong<C>::value ? CALLBACK_AMONG : 0) |
+               (OverridesNotAllEqual<C>::value ? CALLBACK_NOT_ALL_EQUAL : 0) |
+               (OverridesAllEqual<C>::value ? CALLBACK_ALL_EQUAL : 0) |
+               (OverridesAllDifferent<C>::value ? CALLBACK_ALL_DIFFERENT : 0);
+    }
+
+
+    /**
+     * A parser for callbacks of a type known at compile time.
+     * The special callbacks (see SpecialCallback) that Callbacks does not override are known at compile time:
+     * the parser does not look for their special cases (no pattern matching, no argument preparation) and calls
+     * the general callback instead of the default implementation, that throws.
+     * Other callbacks are still called through the virtual interface of XCSP3CoreCallbacks.
+     * The mask is computed from Callbacks, not from the dynamic type of cb: special callbacks overridden only by a
+     * class derived from Callbacks are not called, use the most derived class as template argument.
+     */
+    template<class Callbacks>
+    class XCSP3CoreParserT : public XCSP3CoreParser {
+        static_assert(std::is_base_of<XCSP3CoreCallbacks, Callbacks>::value, "Callbacks must derive from XCSP3CoreCallbacks");
+
+    public:
+        static constexpr int implemented = implementedCallbacks<Callbacks>();
+
+
+        explicit XCSP3CoreParserT(Callbacks *cb) : XCSP3CoreParser(cb) {
+            cb->implemented = implemented;
+        }
+    };
+
 }
 
 #endif
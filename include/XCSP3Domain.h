@@ -26,7 +26,9 @@
 #ifndef XDOMAIN_H
 #define    XDOMAIN_H
 
+#include <cstdint>
 #include <limits>
+#include <mutex>
 #include <vector>
 #include <iostream>
 #include <stdexcept>
@@ -121,24 +123,110 @@ namespace XCSP3Core {
 
     };
 
+
+    /**
+     * The runs of a domain seen as XIntegerValue and XIntegerInterval objects, as the former public vector
+     * values of XDomainInteger: domain->values.size(), domain->values[i] and range-based for loops still work.
+     * The objects are created on the first access (size() does not create them) and owned by the domain.
+     * This view is read only, the domain is built with addValue and addInterval.
+     */
+    class XDomainValues {
+        friend class XDomainInteger;
+
+        const std::vector<int> &runs;
+        mutable std::vector<XIntegerEntity *> entities;
+        mutable std::once_flag created;
+
+
+        XDomainValues(const std::vector<int> &r) : runs(r) {}
+
+
+        const std::vector<XIntegerEntity *> &get() const {
+            std::call_once(created, [this]() {
+                entities.reserve(runs.size() / 2);
+                for(unsigned int i = 0; i < runs.size(); i += 2)
+                    entities.push_back(runs[i] == runs[i + 1] ? static_cast<XIntegerEntity *>(new XIntegerValue(runs[i]))
+                                                              : new XIntegerInterval(runs[i], runs[i + 1]));
+            });
+            return entities;
+        }
+
+
+    public :
+        typedef std::vector<XIntegerEntity *>::const_iterator const_iterator;
+
+
+        size_t size() const { return runs.size() / 2; }
+
+
+        bool empty() const { return runs.empty(); }
+
+
+        XIntegerEntity *operator[](size_t i) const { return get()[i]; }
+
+
+        const_iterator begin() const { return get().begin(); }
+
+
+        const_iterator end() const { return get().end(); }
+
+
+        operator const std::vector<XIntegerEntity *> &() const { return get(); }
+
+
+        ~XDomainValues() {
+            for(XIntegerEntity *e : entities)
+                delete e;
+        }
+    };
+
+
+    /**
+     * The domain is stored as a sorted array of runs (minimum, maximum), one run per value or interval of the
+     * XCSP3 text, without any object per value. While it is small (MAX_BITSET_WIDTH values between the
+     * minimum and the maximum) and has holes, a bitset also gives membership in constant time.
+     */
     class XDomainInteger : public XDomain {
 //        friend class XMLParser;
     protected :
+        static const int MAX_BITSET_WIDTH = 1024;
+
         int size;
         int top {std::numeric_limits<int>::min()};
+        std::vector<int> runs;       // min0 max0 min1 max1 ...
+        std::vector<uint64_t> bits;  // bit v - minimum() is set iff v belongs to the domain (if dense)
+        bool dense;
 
 
-        void addEntity(XIntegerEntity *e) {
-            values.push_back(e);
-            size += e->width();
+        void setBits(int min, int max) {
+            for(int v = min - runs[0]; v <= max - runs[0]; v++)
+                bits[v >> 6] |= uint64_t(1) << (v & 63);
+        }
+
+
+        void addRun(int min, int max) {
+            runs.push_back(min);
+            runs.push_back(max);
+            size += max - min + 1;
+            if(dense == false || runs.size() == 2)
+                return;
+            if((long long) max - runs[0] >= MAX_BITSET_WIDTH) {
+                dense = false;
+                std::vector<uint64_t>().swap(bits);
+                return;
+            }
+            bits.resize(((max - runs[0]) >> 6) + 1, 0);
+            if(runs.size() == 4)  // the first hole: the first run is also set
+                setBits(runs[0], runs[1]);
+            setBits(min, max);
         }
 
 
     public:
-        std::vector<XIntegerEntity *> values;
+        XDomainValues values;   // compatibility view of the runs (see XDomainValues), prefer the run accessors
 
 
-        XDomainInteger() : size(0) {}
+        XDomainInteger() : size(0), dense(true), values(runs) {}
 
 
         int nbValues() const {
@@ -146,55 +234,84 @@ namespace XCSP3Core {
         }
 
 
-        int minimum() {
-            return values[0]->minimum();
+        int minimum() const {
+            return runs[0];
         }
 
 
-        int maximum() {
-            return values[values.size() - 1]->maximum();
+        int maximum() const {
+            return runs.back();
         }
 
 
-        int isInterval() {
+        int isInterval() const {
             return size == maximum() - minimum() + 1;
         }
 
 
+        /**
+         * The runs, in increasing order: the values and intervals of the XCSP3 text
+         */
+        int nbRuns() const {
+            return static_cast<int>(runs.size() / 2);
+        }
+
+
+        int runMinimum(int i) const {
+            return runs[2 * i];
+        }
+
+
+        int runMaximum(int i) const {
+            return runs[2 * i + 1];
+        }
+
+
+        bool contains(int v) const {
+            if(runs.empty() || v < minimum() || v > maximum())
+                return false;
+            if(runs.size() == 2)
+                return true;
+            if(dense) {
+                int offset = v - runs[0];
+                return (bits[offset >> 6] >> (offset & 63)) & 1;
+            }
+            // the last run whose minimum is <= v
+            int low = 0, high = nbRuns() - 1;
+            while(low < high) {
+                int middle = (low + high + 1) / 2;
+                if(runs[2 * middle] <= v)
+                    low = middle;
+                else
+                    high = middle - 1;
+            }
+            return v <= runs[2 * low + 1];
+        }
+
+
         void addValue(int v) {
             if(v <= top)
                 throw std::runtime_error{"not sequence domain"};
-            addEntity(new XIntegerValue(top = v));
+            addRun(v, top = v);
         }
 
 
         void addInterval(int min, int max) {
             if(min >= max || min <= top)
                 throw std::runtime_error{"not sequence domain"};
-            addEntity(new XIntegerInterval(min, top = max));
+            addRun(min, top = max);
         }
 
 
         friend ostream &operator<<(ostream &f, const XDomainInteger &d);
 
 
-        bool equals(XDomainInteger *arg) const {
-            if(nbValues() != arg->nbValues())
-                return false;
-            if(values.size() != arg->values.size())
-                return false;
-            for(unsigned int i = 0; i < arg->values.size(); i++) {
-                if(values[i]->equals(arg->values[i]) == false)
-                    return false;
-            }
-            return true;
+        bool equals(const XDomainInteger *arg) const {
+            return size == arg->size && runs == arg->runs;
         }
 
 
-        virtual ~XDomainInteger() {
-            for(XIntegerEntity *xi : values)
-                delete xi;
-        }
+        virtual ~XDomainInteger() {}
 
     };
 }
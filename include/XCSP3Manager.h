@@ -31,6 +31,7 @@
 #include "XCSP3Variable.h"
 #include "XCSP3Constraint.h"
 #include "XCSP3Objective.h"
+#include "XCSP3Profiler.h"
 #include <string>
 #include <regex>
 #include <map>
@@ -40,41 +41,51 @@ namespace XCSP3Core {
 
 
     class PrimitivePattern;
+
+
     class XCSP3Manager {
 
     public :
         XCSP3CoreCallbacks *callback;
         std::map<std::string, XEntity *> &mapping;
-        std::string blockClasses;
+        std::vector<unsigned long long> blockMasks;   // classes to discard of the enclosing blocks (see classMask)
 
 
-        inline bool discardedClasses(string classes) {
-            return callback->discardedClasses(blockClasses) || callback->discardedClasses(classes);
+        inline bool discardedClasses(const string &classes) {
+            return (blockMasks.empty() == false && blockMasks.back() != 0) || callback->discardedClasses(classes);
         }
 
 
     private :
         std::vector<XCSP3Core::PrimitivePattern*> patterns;
         bool recognizePrimitives(std::string id, Tree *tree);
-        void createPrimitivePatterns();
-        void destroyPrimitivePatterns();
+        void createPrimitivePatterns(std::vector<XCSP3Core::PrimitivePattern*> &set);
+        void destroyPrimitivePatterns(std::vector<XCSP3Core::PrimitivePattern*> &set);
 
         void containsTrees(vector<XVariable *>&list, vector<Tree *>&newlist);
 
+        template<class V, class O>
+        void buildCardinality(XConstraintCardinality *constraint, vector<V> &values, vector<O> &occurs);
+
     public :
         // XCSP3CoreCallbacks *c, std::map<std::string, XEntity *> &m, bool
-        XCSP3Manager(XCSP3CoreCallbacks *c, std::map<std::string, XEntity *> &m, bool = true) : callback(c), mapping(m), blockClasses("") { }
+        XCSP3Manager(XCSP3CoreCallbacks *c, std::map<std::string, XEntity *> &m, bool = true) : callback(c), mapping(m) { }
+
+
+        ~XCSP3Manager() {
+            destroyPrimitivePatterns(patterns);     // the parsing was aborted inside <constraints>
+        }
 
 
         void beginInstance(InstanceType type) {
             callback->_arguments = nullptr;
+            blockMasks.clear();
             callback->beginInstance(type);
         }
 
 
-        void endInstance() {
-            callback->endInstance();
-        }
+        // Not inline: XCSP3_PROFILE is only defined when the library itself is compiled
+        void endInstance();
 
 
         void beginVariables() {
@@ -105,7 +116,7 @@ namespace XCSP3Core {
 
         void beginConstraints() {
             if(callback->recognizeSpecialIntensionCases)
-                createPrimitivePatterns();
+                createPrimitivePatterns(patterns);
             callback->beginConstraints();
         }
 
@@ -113,7 +124,7 @@ namespace XCSP3Core {
         void endConstraints() {
             callback->endConstraints();
             if(callback->recognizeSpecialIntensionCases)
-                destroyPrimitivePatterns();
+                destroyPrimitivePatterns(patterns);
         }
 
 
@@ -152,6 +163,9 @@ namespace XCSP3Core {
         void newConstraintExtension(XConstraintExtension *constraint);
 
 
+        void buildUnaryExtension(string &id, XVariable *x, vector<int> &values, bool support, bool hasStar);
+
+
         void newConstraintExtensionAsLastOne(XConstraintExtension *constraint);
 
 
@@ -164,8 +178,14 @@ namespace XCSP3Core {
         void newConstraintRegular(XConstraintRegular *constraint);
 
 
+        void newConstraintRegularAsLastOne(XConstraintRegular *constraint, int start, vector<int> &final);
+
+
         void newConstraintMDD(XConstraintMDD *constraint);
 
+
+        void newConstraintMDDAsLastOne(XConstraintMDD *constraint);
+
         //--------------------------------------------------------------------------------------
         // Comparison constraints
         //--------------------------------------------------------------------------------------
@@ -197,6 +217,9 @@ namespace XCSP3Core {
     protected :
         void normalizeSum(vector < XVariable * > &list, vector<int> & coefs);
 
+
+        bool containsDuplicates(vector<XVariable *> &list);
+
     public :
         void newConstraintSum(XConstraintSum *constraint);
 
@@ -289,13 +312,13 @@ namespace XCSP3Core {
         // block of  constraints
         //--------------------------------------------------------------------------------------
         void beginBlock(string classes) {
-            blockClasses = classes;
+            blockMasks.push_back(callback->classMask(classes));
             callback->beginBlock(classes);
         }
 
 
         void endBlock() {
-            blockClasses = "";
+            blockMasks.pop_back();
             callback->endBlock();
         }
 
@@ -315,6 +338,15 @@ namespace XCSP3Core {
         template<class T> void unfoldConstraint(XConstraintGroup *group, int i, void (XCSP3Manager::*newConstraint)(T* ));
 
 
+        // Work done by the unfolding threads (see XCSP3CoreCallbacks::unfoldThreads) besides unfoldArgumentNumber
+        void prepareUnfolded(XConstraint *) { }
+        void prepareUnfolded(XConstraintIntension *constraint);
+
+
+        template<class T> void unfoldConstraintsInParallel(XConstraintGroup *group, void (XCSP3Manager::*newConstraint)(T* ));
+        bool unfoldGroupInParallel(XConstraintGroup *group);
+
+
         void newConstraintGroup(XConstraintGroup *group);
 
 
@@ -0,0 +1,109 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XCSP3PROFILER_H
+#define XCSP3PROFILER_H
+
+/**
+ * Optional instrumentation of the parser (cmake option XCSP3_PROFILE).
+ * Records calls, cumulative and max time of:
+ *  - each tag (beginTag, text and endTag, with the number of bytes of text)
+ *  - each XCSP3Manager::newConstraintXXX
+ *  - each user callback buildXXX
+ * The report is printed on cerr at the end of the instance.
+ * Without XCSP3_PROFILE, all macros below are empty.
+ */
+
+#ifdef XCSP3_PROFILE
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace XCSP3Core {
+
+    class XCSP3Profiler {
+    public :
+        enum Category {
+            PROFILE_TAG, PROFILE_CONSTRAINT, PROFILE_CALLBACK
+        };
+
+        struct Entry {
+            unsigned long long calls = 0;
+            unsigned long long bytes = 0;
+            double total = 0;   // seconds
+            double max = 0;
+        };
+
+
+        static XCSP3Profiler &instance();
+
+
+        void record(Category category, const std::string &name, double seconds);
+
+
+        void addBytes(Category category, const std::string &name, size_t bytes);
+
+
+        // Print all entries (sorted by total time in each category) and forget them
+        void report(std::ostream &out);
+
+    private :
+        std::mutex mutex;
+        std::map<std::pair<int, std::string>, Entry> entries;
+    };
+
+
+    class XCSP3ProfileTimer {
+        XCSP3Profiler::Category category;
+        std::string name;
+        std::chrono::steady_clock::time_point start;
+    public :
+        XCSP3ProfileTimer(XCSP3Profiler::Category c, std::string n) : category(c), name(std::move(n)), start(std::chrono::steady_clock::now()) { }
+
+
+        ~XCSP3ProfileTimer() {
+            XCSP3Profiler::instance().record(category, name, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+    };
+}
+
+#define XCSP3_PROFILE_SCOPE(category, name) XCSP3Core::XCSP3ProfileTimer xcsp3ProfileTimer(XCSP3Core::XCSP3Profiler::category, name)
+#define XCSP3_PROFILE_BYTES(category, name, n) XCSP3Core::XCSP3Profiler::instance().addBytes(XCSP3Core::XCSP3Profiler::category, name, n)
+#define XCSP3_PROFILE_REPORT(out) XCSP3Core::XCSP3Profiler::instance().report(out)
+// The timer is a temporary: it is destroyed at the end of the full expression, that is after the call
+#define XCSP3_CALLBACK(cb, method) (XCSP3Core::XCSP3ProfileTimer(XCSP3Core::XCSP3Profiler::PROFILE_CALLBACK, #method), (cb))->method
+
+#else
+
+#define XCSP3_PROFILE_SCOPE(category, name)
+#define XCSP3_PROFILE_BYTES(category, name, n)
+#define XCSP3_PROFILE_REPORT(out)
+#define XCSP3_CALLBACK(cb, method) (cb)->method
+
+#endif
+
+#endif /* XCSP3PROFILER_H */
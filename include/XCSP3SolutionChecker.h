@@ -0,0 +1,493 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XCSP3SOLUTIONCHECKER_H
+#define XCSP3SOLUTIONCHECKER_H
+
+#include "XCSP3CoreCallbacks.h"
+#include <memory>
+#include <unordered_map>
+
+/**
+ * A solution checker built on the callbacks.
+ * The instance is parsed once and stored in a compact model where variables are dense integers
+ * (in the order of declaration). Then, assignments (one value per variable) can be checked:
+ *
+ *   XCSP3SolutionChecker checker;
+ *   XCSP3CoreParser parser(&checker);
+ *   parser.parse("instance.xml");
+ *   vector<int> assignment, violated;
+ *   checker.parseInstantiation(solution, assignment); // or assignment[checker.variable("x[0]")] = ...
+ *   if(checker.check(assignment, violated) == false)
+ *       ...  // checker.constraintId(violated[i])
+ *   long long cost = checker.objectiveValue(assignment);
+ *
+ * Constraints are checked in parallel (see nbThreads).
+ * Many candidate assignments can be checked at once with checkBatch (feasibility and objective of each row).
+ * Checked constraints: extension, intension, instantiation, clause, alldifferent (except, list, matrix),
+ * allEqual, notAllEqual, ordered, lex (matrix), sum, count, nValues, cardinality, minimum/maximum (arg),
+ * element (matrix), channel, regular, mdd, circuit, noOverlap, cumulative.
+ * Other constraints are not supported: the default callback throws an exception during the parsing.
+ */
+
+namespace XCSP3Core {
+
+    /**
+     * Thrown when an expression is undefined for an assignment: division or modulo by zero,
+     * negative exponent, or overflow (expressions are evaluated in long long, their values must fit in an int).
+     * A constraint that cannot be evaluated is violated.
+     */
+    class XCheckerUndefined : public runtime_error {
+    public :
+        XCheckerUndefined(const string &what) : runtime_error("checker: " + what) {}
+    };
+
+
+    /**
+     * An expression (intension, tree in a list, objective) compiled in postfix notation.
+     * Variables are given by their index in the assignment.
+     */
+    class XCheckerExpression {
+    public :
+        class Instruction {
+        public :
+            ExpressionType op;
+            int arg;        // OVAR: the variable, ODECIMAL: the value, otherwise: the number of operands
+            Instruction(ExpressionType o, int a) : op(o), arg(a) {}
+        };
+
+        static const int BLOCK = 64;    // number of rows evaluated together by the batch evaluation
+
+        vector<Instruction> code;
+        int depth;          // maximal size of the stack
+
+
+        XCheckerExpression() : depth(0) {}
+
+
+        XCheckerExpression(Node *root, const unordered_map<string, int> &variables);
+
+
+        // Throw XCheckerUndefined if the expression is undefined
+        int evaluate(const int *assignment) const;
+
+
+        // Evaluate the expression on nbRows assignments (row r starts at assignments + r * stride)
+        void evaluate(const int *assignments, int stride, int nbRows, int *results) const;
+
+
+    protected :
+        int compile(Node *node, const unordered_map<string, int> &variables);
+    };
+
+
+    /**
+     * An element of a list: a variable, a constant or an expression.
+     */
+    class XCheckerTerm {
+    public :
+        static const int CONSTANT = -1;
+        static const int EXPRESSION = -2;
+
+        int variable;       // the index of the variable, CONSTANT or EXPRESSION
+        int value;          // the constant or the index of the expression
+
+
+        XCheckerTerm(int x, int v) : variable(x), value(v) {}
+    };
+
+
+    /**
+     * A compiled XCondition
+     */
+    class XCheckerCondition {
+    public :
+        OrderType op;
+        OperandType operandType;
+        long long val;
+        int min, max;
+        int variable;
+        vector<int> set;
+
+
+        XCheckerCondition() : op(EQ), operandType(INTEGER), val(0), min(0), max(0), variable(-1) {}
+
+
+        XCheckerCondition(XCondition &xc, const unordered_map<string, int> &variables);
+
+
+        bool holds(long long value, const int *assignment) const;
+    };
+
+
+    /**
+     * A constraint of the checker. Terms (the list of the constraint) and expressions are
+     * stored here, each kind of constraint adds its own parameters (see XCSP3SolutionChecker.cc).
+     */
+    class XCheckerConstraint {
+    public :
+        string id;
+        vector<XCheckerTerm> terms;
+        vector<XCheckerExpression> expressions;
+
+
+        XCheckerConstraint(string i) : id(i) {}
+
+
+        virtual ~XCheckerConstraint() {}
+
+
+        // May throw XCheckerUndefined (see isSatisfied)
+        virtual bool satisfied(const int *assignment) const = 0;
+
+
+        // satisfied, false if an expression is undefined
+        bool isSatisfied(const int *assignment) const;
+
+
+        // result[r] = isSatisfied(assignments + r * stride), for r in [0, nbRows[
+        // May throw XCheckerUndefined if some row is undefined
+        virtual void satisfiedRows(const int *assignments, int stride, int nbRows, char *result) const;
+
+
+        int value(const XCheckerTerm &t, const int *assignment) const {
+            if(t.variable >= 0)
+                return assignment[t.variable];
+            if(t.variable == XCheckerTerm::CONSTANT)
+                return t.value;
+            return expressions[t.value].evaluate(assignment);
+        }
+    };
+
+    class XCheckerTuples;
+    class XCheckerAutomaton;
+    class XCheckerObjective;
+
+
+    class XCSP3SolutionChecker : public XCSP3CoreCallbacks {
+    public :
+        int nbThreads;      // number of threads used by check and checkBatch (1: sequential), default: hardware concurrency
+
+
+        XCSP3SolutionChecker();
+
+
+        ~XCSP3SolutionChecker();
+
+
+        int nbVariables() const { return variableIds.size(); }
+
+
+        int nbConstraints() const { return constraints.size(); }
+
+
+        int variable(const string &id) const;          // -1 if unknown
+
+
+        const string &variableId(int x) const { return variableIds[x]; }
+
+
+        int minValue(int x) const { return mins[x]; }
+
+
+        int maxValue(int x) const { return maxs[x]; }
+
+
+        const string &constraintId(int c) const { return constraints[c]->id; }
+
+
+        bool hasObjective() const { return objective != nullptr; }
+
+
+        bool isMinimization() const { return minimize; }
+
+
+        /**
+         * Fill the assignment (one value per variable, STAR if not assigned) with an instantiation:
+         * <instantiation> <list> x[] y </list> <values> 1 2 3 </values> </instantiation>
+         * Compact forms of arrays and compact values (0x3) are accepted.
+         */
+        void parseInstantiation(const string &xml, vector<int> &assignment) const;
+
+
+        /**
+         * Fill variables with the variables whose value is not in the domain (or not assigned)
+         */
+        void checkDomains(const vector<int> &assignment, vector<int> &variables) const;
+
+
+        /**
+         * Fill violated with the indexes of the violated constraints (sorted).
+         * Constraints that cannot be evaluated (see XCheckerUndefined) are violated.
+         * @return true if no constraint is violated
+         */
+        bool check(const vector<int> &assignment, vector<int> &violated) const;
+
+
+        /**
+         * @throw XCheckerUndefined if the objective is undefined for this assignment (division by zero, overflow...)
+         */
+        long long objectiveValue(const vector<int> &assignment) const;
+
+
+        /**
+         * Check a batch of assignments stored row by row (nbVariables() values per row).
+         * feasible[r] is 1 iff row r satisfies all constraints (domains are not checked) and
+         * objectives[r] is the objective value of row r (empty if there is no objective).
+         * A row whose objective is undefined (see XCheckerUndefined) is unfeasible, its objective is 0.
+         * Rows are shared among threads (see nbThreads).
+         * @return the number of feasible rows
+         */
+        int checkBatch(const vector<int> &assignments, vector<char> &feasible, vector<long long> &objectives) const;
+
+        // Callbacks
+
+        void beginVariableArray(string id) override;
+
+        void endVariableArray() override;
+
+        void buildVariableInteger(string id, int minValue, int maxValue) override;
+
+        void buildVariableInteger(string id, vector<int> &values) override;
+
+        void buildConstraintExtension(string id, vector<XVariable *> list, vector<vector<int>> &tuples, bool support, bool hasStar) override;
+
+        void buildConstraintExtension(string id, XVariable *variable, vector<int> &tuples, bool support, bool hasStar) override;
+
+        void buildConstraintExtensionAs(string id, vector<XVariable *> list, bool support, bool hasStar) override;
+
+        void buildConstraintIntension(string id, Tree *tree) override;
+
+        void buildConstraintInstantiation(string id, vector<XVariable *> &list, vector<int> &values) override;
+
+        void buildConstraintClause(string id, vector<XVariable *> &positive, vector<XVariable *> &negative) override;
+
+        void buildConstraintAlldifferent(string id, vector<XVariable *> &list) override;
+
+        void buildConstraintAlldifferent(string id, vector<Tree *> &list) override;
+
+        void buildConstraintAlldifferentExcept(string id, vector<XVariable *> &list, vector<int> &except) override;
+
+        void buildConstraintAlldifferentList(string id, vector<vector<XVariable *>> &lists) override;
+
+        void buildConstraintAlldifferentMatrix(string id, vector<vector<XVariable *>> &matrix) override;
+
+        void buildConstraintAllEqual(string id, vector<XVariable *> &list) override;
+
+        void buildConstraintAllEqual(string id, vector<Tree *> &list) override;
+
+        void buildConstraintNotAllEqual(string id, vector<XVariable *> &list) override;
+
+        void buildConstraintOrdered(string id, vector<XVariable *> &list, OrderType order) override;
+
+        void buildConstraintOrdered(string id, vector<XVariable *> &list, vector<int> &lengths, OrderType order) override;
+
+        void buildConstraintOrdered(string id, vector<XVariable *> &list, vector<XVariable *> &lengths, OrderType order) override;
+
+        void buildConstraintLex(string id, vector<vector<XVariable *>> &lists, OrderType order) override;
+
+        void buildConstraintLexMatrix(string id, vector<vector<XVariable *>> &matrix, OrderType order) override;
+
+        void buildConstraintSum(string id, vector<XVariable *> &list, vector<int> &coeffs, XCondition &cond) override;
+
+        void buildConstraintSum(string id, vector<XVariable *> &list, XCondition &cond) override;
+
+        void buildConstraintSum(string id, vector<XVariable *> &list, vector<XVariable *> &coeffs, XCondition &cond) override;
+
+        void buildConstraintSum(string id, vector<Tree *> &trees, XCondition &cond) override;
+
+        void buildConstraintSum(string id, vector<Tree *> &trees, vector<int> &coefs, XCondition &cond) override;
+
+        void buildConstraintCount(string id, vector<XVariable *> &list, vector<int> &values, XCondition &xc) override;
+
+        void buildConstraintCount(string id, vector<XVariable *> &list, vector<XVariable *> &values, XCondition &xc) override;
+
+        void buildConstraintCount(string id, vector<Tree *> &trees, vector<int> &values, XCondition &xc) override;
+
+        void buildConstraintCount(string id, vector<Tree *> &trees, vector<XVariable *> &values, XCondition &xc) override;
+
+        void buildConstraintNValues(string id, vector<XVariable *> &list, vector<int> &except, XCondition &xc) override;
+
+        void buildConstraintNValues(string id, vector<Tree *> &trees, XCondition &xc) override;
+
+        void buildConstraintNValues(string id, vector<XVariable *> &list, XCondition &xc) override;
+
+        void buildConstraintCardinality(string id, vector<XVariable *> &list, vector<int> values, vector<int> &occurs, bool closed) override;
+
+        void buildConstraintCardinality(string id, vector<XVariable *> &list, vector<int> values, vector<XVariable *> &occurs, bool closed) override;
+
+        void buildConstraintCardinality(string id, vector<XVariable *> &list, vector<int> values, vector<XInterval> &occurs, bool closed) override;
+
+        void buildConstraintCardinality(string id, vector<XVariable *> &list, vector<XVariable *> values, vector<int> &occurs, bool closed) override;
+
+        void buildConstraintCardinality(string id, vector<XVariable *> &list, vector<XVariable *> values, vector<XVariable *> &occurs, bool closed) override;
+
+        void buildConstraintCardinality(string id, vector<XVariable *> &list, vector<XVariable *> values, vector<XInterval> &occurs, bool closed) override;
+
+        void buildConstraintMinimum(string id, vector<XVariable *> &list, XCondition &xc) override;
+
+        void buildConstraintMinimum(string id, vector<Tree *> &list, XCondition &xc) override;
+
+        void buildConstraintMinimum(string id, vector<XVariable *> &list, XVariable *index, int startIndex, RankType rank, XCondition &xc) override;
+
+        void buildConstraintMaximum(string id, vector<XVariable *> &list, XCondition &xc) override;
+
+        void buildConstraintMaximum(string id, vector<Tree *> &list, XCondition &xc) override;
+
+        void buildConstraintMaximum(string id, vector<XVariable *> &list, XVariable *index, int startIndex, RankType rank, XCondition &xc) override;
+
+        void buildConstraintMaximumArg(string id, vector<XVariable *> &list, RankType rank, XCondition &xc) override;
+
+        void buildConstraintMaximumArg(string id, vector<Tree *> &list, RankType rank, XCondition &xc) override;
+
+        void buildConstraintMinimumArg(string id, vector<XVariable *> &list, RankType rank, XCondition &xc) override;
+
+        void buildConstraintMinimumArg(string id, vector<Tree *> &list, RankType rank, XCondition &xc) override;
+
+        void buildConstraintElement(string id, vector<XVariable *> &list, int value) override;
+
+        void buildConstraintElement(string id, vector<XVariable *> &list, XVariable *value) override;
+
+        void buildConstraintElement(string id, vector<int> &list, XVariable *index, int startIndex, XCondition &xc) override;
+
+        void buildConstraintElement(string id, vector<XVariable *> &list, XVariable *index, int startIndex, XCondition &xc) override;
+
+        void buildConstraintElement(string id, vector<int> &list, int startIndex, XVariable *index, RankType rank, int value) override;
+
+        void buildConstraintElement(string id, vector<XVariable *> &list, int startIndex, XVariable *index, RankType rank, int value) override;
+
+        void buildConstraintElement(string id, vector<int> &list, int startIndex, XVariable *index, RankType rank, XVariable *value) override;
+
+        void buildConstraintElement(string id, vector<XVariable *> &list, int startIndex, XVariable *index, RankType rank, XVariable *value) override;
+
+        void buildConstraintElement(string id, vector<vector<XVariable *> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex, XVariable *colIndex, XVariable *value) override;
+
+        void buildConstraintElement(string id, vector<vector<XVariable *> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex, XVariable *colIndex, int value) override;
+
+        void buildConstraintElement(string id, vector<vector<int> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex, XVariable *colIndex, XVariable *value) override;
+
+        void buildConstraintElement(string id, vector<vector<int> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex, XVariable *colIndex, XCondition &xc) override;
+
+        void buildConstraintElement(string id, vector<vector<XVariable *> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex, XVariable *colIndex, XCondition &xc) override;
+
+        void buildConstraintChannel(string id, vector<XVariable *> &list, int startIndex) override;
+
+        void buildConstraintChannel(string id, vector<XVariable *> &list1, int startIndex1, vector<XVariable *> &list2, int startIndex2) override;
+
+        void buildConstraintChannel(string id, vector<XVariable *> &list, int startIndex, XVariable *value) override;
+
+        void buildConstraintRegular(string id, vector<XVariable *> &list, int start, vector<int> &final, XAutomaton &automaton) override;
+
+        void buildConstraintRegularAs(string id, vector<XVariable *> &list, int start, vector<int> &final, XAutomaton &automaton) override;
+
+        void buildConstraintMDD(string id, vector<XVariable *> &list, XAutomaton &automaton) override;
+
+        void buildConstraintMDDAs(string id, vector<XVariable *> &list, XAutomaton &automaton) override;
+
+        void buildConstraintCircuit(string id, vector<XVariable *> &list, int startIndex) override;
+
+        void buildConstraintNoOverlap(string id, vector<XVariable *> &origins, vector<int> &lengths, bool zeroIgnored) override;
+
+        void buildConstraintNoOverlap(string id, vector<XVariable *> &origins, vector<XVariable *> &lengths, bool zeroIgnored) override;
+
+        void buildConstraintNoOverlap(string id, vector<vector<XVariable *>> &origins, vector<vector<int>> &lengths, bool zeroIgnored) override;
+
+        void buildConstraintNoOverlap(string id, vector<vector<XVariable *>> &origins, vector<vector<XVariable *>> &lengths, bool zeroIgnored) override;
+
+        void buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<int> &lengths, vector<int> &heights, XCondition &xc) override;
+
+        void buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<int> &lengths, vector<XVariable *> &varHeights, XCondition &xc) override;
+
+        void buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<XVariable *> &lengths, vector<int> &heights, XCondition &xc) override;
+
+        void buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<XVariable *> &lengths, vector<XVariable *> &heights, XCondition &xc) override;
+
+        void buildObjectiveMinimizeExpression(string expr) override;
+
+        void buildObjectiveMaximizeExpression(string expr) override;
+
+        void buildObjectiveMinimizeVariable(XVariable *x) override;
+
+        void buildObjectiveMaximizeVariable(XVariable *x) override;
+
+        void buildObjectiveMinimize(ExpressionObjective type, vector<XVariable *> &list, vector<int> &coefs) override;
+
+        void buildObjectiveMaximize(ExpressionObjective type, vector<XVariable *> &list, vector<int> &coefs) override;
+
+        void buildObjectiveMinimize(ExpressionObjective type, vector<XVariable *> &list) override;
+
+        void buildObjectiveMaximize(ExpressionObjective type, vector<XVariable *> &list) override;
+
+        void buildObjectiveMinimize(ExpressionObjective type, vector<Tree *> &trees, vector<int> &coefs) override;
+
+        void buildObjectiveMaximize(ExpressionObjective type, vector<Tree *> &trees, vector<int> &coefs) override;
+
+        void buildObjectiveMinimize(ExpressionObjective type, vector<Tree *> &trees) override;
+
+        void buildObjectiveMaximize(ExpressionObjective type, vector<Tree *> &trees) override;
+
+
+    protected :
+        // An array of variables: sizes and variable of each cell (-1 if the cell is empty)
+        class Array {
+        public :
+            vector<int> sizes;
+            vector<int> cells;
+        };
+
+        vector<string> variableIds;
+        unordered_map<string, int> variableIndexes;
+        vector<int> mins, maxs;                     // bounds of the domains
+        vector<vector<int> > domainValues;          // sorted values, empty if the domain is an interval
+        unordered_map<string, Array> arrays;
+        string currentArray;
+        int firstArrayVariable;
+
+        vector<XCheckerConstraint *> constraints;
+        XCheckerObjective *objective;
+        bool minimize;
+        shared_ptr<XCheckerTuples> lastTuples;      // shared by extension constraints (buildConstraintExtensionAs)
+        shared_ptr<XCheckerAutomaton> lastAutomaton; // shared by regular and mdd constraints (buildConstraintXXXAs)
+
+        void addVariable(string &id);
+        void checkConstraints(int from, int to, const int *assignment, vector<int> &violated) const;
+
+        void checkRows(const int *assignments, int nbRows, char *feasible, long long *objectives) const;
+
+        XCheckerTerm term(XVariable *x, XCheckerConstraint *c);
+        XCheckerTerm term(Tree *tree, XCheckerConstraint *c);
+        XCheckerTerm term(int value, XCheckerConstraint *c);
+        template<class T> void terms(vector<T> &list, XCheckerConstraint *c, vector<XCheckerTerm> &result);
+        void constants(vector<int> &values, vector<XCheckerTerm> &result);
+        XCheckerCondition condition(XCondition &xc);
+        XCheckerCondition equalTo(XVariable *x);
+        XCheckerCondition equalTo(int value);
+
+        template<class T> void addElementMatrix(string &id, vector<vector<T> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex, XVariable *colIndex, XCheckerCondition xc);
+        void addAutomaton(string &id, vector<XVariable *> &list, int start, vector<int> &final);
+        void setObjective(bool min, XCheckerObjective *o);
+    };
+}
+
+#endif //XCSP3SOLUTIONCHECKER_H
@@ -75,6 +75,12 @@ namespace XCSP3Core {
         void canonize() {
             root =  root->canonize();
         }
+
+
+        /**
+         * A deep copy of the tree, that does not share any node with it
+         */
+        Tree *copy();
     };
 }
 
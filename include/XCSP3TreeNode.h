@@ -137,6 +137,9 @@ namespace XCSP3Core {
         Node(ExpressionType o) : type(o) {}
 
 
+        virtual ~Node() {}
+
+
         virtual int evaluate(std::map<std::string, int> &tuple) = 0;
 
         virtual Node *canonize() = 0;
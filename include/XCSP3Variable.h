@@ -26,8 +26,11 @@
 #define    XVARIABLE_H
 
 #include "XCSP3Domain.h"
+#include "XCSP3Constants.h"
+#include "XCSP3Tree.h"
 #include <vector>
 #include <sstream>
+#include <mutex>
 
 
 namespace XCSP3Core {
@@ -43,6 +46,7 @@ namespace XCSP3Core {
     class XEntity {
     public :
         std::string id;
+        EntityKind kind;   // Avoid dynamic_cast to know what is behind an entity (integer, tree...)
 
         XEntity();
         XEntity(std::string lid);
@@ -74,7 +78,14 @@ namespace XCSP3Core {
     class XInteger : public XVariable {
     public :
         int value;
-        XInteger(std::string lid, int n) : XVariable(lid, NULL), value(n) { }
+        XInteger(std::string lid, int n) : XVariable(lid, NULL), value(n) { kind = INTEGER_E; }
+
+
+        /**
+         * Shared integers for small constants (no allocation, and no free)
+         * @return nullptr if n is not in the table
+         */
+        static XInteger *constant(int n);
 
     };
 
@@ -82,35 +93,69 @@ namespace XCSP3Core {
      * This is a fake variable used for representing a Tree
      */
     class XTree : public XVariable {
+        Tree *tree;                  // parsed and canonized the first time it is needed
+        std::once_flag canonized;    // a list can be shared by the threads that unfold a group
     public:
-        XTree(std::string lid) : XVariable(lid, NULL) { }
+        XTree(std::string lid) : XVariable(lid, NULL), tree(nullptr) { kind = TREE_E; }
+
+
+        ~XTree() override { delete tree; }
+
+
+        /**
+         * The canonized form of the expression, computed once (for all the rows of a group).
+         * It is freed with this entity: the callbacks are given copies of it (see Tree::copy)
+         */
+        Tree *canonizedTree() {
+            std::call_once(canonized, [this] {
+                tree = new Tree(id);
+                tree->canonize();
+            });
+            return tree;
+        }
     };
 
 
     class XEInterval : public XVariable {
     public :
         int min, max;
-        XEInterval(std::string lid, int mn, int mx) : XVariable(lid, NULL), min(mn), max(mx) { }
+        XEInterval(std::string lid, int mn, int mx) : XVariable(lid, NULL), min(mn), max(mx) { kind = INTERVAL_E; }
     };
 
     class XSet : public XVariable
     {
     public :
-        XSet(std::string lid) : XVariable(lid, NULL) { }
+        XSet(std::string lid) : XVariable(lid, NULL) { kind = SET_E; }
 
     };
 
 
     // Check if a XEntity is an integer
     // If yes, the value is set to its integer
-    bool isInteger(XEntity *xe, int &value);
+    inline bool isInteger(XEntity *xe, int &value) {
+        if(xe == nullptr || xe->kind != INTEGER_E)
+            return false;
+        value = static_cast<XInteger *>(xe)->value;
+        return true;
+    }
 
     // Check if a XEntity is an integer
     // If yes, the value is set to its integer
-    bool isInterval(XEntity *xe, int &min, int &max);
-
-
-    bool isVariable(XEntity *xe, XVariable * &v);
+    inline bool isInterval(XEntity *xe, int &min, int &max) {
+        if(xe == nullptr || xe->kind != INTERVAL_E)
+            return false;
+        min = static_cast<XEInterval *>(xe)->min;
+        max = static_cast<XEInterval *>(xe)->max;
+        return true;
+    }
+
+
+    inline bool isVariable(XEntity *xe, XVariable * &v) {
+        if(xe == nullptr || xe->kind == ARRAY_E)
+            return false;
+        v = static_cast<XVariable *>(xe);
+        return true;
+    }
 
     /**
      * This is a fake variable used as parameter for group constraint
@@ -155,7 +200,7 @@ namespace XCSP3Core {
 
 
 
-        int flatIndexFor(vector<int> indexes);
+        int flatIndexFor(const vector<int> &indexes);
 
 
         bool incrementIndexes(vector<int> &indexes, vector<XIntegerEntity *> &ranges);
@@ -163,7 +208,16 @@ namespace XCSP3Core {
 
 
         /** Returns the list of variables that match the specified compact form. For example, for x[1..3], the list will contain x[1] x[2] and x[3]. */
-        void getVarsFor(vector<XVariable *> &list, string compactForm, vector<int> *flatIndexes = NULL, bool storeIndexes = false);
+        void getVarsFor(vector<XVariable *> &list, const string &compactForm, vector<int> *flatIndexes = NULL, bool storeIndexes = false) {
+            getVarsFor(list, compactForm.data(), compactForm.size(), flatIndexes, storeIndexes);
+        }
+
+
+        /**
+         * Same as above, the compact form is given by its first char and its length (the brackets part only, e.g. [1..3][]).
+         * Brackets are parsed once, and the cells are enumerated with strides (no allocation except in list).
+         */
+        void getVarsFor(vector<XVariable *> &list, const char *compactForm, size_t length, vector<int> *flatIndexes = NULL, bool storeIndexes = false);
 
 
         /** 
@@ -0,0 +1,89 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XCSP3_VIEWS_H
+#define XCSP3_VIEWS_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#ifdef XCSP3_VIEWS
+#include <string_view>
+#endif
+
+
+namespace XCSP3Core {
+
+    /**
+     * A non owning view over contiguous elements (a minimal std::span).
+     * The view is only valid during the callback it is given to: copy the elements if you need them later.
+     */
+    template<class T>
+    class XSpan {
+        T *first;
+        size_t n;
+    public :
+        typedef T value_type;
+        typedef T *iterator;
+
+
+        XSpan() : first(nullptr), n(0) { }
+
+
+        XSpan(T *f, size_t s) : first(f), n(s) { }
+
+
+        XSpan(std::vector<T> &v) : first(v.data()), n(v.size()) { }
+
+
+        T *data() const { return first; }
+
+
+        size_t size() const { return n; }
+
+
+        bool empty() const { return n == 0; }
+
+
+        T &operator[](size_t i) const { return first[i]; }
+
+
+        T *begin() const { return first; }
+
+
+        T *end() const { return first + n; }
+
+
+        std::vector<typename std::remove_const<T>::type> toVector() const {
+            return std::vector<typename std::remove_const<T>::type>(first, first + n);
+        }
+    };
+
+#ifdef XCSP3_VIEWS
+    typedef std::string_view XStringView;
+#endif
+}
+
+#endif /* XCSP3_VIEWS_H */
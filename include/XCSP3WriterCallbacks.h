@@ -0,0 +1,424 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XCSP3WRITERCALLBACKS_H
+#define XCSP3WRITERCALLBACKS_H
+
+#include "XCSP3CoreCallbacks.h"
+#include <cstring>
+#include <ostream>
+
+/**
+ * Callbacks writing the instance back in XCSP3 format.
+ * Override some callbacks (and call the original ones) to filter, rename or split instances:
+ *
+ *   std::ofstream file("out.xml");
+ *   XCSP3WriterCallbacks writer(file);
+ *   XCSP3CoreParser parser(&writer);
+ *   parser.parse("in.xml");
+ *
+ * The output is compact: arrays are rebuilt from their variables, domains and unary tables are
+ * written with intervals, consecutive variables of lists are written x[2..8].
+ * Groups and slides are written back with their arguments when a template reproduces all their constraints
+ * (one constraint per row otherwise). Blocks are kept.
+ * Constraints that are not supported throw an exception (see the default callbacks).
+ */
+
+namespace XCSP3Core {
+
+    /**
+     * A buffered writer on an ostream (integers are formatted without the stream)
+     */
+    class XCSP3BufferedWriter {
+    public :
+        explicit XCSP3BufferedWriter(std::ostream &o, size_t capacity = 1 << 16) : out(o), buffer(capacity), size(0), captured(nullptr) {}
+
+
+        ~XCSP3BufferedWriter() { flush(); }
+
+
+        XCSP3BufferedWriter &put(char c) {
+            if(size == buffer.size())
+                flush();
+            buffer[size++] = c;
+            return *this;
+        }
+
+
+        XCSP3BufferedWriter &put(const char *s, size_t length) {
+            if(size + length > buffer.size()) {
+                flush();
+                if(length > buffer.size()) {
+                    if(captured != nullptr)
+                        captured->append(s, length);
+                    else
+                        out.write(s, length);
+                    return *this;
+                }
+            }
+            std::memcpy(buffer.data() + size, s, length);
+            size += length;
+            return *this;
+        }
+
+
+        XCSP3BufferedWriter &put(const char *s) { return put(s, std::strlen(s)); }
+
+
+        XCSP3BufferedWriter &put(const string &s) { return put(s.data(), s.size()); }
+
+
+        XCSP3BufferedWriter &put(long long value);
+
+
+        void flush() {
+            if(captured != nullptr)
+                captured->append(buffer.data(), size);
+            else
+                out.write(buffer.data(), size);
+            size = 0;
+        }
+
+
+        // Append the next characters to s instead of the stream (until capture(nullptr))
+        void capture(string *s) {
+            flush();
+            captured = s;
+        }
+
+
+        // Write value in front of end, returns the first character
+        static char *format(long long value, char *end);
+
+    protected :
+        std::ostream &out;
+        vector<char> buffer;
+        size_t size;
+        string *captured;
+    };
+
+
+    class XCSP3WriterCallbacks : public XCSP3CoreCallbacks {
+    public :
+        explicit XCSP3WriterCallbacks(std::ostream &out);
+
+
+        void flush() { writer.flush(); }
+
+        // Callbacks
+
+        void beginInstance(InstanceType type) override;
+
+        void endInstance() override;
+
+        void beginVariables() override;
+
+        void endVariables() override;
+
+        void beginVariableArray(string id) override;
+
+        void endVariableArray() override;
+
+        void beginConstraints() override;
+
+        void endConstraints() override;
+
+        void beginBlock(string classes) override;
+
+        void endBlock() override;
+
+        void beginGroup(string id) override;
+
+        void groupArguments(string id, XArguments &arguments) override;
+
+        void endGroup() override;
+
+        void beginSlide(string id, bool circular) override;
+
+        void endSlide() override;
+
+        void beginObjectives() override;
+
+        void endObjectives() override;
+
+        void beginAnnotations() override;
+
+        void endAnnotations() override;
+
+        void buildVariableInteger(string id, int minValue, int maxValue) override;
+
+        void buildVariableInteger(string id, vector<int> &values) override;
+
+        void buildConstraintExtension(string id, vector<XVariable *> list, vector<vector<int>> &tuples, bool support, bool hasStar) override;
+
+        void buildConstraintExtension(string id, XVariable *variable, vector<int> &tuples, bool support, bool hasStar) override;
+
+        void buildConstraintExtensionAs(string id, vector<XVariable *> list, bool support, bool hasStar) override;
+
+        void buildConstraintIntension(string id, string expr) override;
+
+        void buildConstraintIntension(string id, Tree *tree) override;
+
+        void buildConstraintInstantiation(string id, vector<XVariable *> &list, vector<int> &values) override;
+
+        void buildConstraintAlldifferent(string id, vector<XVariable *> &list) override;
+
+        void buildConstraintAlldifferent(string id, vector<Tree *> &list) override;
+
+        void buildConstraintAlldifferentExcept(string id, vector<XVariable *> &list, vector<int> &except) override;
+
+        void buildConstraintAlldifferentList(string id, vector<vector<XVariable *>> &lists) override;
+
+        void buildConstraintAlldifferentMatrix(string id, vector<vector<XVariable *>> &matrix) override;
+
+        void buildConstraintAllEqual(string id, vector<XVariable *> &list) override;
+
+        void buildConstraintAllEqual(string id, vector<Tree *> &list) override;
+
+        void buildConstraintNotAllEqual(string id, vector<XVariable *> &list) override;
+
+        void buildConstraintOrdered(string id, vector<XVariable *> &list, OrderType order) override;
+
+        void buildConstraintOrdered(string id, vector<XVariable *> &list, vector<int> &lengths, OrderType order) override;
+
+        void buildConstraintOrdered(string id, vector<XVariable *> &list, vector<XVariable *> &lengths, OrderType order) override;
+
+        void buildConstraintLex(string id, vector<vector<XVariable *>> &lists, OrderType order) override;
+
+        void buildConstraintLexMatrix(string id, vector<vector<XVariable *>> &matrix, OrderType order) override;
+
+        void buildConstraintSum(string id, vector<XVariable *> &list, vector<int> &coeffs, XCondition &cond) override;
+
+        void buildConstraintSum(string id, vector<XVariable *> &list, XCondition &cond) override;
+
+        void buildConstraintSum(string id, vector<XVariable *> &list, vector<XVariable *> &coeffs, XCondition &cond) override;
+
+        void buildConstraintSum(string id, vector<Tree *> &trees, XCondition &cond) override;
+
+        void buildConstraintSum(string id, vector<Tree *> &trees, vector<int> &coefs, XCondition &cond) override;
+
+        void buildConstraintCount(string id, vector<XVariable *> &list, vector<int> &values, XCondition &xc) override;
+
+        void buildConstraintCount(string id, vector<XVariable *> &list, vector<XVariable *> &values, XCondition &xc) override;
+
+        void buildConstraintCount(string id, vector<Tree *> &trees, vector<int> &values, XCondition &xc) override;
+
+        void buildConstraintCount(string id, vector<Tree *> &trees, vector<XVariable *> &values, XCondition &xc) override;
+
+        void buildConstraintNValues(string id, vector<XVariable *> &list, vector<int> &except, XCondition &xc) override;
+
+        void buildConstraintNValues(string id, vector<Tree *> &trees, XCondition &xc) override;
+
+        void buildConstraintNValues(string id, vector<XVariable *> &list, XCondition &xc) override;
+
+        void buildConstraintCardinality(string id, vector<XVariable *> &list, vector<int> values, vector<int> &occurs, bool closed) override;
+
+        void buildConstraintCardinality(string id, vector<XVariable *> &list, vector<int> values, vector<XVariable *> &occurs, bool closed) override;
+
+        void buildConstraintCardinality(string id, vector<XVariable *> &list, vector<int> values, vector<XInterval> &occurs, bool closed) override;
+
+        void buildConstraintCardinality(string id, vector<XVariable *> &list, vector<XVariable *> values, vector<int> &occurs, bool closed) override;
+
+        void buildConstraintCardinality(string id, vector<XVariable *> &list, vector<XVariable *> values, vector<XVariable *> &occurs, bool closed) override;
+
+        void buildConstraintCardinality(string id, vector<XVariable *> &list, vector<XVariable *> values, vector<XInterval> &occurs, bool closed) override;
+
+        void buildConstraintMinimum(string id, vector<XVariable *> &list, XCondition &xc) override;
+
+        void buildConstraintMinimum(string id, vector<Tree *> &list, XCondition &xc) override;
+
+        void buildConstraintMinimum(string id, vector<XVariable *> &list, XVariable *index, int startIndex, RankType rank, XCondition &xc) override;
+
+        void buildConstraintMaximum(string id, vector<XVariable *> &list, XCondition &xc) override;
+
+        void buildConstraintMaximum(string id, vector<Tree *> &list, XCondition &xc) override;
+
+        void buildConstraintMaximum(string id, vector<XVariable *> &list, XVariable *index, int startIndex, RankType rank, XCondition &xc) override;
+
+        void buildConstraintMaximumArg(string id, vector<XVariable *> &list, RankType rank, XCondition &xc) override;
+
+        void buildConstraintMaximumArg(string id, vector<Tree *> &list, RankType rank, XCondition &xc) override;
+
+        void buildConstraintMinimumArg(string id, vector<XVariable *> &list, RankType rank, XCondition &xc) override;
+
+        void buildConstraintMinimumArg(string id, vector<Tree *> &list, RankType rank, XCondition &xc) override;
+
+        void buildConstraintElement(string id, vector<XVariable *> &list, int value) override;
+
+        void buildConstraintElement(string id, vector<XVariable *> &list, XVariable *value) override;
+
+        void buildConstraintElement(string id, vector<int> &list, XVariable *index, int startIndex, XCondition &xc) override;
+
+        void buildConstraintElement(string id, vector<XVariable *> &list, XVariable *index, int startIndex, XCondition &xc) override;
+
+        void buildConstraintElement(string id, vector<int> &list, int startIndex, XVariable *index, RankType rank, int value) override;
+
+        void buildConstraintElement(string id, vector<XVariable *> &list, int startIndex, XVariable *index, RankType rank, int value) override;
+
+        void buildConstraintElement(string id, vector<int> &list, int startIndex, XVariable *index, RankType rank, XVariable *value) override;
+
+        void buildConstraintElement(string id, vector<XVariable *> &list, int startIndex, XVariable *index, RankType rank, XVariable *value) override;
+
+        void buildConstraintElement(string id, vector<vector<XVariable *> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex, XVariable *colIndex, XVariable *value) override;
+
+        void buildConstraintElement(string id, vector<vector<XVariable *> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex, XVariable *colIndex, int value) override;
+
+        void buildConstraintElement(string id, vector<vector<int> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex, XVariable *colIndex, XVariable *value) override;
+
+        void buildConstraintElement(string id, vector<vector<int> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex, XVariable *colIndex, XCondition &xc) override;
+
+        void buildConstraintElement(string id, vector<vector<XVariable *> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex, XVariable *colIndex, XCondition &xc) override;
+
+        void buildConstraintChannel(string id, vector<XVariable *> &list, int startIndex) override;
+
+        void buildConstraintChannel(string id, vector<XVariable *> &list1, int startIndex1, vector<XVariable *> &list2, int startIndex2) override;
+
+        void buildConstraintChannel(string id, vector<XVariable *> &list, int startIndex, XVariable *value) override;
+
+        void buildConstraintRegular(string id, vector<XVariable *> &list, int start, vector<int> &final, XAutomaton &automaton) override;
+
+        void buildConstraintMDD(string id, vector<XVariable *> &list, XAutomaton &automaton) override;
+
+        void buildConstraintCircuit(string id, vector<XVariable *> &list, int startIndex) override;
+
+        void buildConstraintNoOverlap(string id, vector<XVariable *> &origins, vector<int> &lengths, bool zeroIgnored) override;
+
+        void buildConstraintNoOverlap(string id, vector<XVariable *> &origins, vector<XVariable *> &lengths, bool zeroIgnored) override;
+
+        void buildConstraintNoOverlap(string id, vector<vector<XVariable *>> &origins, vector<vector<int>> &lengths, bool zeroIgnored) override;
+
+        void buildConstraintNoOverlap(string id, vector<vector<XVariable *>> &origins, vector<vector<XVariable *>> &lengths, bool zeroIgnored) override;
+
+        void buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<int> &lengths, vector<int> &heights, XCondition &xc) override;
+
+        void buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<int> &lengths, vector<XVariable *> &varHeights, XCondition &xc) override;
+
+        void buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<XVariable *> &lengths, vector<int> &heights, XCondition &xc) override;
+
+        void buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<XVariable *> &lengths, vector<XVariable *> &heights, XCondition &xc) override;
+
+        void buildObjectiveMinimizeExpression(string expr) override;
+
+        void buildObjectiveMaximizeExpression(string expr) override;
+
+        void buildObjectiveMinimizeVariable(XVariable *x) override;
+
+        void buildObjectiveMaximizeVariable(XVariable *x) override;
+
+        void buildObjectiveMinimize(ExpressionObjective type, vector<XVariable *> &list, vector<int> &coefs) override;
+
+        void buildObjectiveMaximize(ExpressionObjective type, vector<XVariable *> &list, vector<int> &coefs) override;
+
+        void buildObjectiveMinimize(ExpressionObjective type, vector<XVariable *> &list, vector<XVariable *> &coefs) override;
+
+        void buildObjectiveMaximize(ExpressionObjective type, vector<XVariable *> &list, vector<XVariable *> &coefs) override;
+
+        void buildObjectiveMinimize(ExpressionObjective type, vector<XVariable *> &list) override;
+
+        void buildObjectiveMaximize(ExpressionObjective type, vector<XVariable *> &list) override;
+
+        void buildObjectiveMinimize(ExpressionObjective type, vector<Tree *> &trees, vector<int> &coefs) override;
+
+        void buildObjectiveMaximize(ExpressionObjective type, vector<Tree *> &trees, vector<int> &coefs) override;
+
+        void buildObjectiveMinimize(ExpressionObjective type, vector<Tree *> &trees) override;
+
+        void buildObjectiveMaximize(ExpressionObjective type, vector<Tree *> &trees) override;
+
+        void buildAnnotationDecision(vector<XVariable *> &list) override;
+
+    protected :
+        XCSP3BufferedWriter writer;
+
+        // The array under construction: ids of its variables and index of their domain in domains
+        string currentArray;
+        vector<string> arrayVariables;
+        vector<int> arrayDomains;
+        vector<string> domains;
+        vector<int> lastDomain;     // the last domain (min max for an interval, values otherwise)
+        bool lastInterval;
+
+        string lastTuples;          // tuples of the last extension constraint (for buildConstraintExtensionAs)
+        string text;                // formatting buffer
+
+        // The group or slide under construction: its constraints are captured in groupText, one per line
+        bool grouping;
+        bool slide, slideCircular;
+        string groupId;
+        string groupText;
+        XArguments *groupArgs;
+
+        void beginCapture(string &id, bool isSlide, bool isCircular);
+
+        void endCapture();
+
+        bool groupTemplate(string &pattern);
+
+        void writeArguments(XSpan<XVariable *> list);
+
+        void variable(string &id, bool interval, vector<int> &values);
+
+        // Write <tag id="..."> (with a space instead of the > if attributes follow)
+        void open(const char *tag, const string &id, bool attributes = false);
+
+        void close(const char *tag);
+
+        template<class T>
+        void writeList(const char *tag, vector<T> &list, int startIndex = 0);
+
+        void writeList(vector<XVariable *> &list);
+
+        void writeList(vector<Tree *> &list);
+
+        void writeList(vector<int> &list);
+
+        void writeIds(vector<string> &ids);
+
+        template<class T>
+        void writeMatrix(const char *tag, vector<vector<T> > &matrix, const char *attributes = "");
+
+        void writeValue(XVariable *x);
+
+        void writeValue(Tree *tree);
+
+        void writeValue(int value);
+
+        void writeRanges(vector<int> &values);
+
+        void writeCondition(XCondition &xc);
+
+        void writeOperator(OrderType op);
+
+        void writeIndex(XVariable *index, RankType rank);
+
+        void writeCardinalityValues(bool closed);
+
+        void writeAutomaton(XAutomaton &automaton);
+
+        template<class T>
+        void writeObjective(bool minimize, ExpressionObjective type, vector<T> &list);
+    };
+}
+
+#endif /* XCSP3WRITERCALLBACKS_H */
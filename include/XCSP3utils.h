@@ -34,6 +34,7 @@
 #include <cctype>
 #include <locale>
 #include <cwctype>
+#include "XCSP3Constants.h"
 
 namespace XCSP3Core {
     std::vector<std::string> &split(const std::string &s, char delim, std::vector<std::string> &elems);
@@ -65,6 +66,21 @@ namespace XCSP3Core {
     std::string &trim(std::string &s);
 
 
+// parse [+-]?[0-9]+ (the whole range) into value. Return false, without exception, if it is not an int
+    bool parseInteger(const char *begin, const char *end, int &value);
+
+
+// same, surrounding spaces are ignored
+    bool parseInteger(const std::string &s, int &value);
+
+
+// classify a token of a list by looking at its bytes, no exception is thrown:
+//  TOKEN_INTEGER (first = the value), TOKEN_STAR, TOKEN_RANGE (first..second),
+//  TOKEN_COMPACT (first, or STAR, repeated second times: 0x5, *x3), TOKEN_ARRAY (x[2][]), TOKEN_PARAMETER (%1, %...),
+//  TOKEN_TREE (add(x,y)), TOKEN_SET ({1,2}), TOKEN_VARIABLE otherwise
+    TokenKind classifyToken(const std::string &token, int &first, int &second);
+
+
 }
 
 #endif	/* UTILS_H */
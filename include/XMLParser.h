@@ -51,6 +51,7 @@
 #include "XCSP3utils.h"
 #include "XCSP3Objective.h"
 #include "XCSP3Manager.h"
+#include "XCSP3Arena.h"
 
 #include "UTF8String.h"
 #include "AttributeList.h"
@@ -138,6 +139,12 @@ namespace XCSP3Core {
             virtual void endTag() { }
 
 
+            /**
+             * Free what beginTag allocated, when the parsing is stopped before endTag
+             */
+            virtual void abort() { }
+
+
         protected :
             /**
              * check that the parent tag in the XML file has the indicated name
@@ -176,11 +183,12 @@ namespace XCSP3Core {
 
         struct State {
             bool subtagAllowed;
+            bool begun;             // beginTag was done
 
 
             State() {
                 subtagAllowed = true;
-
+                begun = false;
             }
 
         };
@@ -211,6 +219,8 @@ namespace XCSP3Core {
 
         vector<int> currentTuple;
         ListTagAction *listTag;       // The List tag action call
+        TagAction *groupTag;          // The group and slide tag actions (a constraint looks for them in its parents)
+        TagAction *slideTag;
 
         string classes;
 
@@ -229,14 +239,23 @@ namespace XCSP3Core {
         OrderType op;
         string expr;
         string start, final;        // used in regular constraint
-        vector<XTransition> transitions; // used in regular and mdd constraints
+        XAutomaton automaton;       // used in regular and mdd constraints
         int nbParameters;
         bool closed;
         vector<XEntity *> toFree;
-        vector<XIntegerEntity *> toFreeEntity;
+        XArena constraintArena;     // integers, trees... of the current constraint (or group), reset in BasicConstraintTagAction::beginTag
+        XArena documentArena;       // objects that must live until the end of the parsing
 
         bool keepIntervals;
 
+        // Skipped text (see XCSP3CoreCallbacks::skip)
+        bool skipText;              // the text of the current tag is only counted (tuples)
+        int skipDepth;              // > 0 inside a skipped section, this is the depth from the section tag
+        int skippedLevel;           // depth of the skipped constraint that is reported, 0 if none
+        size_t skippedBytes;
+        string skippedId, skippedType;
+        int discardedDepth;         // > 0 inside a constraint, group or block with a discarded class (see addClassToDiscard)
+
         void registerTagAction(TagActionList &tagList, TagAction *action) {
             tagList[action->getTagName()] = action;
         }
@@ -375,6 +394,8 @@ namespace XCSP3Core {
             virtual void beginTag(const AttributeList &) {
                 this->checkParentTag("instance");
                 this->parser->manager->beginConstraints();
+                if(this->parser->manager->callback->skip & SKIP_CONSTRAINTS)
+                    this->parser->skipDepth = 1;
             }
 
 
@@ -403,6 +424,7 @@ namespace XCSP3Core {
         class ExtensionTagAction : public BasicConstraintTagAction {
         public:
             XConstraintExtension *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             ExtensionTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -416,6 +438,7 @@ namespace XCSP3Core {
             UTF8String fnc;
         public:
             XConstraintIntension *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             IntensionTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void text(const UTF8String txt, bool last) override;
@@ -436,6 +459,7 @@ namespace XCSP3Core {
         class RegularTagAction : public BasicConstraintTagAction {
         public:
             XConstraintRegular *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             RegularTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -448,6 +472,7 @@ namespace XCSP3Core {
         class MDDTagAction : public BasicConstraintTagAction {
         public:
             XConstraintMDD *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             MDDTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -473,6 +498,7 @@ namespace XCSP3Core {
             XConstraintAllDiff *alldiff;
             XConstraintAllEqual *allequal;
             XConstraint *ct;
+            void abort() override { if(group == nullptr || group->constraint != ct) delete ct; }
             AllDiffEqualTagAction(XMLParser *parser, string tag) : BasicConstraintTagAction(parser, tag) { }
             void beginTag(const AttributeList &attributes) override;
             void text(const UTF8String txt, bool last) override;
@@ -485,6 +511,7 @@ namespace XCSP3Core {
         class OrderedTagAction : public BasicConstraintTagAction {
         public:
             XConstraintOrdered *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             OrderedTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void text(const UTF8String txt, bool last) override;
@@ -497,6 +524,7 @@ namespace XCSP3Core {
         class LexTagAction : public BasicConstraintTagAction {
         public:
             XConstraintLex *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             LexTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -517,6 +545,7 @@ namespace XCSP3Core {
         class SumTagAction : public BasicConstraintTagAction {
         public:
             XConstraintSum *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             SumTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -528,6 +557,7 @@ namespace XCSP3Core {
         class NValuesTagAction : public BasicConstraintTagAction {
         public:
             XConstraintNValues *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             NValuesTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -540,6 +570,7 @@ namespace XCSP3Core {
         class CountTagAction : public BasicConstraintTagAction {
         public:
             XConstraintCount *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             CountTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -552,6 +583,7 @@ namespace XCSP3Core {
         class CardinalityTagAction : public BasicConstraintTagAction {
         public:
             XConstraintCardinality *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             CardinalityTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -570,6 +602,7 @@ namespace XCSP3Core {
         class ChannelTagAction : public BasicConstraintTagAction {
         public:
             XConstraintChannel *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             ChannelTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void text(const UTF8String txt, bool last) override;
@@ -583,6 +616,7 @@ namespace XCSP3Core {
         class ElementTagAction : public BasicConstraintTagAction {
         public:
             XConstraintElement *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             ElementTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -597,6 +631,7 @@ namespace XCSP3Core {
 
         public:
             XConstraintMaximum *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             MinMaxTagAction(XMLParser *parser, string tag) : BasicConstraintTagAction(parser, tag) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -617,6 +652,7 @@ namespace XCSP3Core {
         class StretchTagAction : public BasicConstraintTagAction {
         public:
             XConstraintStretch *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             StretchTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -631,6 +667,7 @@ namespace XCSP3Core {
         public:
             bool diffn;
             XConstraintNoOverlap *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             NoOverlapTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -643,6 +680,7 @@ namespace XCSP3Core {
         class CumulativeTagAction : public BasicConstraintTagAction {
         public:
             XConstraintCumulative *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             CumulativeTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -655,6 +693,7 @@ namespace XCSP3Core {
         class BinPackingTagAction : public BasicConstraintTagAction {
         public:
             XConstraintBinPacking *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             BinPackingTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
@@ -671,6 +710,7 @@ namespace XCSP3Core {
             ObjectivesTagAction(XMLParser *parser, string name) : TagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
+            void abort() override { delete objective; }
         };
 
 
@@ -689,6 +729,7 @@ namespace XCSP3Core {
         public:
             InstantiationTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             XConstraintInstantiation *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
         };
@@ -702,6 +743,7 @@ namespace XCSP3Core {
         public:
             ClauseTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             XConstraintClause *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
             void beginTag(const AttributeList &attributes) override;
             void text(const UTF8String txt, bool last) override;
             void endTag() override;
@@ -735,6 +777,7 @@ namespace XCSP3Core {
             ConflictOrSupportTagAction(XMLParser *parser, string name) : TagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void text(const UTF8String txt, bool last) override;
+            void endTag() override;
         };
 
 
@@ -874,6 +917,7 @@ namespace XCSP3Core {
             GroupTagAction(XMLParser *parser, string name) : TagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
+            void abort() override { delete group; }
         };
 
         /***************************************************************************
@@ -892,6 +936,7 @@ namespace XCSP3Core {
             SlideTagAction(XMLParser *parser, string name) : TagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
+            void abort() override { delete group; }
         };
 
         /***************************************************************************
@@ -903,6 +948,7 @@ namespace XCSP3Core {
             BlockTagAction(XMLParser *parser, string name) : TagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void endTag() override;
+            void abort() override { classes.pop_back(); }
         };
 
 
@@ -970,10 +1016,9 @@ namespace XCSP3Core {
          ****************************************************************************/
 
         class TransitionsTagAction : public TagAction {
-            UTF8String transitions;
+            string buffer, token;   // reused between chunks
         public:
-            int nb, val;
-            std::string from, to;
+            int nb, from, val;      // nb = -1 : outside a transition, nb = 0 : from, nb = 1 : val, nb = 2 : to
             TransitionsTagAction(XMLParser *parser, string name) : TagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
             void text(const UTF8String txt, bool last) override;
@@ -997,6 +1042,7 @@ namespace XCSP3Core {
 
         class CircuitTagAction : public BasicConstraintTagAction {
             XConstraintCircuit *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
         public :
             CircuitTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
@@ -1011,6 +1057,7 @@ namespace XCSP3Core {
 
         class PrecedenceTagAction : public BasicConstraintTagAction {
             XConstraintPrecedence *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
         public:
             PrecedenceTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
@@ -1024,6 +1071,7 @@ namespace XCSP3Core {
 
         class FlowTagAction : public BasicConstraintTagAction {
             XConstraintFlow *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
         public:
             FlowTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
@@ -1036,6 +1084,7 @@ namespace XCSP3Core {
 
         class KnapsackTagAction : public BasicConstraintTagAction {
             XConstraintKnapsack *constraint;
+            void abort() override { if(group == nullptr || group->constraint != constraint) delete constraint; }
         public:
             KnapsackTagAction(XMLParser *parser, string name) : BasicConstraintTagAction(parser, name) { }
             void beginTag(const AttributeList &attributes) override;
@@ -1103,13 +1152,27 @@ namespace XCSP3Core {
         void characters(UTF8String chars);
 
 
+        void asciiCharacters(UTF8String chars); // characters, when chars is pure ASCII
+
+
         void handleAbridgedNotation(UTF8String chars, bool lastChunk);
 
 
+        /**
+         * The parsing was stopped: free the objects of the tags that are not ended and
+         * reset the state, so that another document can be parsed
+         */
+        void abort();
+
+
 
     protected:
         void clearStacks() {
             stateStack.clear();
+            actionStack.clear();
+            textLeft.clear();
+            skipText = false;
+            skipDepth = skippedLevel = discardedDepth = 0;
         }
 
         // text which is left for the next call to characters() because it
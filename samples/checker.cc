@@ -0,0 +1,53 @@
+#include "XCSP3CoreParser.h"
+#include "XCSP3SolutionChecker.h"
+#include <fstream>
+#include <sstream>
+
+using namespace XCSP3Core;
+
+// Check a solution (an <instantiation> element) against an instance
+// exit code: 0 the solution is valid, 1 it is not, 2 an error occurred
+
+int main(int argc, char **argv) {
+    if(argc != 2 && argc != 3) {
+        cerr << "usage: ./xcsp3checker instance.xml [solution.xml]  (the solution is read on stdin if missing)" << endl;
+        return 2;
+    }
+    try {
+        XCSP3SolutionChecker checker;
+        XCSP3CoreParser parser(&checker);
+        parser.parse(argv[1]);
+
+        std::stringstream solution;
+        if(argc == 3) {
+            std::ifstream file(argv[2]);
+            if(!file)
+                throw runtime_error(string("unable to open ") + argv[2]);
+            solution << file.rdbuf();
+        } else
+            solution << std::cin.rdbuf();
+
+        vector<int> assignment, wrong;
+        checker.parseInstantiation(solution.str(), assignment);
+        bool valid = true;
+        checker.checkDomains(assignment, wrong);
+        for(int x : wrong) {
+            cout << "value out of domain: " << checker.variableId(x) << endl;
+            valid = false;
+        }
+        if(checker.check(assignment, wrong) == false) {
+            for(int c : wrong)
+                cout << "violated constraint: #" << c << " " << checker.constraintId(c) << endl;
+            valid = false;
+        }
+        if(valid && checker.hasObjective())
+            cout << "objective (" << (checker.isMinimization() ? "minimize" : "maximize") << "): " << checker.objectiveValue(assignment) << endl;
+        cout << (valid ? "valid" : "invalid") << endl;
+        return valid ? 0 : 1;
+    } catch(exception &e) {
+        cout.flush();
+        cerr << "\n\tUnexpected exception :\n";
+        cerr << "\t" << e.what() << endl;
+        return 2;
+    }
+}
@@ -0,0 +1,31 @@
+#include "XCSP3CoreParser.h"
+#include "XCSP3WriterCallbacks.h"
+#include <fstream>
+
+using namespace XCSP3Core;
+
+// Parse an instance and write it back (compact form) on the standard output or in a file
+
+int main(int argc, char **argv) {
+    if(argc != 2 && argc != 3) {
+        cerr << "usage: ./xcsp3rewrite instance.xml [output.xml]" << endl;
+        return 1;
+    }
+    try {
+        std::ofstream file;
+        if(argc == 3) {
+            file.open(argv[2]);
+            if(!file)
+                throw runtime_error(string("unable to open ") + argv[2]);
+        }
+        XCSP3WriterCallbacks writer(argc == 3 ? file : std::cout);
+        XCSP3CoreParser parser(&writer);
+        parser.parse(argv[1]);
+    } catch(exception &e) {
+        cout.flush();
+        cerr << "\n\tUnexpected exception :\n";
+        cerr << "\t" << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
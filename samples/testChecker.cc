@@ -0,0 +1,109 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+
+#include "XCSP3CoreParser.h"
+#include "XCSP3SolutionChecker.h"
+#include <climits>
+#include <sstream>
+
+using namespace XCSP3Core;
+using namespace std;
+
+// Verdicts of the checker on undefined expressions (division by zero, negative exponent, overflow)
+// Domains are not checked by check and checkBatch: values outside 0..10 are used
+
+class CheckerTest {
+public :
+    string expression;  // intension over x and y
+    int x, y;
+    bool expected;
+
+    CheckerTest(string e, int a, int b, bool v) : expression(e), x(a), y(b), expected(v) {}
+};
+
+
+static string instance(const string &expression) {
+    return "<instance format=\"XCSP3\" type=\"CSP\"> <variables>"
+           " <var id=\"x\"> 0..10 </var> <var id=\"y\"> 0..10 </var> </variables>"
+           " <constraints> <intension> " + expression + " </intension> </constraints> </instance>";
+}
+
+
+int main(int argc, char **argv) {
+    int nbFailed = 0;
+    int nbSuccess = 0;
+    std::vector<CheckerTest> allTests;
+
+    allTests.push_back(CheckerTest("eq(div(x,y),0)", 5, 0, false));
+    allTests.push_back(CheckerTest("ne(div(x,y),1)", 5, 0, false));
+    allTests.push_back(CheckerTest("eq(div(x,y),2)", 5, 2, true));
+    allTests.push_back(CheckerTest("eq(mod(x,y),0)", 5, 0, false));
+    allTests.push_back(CheckerTest("ne(mod(x,y),3)", 5, 0, false));
+    allTests.push_back(CheckerTest("eq(mod(x,y),1)", 5, 2, true));
+    allTests.push_back(CheckerTest("eq(mod(x,y),0)", INT_MIN, -1, true));
+    allTests.push_back(CheckerTest("eq(pow(x,y),1)", 2, -1, false));
+    allTests.push_back(CheckerTest("eq(pow(x,y),0)", 2, -1, false));
+    allTests.push_back(CheckerTest("eq(pow(x,y),1)", 0, 0, true));
+    allTests.push_back(CheckerTest("eq(pow(x,y),-1)", -1, INT_MAX, true));
+    allTests.push_back(CheckerTest("eq(pow(x,y),1024)", 2, 10, true));
+    allTests.push_back(CheckerTest("gt(pow(x,y),0)", 2, 64, false));
+    allTests.push_back(CheckerTest("gt(mul(x,y),0)", 65536, 65536, true));            // fits in long long
+    allTests.push_back(CheckerTest("eq(div(mul(x,y),y),x)", INT_MAX, INT_MAX, true));
+    allTests.push_back(CheckerTest("gt(mul(x,x,y,y,x),0)", INT_MAX, INT_MAX, false)); // long long overflow
+    allTests.push_back(CheckerTest("gt(add(x,y),0)", INT_MAX, 1, true));              // 2^31 fits in long long
+    allTests.push_back(CheckerTest("lt(sqr(x),0)", INT_MIN, 0, false));
+    allTests.push_back(CheckerTest("eq(neg(x),x)", INT_MIN, 0, false));
+    allTests.push_back(CheckerTest("or(eq(y,0),eq(div(x,y),1))", 5, 0, false));  // all operands are evaluated
+
+    int nb = 0;
+    for(CheckerTest &test : allTests) {
+        XCSP3SolutionChecker checker;
+        XCSP3CoreParser parser(&checker);
+        istringstream in(instance(test.expression));
+        parser.parse(in);
+        vector<int> assignment = {test.x, test.y}, violated;
+        bool single = checker.check(assignment, violated);
+
+        // The same assignment in a batch, with a defined row before and after it
+        vector<int> assignments = {1, 1, test.x, test.y, 1, 1};
+        vector<char> feasible;
+        vector<long long> objectives;
+        checker.checkBatch(assignments, feasible, objectives);
+        bool batch = feasible[1];
+
+        nb++;
+        if(single != test.expected || batch != test.expected) {
+            nbFailed++;
+            std::cout << "Probleme: number " << nb << std::endl;
+            std::cout << "  Expression: " << test.expression << " with x=" << test.x << " y=" << test.y << std::endl;
+            std::cout << "    Expected: " << test.expected << " check: " << single << " checkBatch: " << batch << std::endl;
+            std::cout << "--" << std::endl;
+        } else
+            nbSuccess++;
+    }
+
+    std::cout << allTests.size() << " tests: " << nbFailed << " failed " << nbSuccess << " success\n";
+    return nbFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+#include "XCSP3CoreParser.h"
+#include <map>
+
+using namespace XCSP3Core;
+
+// Quick summary of an instance: the constraints and the objectives are skipped (see XCSP3CoreCallbacks::skip),
+// only the variables are parsed.
+
+class TriageCallbacks : public XCSP3CoreCallbacks {
+public :
+    long nbVariables = 0;
+    bool objectives = false;
+    InstanceType type = CSP;
+    std::map<string, long> constraints;   // number of constraints by tag
+    std::map<string, size_t> bytes;       // length of their text by tag
+
+
+    TriageCallbacks() {
+        skip = SKIP_CONSTRAINTS | SKIP_OBJECTIVES;
+    }
+
+
+    void beginInstance(InstanceType t) override { type = t; }
+
+
+    void beginObjectives() override { objectives = true; }
+
+
+    void buildVariableInteger(string, int, int) override { nbVariables++; }
+
+
+    void buildVariableInteger(string, vector<int> &) override { nbVariables++; }
+
+
+    void skippedConstraint(string, string tag, int, size_t length) override {
+        constraints[tag]++;
+        bytes[tag] += length;
+    }
+};
+
+
+int main(int argc, char **argv) {
+    if(argc != 2) {
+        cerr << "usage: ./xcsp3triage instance.xml" << endl;
+        return 1;
+    }
+    try {
+        TriageCallbacks cb;
+        XCSP3CoreParser parser(&cb);
+        parser.parse(argv[1]);
+        cout << "type: " << (cb.type == COP ? "COP" : "CSP") << endl;
+        cout << "variables: " << cb.nbVariables << endl;
+        cout << "objective: " << (cb.objectives ? "yes" : "no") << endl;
+        for(auto &c : cb.constraints)
+            cout << c.first << ": " << c.second << " (" << cb.bytes[c.first] << " bytes)" << endl;
+    } catch(exception &e) {
+        cout.flush();
+        cerr << "\n\tUnexpected exception :\n";
+        cerr << "\t" << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -25,6 +25,8 @@
  */
 
 #include "UTF8String.h"
+#include <cstdint>
+#include <cstring>
 
 using namespace XCSP3Core;
 
@@ -142,6 +144,24 @@ bool UTF8String::isWhiteSpace() const {
 }
 
 
+bool UTF8String::isAscii() const {
+    if(_beg == NULL)
+        return true;
+    const Byte *p = _beg, *e = _beg + byteLength();
+    // 8 bytes at a time: one of them has its high bit set
+    for(; p + 8 <= e ; p += 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        if(word & 0x8080808080808080ULL)
+            return false;
+    }
+    for(; p != e ; ++p)
+        if(*p >= 0x80)
+            return false;
+    return true;
+}
+
+
 int UTF8String::firstChar() const {
     return *iterator(_beg);
 }
@@ -242,6 +262,38 @@ bool UTF8String::to(string &v) const {
 
 
 bool UTF8String::to(int &v) const {
+    if(isAscii()) { // the same, with bytes
+        const Byte *p = _beg, *e = _end;
+        bool neg = false;
+
+        while(p != e && isSpace(*p))
+            ++p;
+
+        if(p == e || *p == 0) // end of string?
+            return false;
+
+        if(*p == '+')
+            ++p;
+        else if(*p == '-') {
+            ++p;
+            neg = true;
+        }
+
+        v = 0;
+        while(p != e && *p >= '0' && *p <= '9') {
+            v = v * 10 + (*p - '0');
+            ++p;
+        }
+
+        if(neg)
+            v = -v;
+
+        while(p != e && isSpace(*p))
+            ++p;
+
+        return p == e || *p == 0;
+    }
+
     iterator it(_beg), end(_end);
     bool neg = false;
 
@@ -338,14 +390,15 @@ UTF8String::iterator::iterator(const iterator & o) : p(o.p) {
 }
 
 int UTF8String::iterator::operator*() {
-    int ch = *p;
+    const Byte *q = p;
+    int ch = *q;
 
     switch(codeLength(ch)) {
         case 1:
             return ch;
         case 2:
             ch &= 0x1F;
-            addNextByte(ch);
+            addNextByte(q, ch);
             return ch;
         case 3:
             if((ch == 0xE0 && p[1] < 0xA0)
@@ -353,8 +406,8 @@ int UTF8String::iterator::operator*() {
                 throw runtime_error("invalid UTF8 character");
 
             ch &= 0x0F;
-            addNextByte(ch);
-            addNextByte(ch);
+            addNextByte(q, ch);
+            addNextByte(q, ch);
             return ch;
         case 4:
             if((ch == 0xF0 && p[1] < 0x90)
@@ -362,9 +415,9 @@ int UTF8String::iterator::operator*() {
                 throw runtime_error("invalid UTF8 character");
 
             ch &= 0x07;
-            addNextByte(ch);
-            addNextByte(ch);
-            addNextByte(ch);
+            addNextByte(q, ch);
+            addNextByte(q, ch);
+            addNextByte(q, ch);
             return ch;
         default:
             throw runtime_error("internal bug");
@@ -436,7 +489,9 @@ Byte UTF8String::iterator::firstByte() const {
 }
 
 //------------------------ ITERATOR INTERN CLASS ------------------------
-UTF8String::Tokenizer::Tokenizer(const UTF8String s) : it(s._beg), end(s._end) {
+UTF8String::Tokenizer::Tokenizer(const UTF8String s) : it(s._beg), end(s._end), ascii(s.isAscii()) {
+    for(int i = 0; i < 128; i++)
+        asciiSeparator[i] = false;
     skipWhiteSpace();
 }
 
@@ -446,10 +501,14 @@ UTF8String::Tokenizer::Tokenizer(const UTF8String s) : it(s._beg), end(s._end) {
  */
 void UTF8String::Tokenizer::addSeparator(int ch) {
     separators.push_back(ch);
+    if(ch >= 0 && ch < 128)
+        asciiSeparator[ch] = true;
 }
 
 
 bool UTF8String::Tokenizer::hasMoreTokens() {
+    if(ascii)
+        return it != end && it.firstByte();
     return it != end && *it;
 }
 
@@ -460,6 +519,19 @@ UTF8String UTF8String::Tokenizer::nextToken() {
     if(it == end || it.firstByte() == 0)
         return UTF8String();
 
+    if(ascii) {
+        const Byte *stop = end.getPointer();
+        e = b;
+        if(asciiSeparator[*e])
+            ++e;
+        else
+            while(e != stop && *e && !isSpace(*e) && !asciiSeparator[*e])
+                ++e;
+        it = iterator(e);
+        skipWhiteSpace();
+        return UTF8String(b, e);
+    }
+
     if(isSeparator(*it))
         ++it;
     else
@@ -26,6 +26,7 @@
 
 // definition of different functions coming from XCSP3Constraint, XCSPVariables, XCS3Domain
 #include <assert.h>
+#include <algorithm>
 #include <XCSP3Tree.h>
 #include "XCSP3Domain.h"
 #include "XCSP3Variable.h"
@@ -36,9 +37,6 @@ using namespace XCSP3Core;
 
 namespace XCSP3Core {
 // Special global vars...
- vector<XTransition> tr; // Not beautiful but remove code to fixed data in group constraint.
- string st;
- vector<string> fi;
  vector<int> ___except;
  OrderType _op;
  vector<int> _values;
@@ -56,8 +54,12 @@ namespace XCSP3Core {
 
 
     ostream &operator<<(ostream &f, const XDomainInteger &d) {
-        for(XIntegerEntity *xi : d.values)
-            f << *xi;
+        for(int i = 0; i < d.nbRuns(); i++) {
+            if(d.runMinimum(i) == d.runMaximum(i))
+                f << d.runMinimum(i) << " ";
+            else
+                f << d.runMinimum(i) << ".." << d.runMaximum(i) << " ";
+        }
         return f;
     }
 }
@@ -66,13 +68,13 @@ namespace XCSP3Core {
 //  XCSP3Variable.h functions
 //------------------------------------------------------------------------------------------
 
-XEntity::XEntity() : id("") {}
+XEntity::XEntity() : id(""), kind(VARIABLE_E) {}
 
 
 XEntity::~XEntity() {}
 
 
-XEntity::XEntity(std::string lid) { id = lid; }
+XEntity::XEntity(std::string lid) : kind(VARIABLE_E) { id = lid; }
 
 
 XVariable::XVariable(std::string idd, XDomainInteger *dom) : XEntity(idd), domain(dom) {}
@@ -94,7 +96,26 @@ XVariable::XVariable(std::string idd, XDomainInteger *dom, std::vector<int> inde
 XVariable::~XVariable() {}
 
 
+static const int internedMin = -128;
+static const int internedMax = 1023;
+
+XInteger *XInteger::constant(int n) {
+    if(n < internedMin || n > internedMax)
+        return nullptr;
+    // Built once (thread safe initialization), never modified after
+    static std::vector<XInteger> interned = [] {
+        std::vector<XInteger> v;
+        v.reserve(internedMax - internedMin + 1);
+        for(int i = internedMin ; i <= internedMax ; i++)
+            v.emplace_back(std::to_string(i), i);
+        return v;
+    }();
+    return &interned[n - internedMin];
+}
+
+
 XParameterVariable::XParameterVariable(std::string lid) : XVariable(lid, NULL) {
+    kind = PARAMETER_E;
     if(id[1] == '.')
         number = -1;
     else
@@ -118,43 +139,8 @@ namespace XCSP3Core {
 }
 
 
-// Check if a XEntity is an integer
-// If yes, the value is set to its integer
-bool XCSP3Core::isInteger(XEntity *xe, int &value) {
-    XInteger *xi;
-    if((xi = dynamic_cast<XInteger *>(xe)) != NULL) {
-        value = xi->value;
-        return true;
-    }
-    return false;
-}
-
-
-// Check if a XEntity is an integer
-// If yes, the value is set to its integer
-bool XCSP3Core::isInterval(XEntity *xe, int &min, int &max) {
-    XEInterval *xi;
-    if((xi = dynamic_cast<XEInterval *>(xe)) != NULL) {
-        min = xi->min;
-        max = xi->max;
-        return true;
-    }
-    return false;
-}
-
-
-bool XCSP3Core::isVariable(XEntity *xe, XVariable *&v) {
-    XVariable *x;
-    if((x = dynamic_cast<XVariable *>(xe)) != NULL) {
-        v = x;
-        return true;
-    }
-    return false;
-
-}
-
-
 XVariableArray::XVariableArray(std::string id, std::vector<int> szs) : XEntity(id), sizes(szs.begin(), szs.end()) {
+    kind = ARRAY_E;
     int nb = 1;
     for(int sz : sizes)
         nb *= sz;
@@ -163,6 +149,7 @@ XVariableArray::XVariableArray(std::string id, std::vector<int> szs) : XEntity(i
 
 
 XVariableArray::XVariableArray(std::string idd, XVariableArray *as) : sizes(as->sizes.begin(), as->sizes.end()) {
+    kind = ARRAY_E;
     std::vector<int> indexes;
     indexes.assign(as->sizes.size(), 0);
     variables.assign(as->variables.size(), NULL);
@@ -204,45 +191,99 @@ bool XVariableArray::incrementIndexes(vector<int> &indexes, vector<XIntegerEntit
 }
 
 
-void XVariableArray::getVarsFor(vector<XVariable *> &list, string compactForm, vector<int> *flatIndexes, bool storeIndexes) {
-    vector<XIntegerEntity *> ranges;
-    string tmp;
+// Read a non negative integer, return the first char after it
+static const char *readIndex(const char *s, const char *end, int &value) {
+    if(s == end || *s < '0' || *s > '9')
+        throw runtime_error("Integer expected in compact form");
+    value = 0;
+    for(; s != end && *s >= '0' && *s <= '9' ; s++)
+        value = value * 10 + (*s - '0');
+    return s;
+}
+
+
+template<class T>
+static void reserveGeometric(vector<T> &v, size_t count) {
+    if(v.size() + count > v.capacity())
+        v.reserve(std::max(v.size() + count, 2 * v.capacity()));
+}
+
+
+void XVariableArray::getVarsFor(vector<XVariable *> &list, const char *compactForm, size_t length, vector<int> *flatIndexes, bool storeIndexes) {
+    const size_t nbDims = sizes.size();
+    // first, last, current index and stride for each dimension
+    int local[4 * 8];
+    vector<int> large;
+    int *first = local;
+    if(nbDims > 8) {
+        large.resize(4 * nbDims);
+        first = large.data();
+    }
+    int *last = first + nbDims, *current = last + nbDims, *stride = current + nbDims;
+
     // Compute the different ranges for all dimension
-    for(unsigned int i = 0 ; i < sizes.size() ; i++) {
-        string::size_type pos = compactForm.find(']');
-        tmp = compactForm.substr(1, pos - 1);
-        compactForm = compactForm.substr(pos + 1);
-        if(tmp.size() == 0) {
-            ranges.push_back(new XIntegerInterval(0, sizes[i] - 1));
+    const char *s = compactForm, *end = compactForm + length;
+    size_t count = 1;
+    for(size_t i = 0 ; i < nbDims ; i++) {
+        if(s == end || *s != '[')
+            throw runtime_error("Bad compact form: " + string(compactForm, length));
+        s++;
+        if(s != end && *s == ']') {
+            first[i] = 0;
+            last[i] = sizes[i] - 1;
         } else {
-            string::size_type dot = tmp.find("..");
-            if(dot == string::npos)
-                ranges.push_back(new XIntegerValue(std::stoi(tmp)));
-            else {
-                int first = std::stoi(tmp.substr(0, dot));
-                int last = std::stoi(tmp.substr(dot + 2));
-                ranges.push_back(new XIntegerInterval(first, last));
+            s = readIndex(s, end, first[i]);
+            last[i] = first[i];
+            if(s != end && *s == '.') {
+                if(++s == end || *s != '.')
+                    throw runtime_error("Bad compact form: " + string(compactForm, length));
+                s = readIndex(s + 1, end, last[i]);
             }
         }
+        if(s == end || *s != ']')
+            throw runtime_error("Bad compact form: " + string(compactForm, length));
+        s++;
+        if(last[i] >= sizes[i] || first[i] > last[i])
+            throw runtime_error("Index out of bounds: " + string(compactForm, length));
+        count *= last[i] - first[i] + 1;
     }
-    // Compute the first one
-    vector<int> indexes;
-    for(unsigned int i = 0 ; i < sizes.size() ; i++)
-        indexes.push_back(ranges[i]->minimum());
 
-    // Compute all necessary variables
-    do {
-        if(storeIndexes)
-            flatIndexes->push_back(flatIndexFor(indexes));
-        else {
-            if(variables[flatIndexFor(indexes)] != nullptr)
-                list.push_back(variables[flatIndexFor(indexes)]);
-        }
-    } while(incrementIndexes(indexes, ranges));
+    int flat = 0;
+    for(int i = static_cast<int>(nbDims) - 1, nb = 1 ; i >= 0 ; i--) {
+        stride[i] = nb;
+        nb *= sizes[i];
+        current[i] = first[i];
+        flat += first[i] * stride[i];
+    }
 
-    for(XIntegerEntity *xi : ranges)
-        delete xi;
+    // The list is shared by the whole sequence: an exact reserve per compact form would copy it for each token
+    if(count > 1) {
+        if(storeIndexes)
+            reserveGeometric(*flatIndexes, count);
+        else
+            reserveGeometric(list, count);
+    }
 
+    // Compute all necessary variables (odometer over the ranges, last dimension first)
+    while(true) {
+        if(storeIndexes)
+            flatIndexes->push_back(flat);
+        else if(variables[flat] != nullptr)
+            list.push_back(variables[flat]);
+
+        int j = static_cast<int>(nbDims) - 1;
+        for(; j >= 0 ; j--) {
+            if(current[j] < last[j]) {
+                current[j]++;
+                flat += stride[j];
+                break;
+            }
+            flat -= (current[j] - first[j]) * stride[j];
+            current[j] = first[j];
+        }
+        if(j < 0)
+            break;
+    }
 }
 
 
@@ -262,7 +303,7 @@ void XVariableArray::buildVarsWith(XDomainInteger *domain) {
 }
 
 
-int XVariableArray::flatIndexFor(vector<int> indexes) {
+int XVariableArray::flatIndexFor(const vector<int> &indexes) {
     int sum = 0;
     for(int i = static_cast<int>(indexes.size()) - 1, nb = 1; i >= 0 ; i--) {
         sum += indexes[i] * nb;
@@ -287,12 +328,35 @@ ostream &operator<<(ostream &O, const XInterval &it) {
 
 
 
-void XConstraint::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraint::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     group->unfoldVector(list, arguments, original->list);
 }
 
 
-void XConstraintGroup::unfoldVector(vector<XVariable *> &toUnfold, vector<XVariable *> &args, vector<XVariable *> &initial) {
+void XArguments::setSlide(const vector<XVariable *> &list, size_t arity, size_t offset, bool circular) {
+    cells.assign(list.begin(), list.end());
+    width = arity;
+    step = offset;
+    // Same rows as before: the last one of a circular slide wraps around the list
+    size_t end = list.size() + (circular ? 2 : 1);
+    nbRows = end > arity && list.empty() == false ? (end - arity + offset - 1) / offset : 0;
+    if(circular)
+        for(size_t j = 0 ; j + 1 < arity ; j++)
+            cells.push_back(list[j % list.size()]);
+}
+
+
+vector<vector<XVariable *> > &XArguments::toVectors() {
+    std::call_once(copiedOnce, [this] {
+        copied.reserve(nbRows);
+        for(size_t i = 0 ; i < nbRows ; i++)
+            copied.push_back((*this)[i].toVector());
+    });
+    return copied;
+}
+
+
+void XConstraintGroup::unfoldVector(vector<XVariable *> &toUnfold, XSpan<XVariable *> args, vector<XVariable *> &initial) {
     XParameterVariable *xp;
     if(initial.size() == 0)
         return;
@@ -311,7 +375,7 @@ void XConstraintGroup::unfoldVector(vector<XVariable *> &toUnfold, vector<XVaria
 }
 
 
-void XConstraintGroup::unfoldString(string &toUnfold, vector<XVariable *> &args) {
+void XConstraintGroup::unfoldString(string &toUnfold, XSpan<XVariable *> args) {
     for(int i = static_cast<int>(args.size()) - 1 ; i >= 0 ; i--) {
         string param = "%" + std::to_string(i);
         ReplaceStringInPlace(toUnfold, param, args[i]->id);
@@ -351,7 +415,7 @@ namespace XCSP3Core {
 }
 
 
-void XInitialCondition::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XInitialCondition::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XInitialCondition *xi = dynamic_cast<XInitialCondition *>(original);
     condition = xi->condition;
     group->unfoldString(condition, arguments);
@@ -405,23 +469,22 @@ void XInitialCondition::extract(XCondition &xc, string &condition) { // Create t
             xc.set.push_back(std::stoi((*i).str()));
         return;
     }
-    try {
-        xc.val = stoi(tmp1);
+    if(parseInteger(tmp1, xc.val))
         xc.operandType = INTEGER;
-    } catch(const invalid_argument &) {
+    else {
         xc.var = tmp1;
         xc.operandType = VARIABLE;
     }
 }
 
 
-void XValues::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XValues::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XValues *xv = dynamic_cast<XValues *>(original);
     group->unfoldVector(values, arguments, xv->values);
 }
 
 
-void XValue::unfoldParameters(XConstraintGroup *, vector<XVariable *> &arguments, XConstraint *original) {
+void XValue::unfoldParameters(XConstraintGroup *, XSpan<XVariable *> arguments, XConstraint *original) {
     XParameterVariable *xp;
     XValue *xv = dynamic_cast<XValue *>(original);
     if((xp = dynamic_cast<XParameterVariable *>(xv->value)) == NULL) {
@@ -431,7 +494,7 @@ void XValue::unfoldParameters(XConstraintGroup *, vector<XVariable *> &arguments
 }
 
 
-void XIndex::unfoldParameters(XConstraintGroup *, vector<XVariable *> &arguments, XConstraint *original) {
+void XIndex::unfoldParameters(XConstraintGroup *, XSpan<XVariable *> arguments, XConstraint *original) {
     XParameterVariable *xp;
     XIndex *xi = dynamic_cast<XIndex *>(original);
     if(xi->index == NULL) return;
@@ -442,13 +505,13 @@ void XIndex::unfoldParameters(XConstraintGroup *, vector<XVariable *> &arguments
 }
 
 
-void XLengths::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XLengths::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XLengths *xl = dynamic_cast<XLengths *>(original);
     group->unfoldVector(lengths, arguments, xl->lengths);
 }
 
 
-void XConstraintExtension::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintExtension::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraint::unfoldParameters(group, arguments, original);
     XConstraintExtension *xe = dynamic_cast<XConstraintExtension *>(original);
     isSupport = xe->isSupport;
@@ -456,13 +519,13 @@ void XConstraintExtension::unfoldParameters(XConstraintGroup *group, vector<XVar
 }
 
 
-void XConstraintIntension::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintIntension::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraintIntension *xi = dynamic_cast<XConstraintIntension *>(original);
     function = xi->function;
     group->unfoldString(function, arguments);
 }
 
-void XConstraintRegular::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments,
+void XConstraintRegular::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments,
                                           XConstraint *original) {
     XConstraint::unfoldParameters(group, arguments, original);
     XConstraintRegular *xr = dynamic_cast<XConstraintRegular *>(original);
@@ -472,42 +535,86 @@ void XConstraintRegular::unfoldParameters(XConstraintGroup *group, vector<XVaria
     for(auto &s : final) {
         group->unfoldString(s, arguments);
     }
-    transitions.assign(xr->transitions.begin(), xr->transitions.end());
+    automaton = xr->automaton;
+}
+
+
+bool XConstraintRegular::hasParameters() const {
+    if(start.find('%') != string::npos)
+        return true;
+    for(const string &s : final)
+        if(s.find('%') != string::npos)
+            return true;
+    return false;
+}
+
+
+void XConstraintMDD::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
+    XConstraint::unfoldParameters(group, arguments, original);
+    XConstraintMDD *xm = dynamic_cast<XConstraintMDD *>(original);
+    automaton = xm->automaton;
+}
+
+
+int XAutomaton::state(const string &name) {
+    auto it = ids.find(name);
+    if(it != ids.end())
+        return it->second;
+    int id = states.size();
+    ids.emplace(name, id);
+    states.push_back(name);
+    return id;
 }
 
+
+void XAutomaton::toTransitions(vector<XTransition> &list) const {
+    list.clear();
+    list.reserve(nbTransitions());
+    for(unsigned int i = 0 ; i < transitions.size() ; i += 3)
+        list.push_back(XTransition(states[transitions[i]], transitions[i + 1], states[transitions[i + 2]]));
+}
+
+
+void XAutomaton::clear() {
+    states.clear();
+    transitions.clear();
+    ids.clear();
+}
+
+
 void XConstraintGroup::unfoldArgumentNumber(int i, XConstraint *builtConstraint) {
     builtConstraint->unfoldParameters(this, arguments[i], constraint);
     return;
 }
 
 
-void XConstraintAllDiff::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintAllDiff::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraint::unfoldParameters(group, arguments, original);
     XValues::unfoldParameters(group, arguments, original);
 }
 
-void XConstraintAllDiffMatrix::unfoldParameters(XConstraintGroup *, vector<XVariable *> &, XConstraint *) {
+void XConstraintAllDiffMatrix::unfoldParameters(XConstraintGroup *, XSpan<XVariable *>, XConstraint *) {
     throw runtime_error("Group Alldiff Matrix and list is not yet supported");
 }
 
-void XConstraintOrdered::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintOrdered::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraint::unfoldParameters(group, arguments, original);
     XLengths::unfoldParameters(group, arguments, original);
 }
 
-void XConstraintLex::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintLex::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraintLex *xc = dynamic_cast<XConstraintLex *>(original);
     for(unsigned int i = 0 ; i < lists.size() ; i++)
         group->unfoldVector(lists[i], arguments, xc->lists[i]);
 }
 
 
-void XConstraintLexMatrix::unfoldParameters(XConstraintGroup *, vector<XVariable *> &, XConstraint *) {
+void XConstraintLexMatrix::unfoldParameters(XConstraintGroup *, XSpan<XVariable *>, XConstraint *) {
     throw runtime_error("Group lex Matrix  is not yet supported");
 }
 
 
-void XConstraintSum::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintSum::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraint::unfoldParameters(group, arguments, original);
     XValues::unfoldParameters(group, arguments, original);
     XInitialCondition::unfoldParameters(group, arguments, original);
@@ -515,13 +622,13 @@ void XConstraintSum::unfoldParameters(XConstraintGroup *group, vector<XVariable
 }
 
 
-void XConstraintNValues::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintNValues::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraint::unfoldParameters(group, arguments, original);
     XInitialCondition::unfoldParameters(group, arguments, original);
 }
 
 
-void XConstraintCardinality::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintCardinality::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraintCardinality *xc = dynamic_cast<XConstraintCardinality *>(original);
     closed = xc->closed;
     XConstraint::unfoldParameters(group, arguments, original);
@@ -530,14 +637,14 @@ void XConstraintCardinality::unfoldParameters(XConstraintGroup *group, vector<XV
 }
 
 
-void XConstraintCount::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintCount::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraint::unfoldParameters(group, arguments, original);
     XValues::unfoldParameters(group, arguments, original);
     XInitialCondition::unfoldParameters(group, arguments, original);
 }
 
 
-void XConstraintMaximum::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintMaximum::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraintMaximum *xc = dynamic_cast<XConstraintMaximum *>(original);
     XConstraint::unfoldParameters(group, arguments, original);
     XIndex::unfoldParameters(group, arguments, original);
@@ -547,7 +654,7 @@ void XConstraintMaximum::unfoldParameters(XConstraintGroup *group, vector<XVaria
 }
 
 
-void XConstraintElement::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintElement::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraintElement *xc = dynamic_cast<XConstraintElement *>(original);
     XConstraint::unfoldParameters(group, arguments, original);
     XIndex::unfoldParameters(group, arguments, original);
@@ -560,7 +667,7 @@ void XConstraintElement::unfoldParameters(XConstraintGroup *group, vector<XVaria
 }
 
 
-void XConstraintElementMatrix::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintElementMatrix::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraintElementMatrix *xc = dynamic_cast<XConstraintElementMatrix *>(original);
     XConstraint::unfoldParameters(group, arguments, original);
     XIndex::unfoldParameters(group, arguments, original);
@@ -578,7 +685,7 @@ void XConstraintElementMatrix::unfoldParameters(XConstraintGroup *group, vector<
 }
 
 
-void XConstraintChannel::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintChannel::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraintChannel *xc = dynamic_cast<XConstraintChannel *>(original);
     XConstraint::unfoldParameters(group, arguments, original);
     XValue::unfoldParameters(group, arguments, original);
@@ -588,7 +695,7 @@ void XConstraintChannel::unfoldParameters(XConstraintGroup *group, vector<XVaria
 }
 
 
-void XConstraintNoOverlap::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintNoOverlap::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraint::unfoldParameters(group, arguments, original);
     XLengths::unfoldParameters(group, arguments, original);
     XConstraintNoOverlap *xc = dynamic_cast<XConstraintNoOverlap *>(original);
@@ -597,7 +704,7 @@ void XConstraintNoOverlap::unfoldParameters(XConstraintGroup *group, vector<XVar
 }
 
 
-void XConstraintCumulative::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintCumulative::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraintCumulative *xc = dynamic_cast<XConstraintCumulative *>(original);
 
     //XConstraint::unfoldParameters(group, arguments, original); // Done with origins.
@@ -609,7 +716,7 @@ void XConstraintCumulative::unfoldParameters(XConstraintGroup *group, vector<XVa
 }
 
 
-void XConstraintBinPacking::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintBinPacking::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraintBinPacking *xc = dynamic_cast<XConstraintBinPacking *>(original);
     XConstraint::unfoldParameters(group, arguments, original);
     XValues::unfoldParameters(group, arguments, original);
@@ -620,12 +727,12 @@ void XConstraintBinPacking::unfoldParameters(XConstraintGroup *group, vector<XVa
 }
 
 
-void XConstraintStretch::unfoldParameters(XConstraintGroup *, vector<XVariable *> &, XConstraint *) {
+void XConstraintStretch::unfoldParameters(XConstraintGroup *, XSpan<XVariable *>, XConstraint *) {
     throw runtime_error("group is not yet allowed with stretch constraint");
 }
 
 
-void XConstraintCircuit::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintCircuit::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraintCircuit *xc = dynamic_cast<XConstraintCircuit *>(original);
     XConstraint::unfoldParameters(group, arguments, original);
     XValue::unfoldParameters(group, arguments, original);
@@ -633,7 +740,7 @@ void XConstraintCircuit::unfoldParameters(XConstraintGroup *group, vector<XVaria
 }
 
 
-void XConstraintClause::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintClause::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
 
     for(XVariable *xv : arguments) {
         if(dynamic_cast<XTree*>(xv) != nullptr) { // not
@@ -648,20 +755,20 @@ void XConstraintClause::unfoldParameters(XConstraintGroup *group, vector<XVariab
     }
 }
 
-void XConstraintInstantiation::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintInstantiation::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraint::unfoldParameters(group, arguments, original);
     XValues::unfoldParameters(group, arguments, original);
 }
 
 
-void XConstraintPrecedence::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintPrecedence::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraintPrecedence *xc = dynamic_cast<XConstraintPrecedence *>(original);
     XConstraint::unfoldParameters(group, arguments, original);
     XValues::unfoldParameters(group, arguments, original);
     covered = xc->covered;
 }
 
-void XConstraintFlow::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintFlow::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraintFlow *xc = dynamic_cast<XConstraintFlow *>(original);
 
     XConstraint::unfoldParameters(group, arguments, original);
@@ -674,7 +781,7 @@ void XConstraintFlow::unfoldParameters(XConstraintGroup *group, vector<XVariable
 
 
 
-void XConstraintKnapsack::unfoldParameters(XConstraintGroup *group, vector<XVariable *> &arguments, XConstraint *original) {
+void XConstraintKnapsack::unfoldParameters(XConstraintGroup *group, XSpan<XVariable *> arguments, XConstraint *original) {
     XConstraintKnapsack *xc = dynamic_cast<XConstraintKnapsack *>(original);
     XConstraint::unfoldParameters(group, arguments, original);
     XInitialCondition::unfoldParameters(group, arguments, original);
@@ -753,5 +860,90 @@ std::string &XCSP3Core::trim(std::string &s) {
 }
 
 
+bool XCSP3Core::parseInteger(const char *begin, const char *end, int &value) {
+    const char *p = begin;
+    bool negative = false;
+    if(p != end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+    if(p == end)
+        return false;
+    long long v = 0;
+    for(; p != end ; p++) {
+        if(*p < '0' || *p > '9')
+            return false;
+        v = v * 10 + (*p - '0');
+        if(v > (long long) INT_MAX + 1)
+            return false;
+    }
+    if(negative)
+        v = -v;
+    if(v > INT_MAX)
+        return false;
+    value = (int) v;
+    return true;
+}
+
+
+bool XCSP3Core::parseInteger(const std::string &s, int &value) {
+    const char *begin = s.data(), *end = begin + s.size();
+    while(begin != end && std::isspace((unsigned char) *begin))
+        begin++;
+    while(end != begin && std::isspace((unsigned char) end[-1]))
+        end--;
+    return parseInteger(begin, end, value);
+}
+
+
+TokenKind XCSP3Core::classifyToken(const std::string &token, int &first, int &second) {
+    const char *begin = token.data(), *end = begin + token.size();
+    const char *dot = nullptr, *times = nullptr;
+    int nbTimes = 0;
+    bool parameter = false, array = false;
+    for(const char *p = begin ; p != end ; p++) {
+        switch(*p) {
+            case '(':
+                return TOKEN_TREE;
+            case '%':
+                parameter = true;
+                break;
+            case '[':
+                array = true;
+                break;
+            case '.':
+                if(dot == nullptr) dot = p;
+                break;
+            case 'x':
+                if(times == nullptr) times = p;
+                nbTimes++;
+                break;
+            default:
+                break;
+        }
+    }
+    if(begin != end && *begin == '{')
+        return TOKEN_SET;
+    if(parameter)
+        return TOKEN_PARAMETER;
+    if(array)
+        return TOKEN_ARRAY;
+    if(dot != nullptr) // first..second
+        return dot + 1 != end && dot[1] == '.' && parseInteger(begin, dot, first) && parseInteger(dot + 2, end, second)
+               ? TOKEN_RANGE : TOKEN_VARIABLE;
+    if(nbTimes == 1 && times + 1 != end && parseInteger(times + 1, end, second)) { // first x second
+        if(times - begin == 1 && *begin == '*') {
+            first = STAR;
+            return TOKEN_COMPACT;
+        }
+        if(parseInteger(begin, times, first))
+            return TOKEN_COMPACT;
+    }
+    if(end - begin == 1 && *begin == '*') {
+        first = STAR;
+        return TOKEN_STAR;
+    }
+    return parseInteger(begin, end, first) ? TOKEN_INTEGER : TOKEN_VARIABLE;
+}
+
+
 
 
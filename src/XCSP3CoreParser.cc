@@ -23,6 +23,10 @@
  * THE SOFTWARE.
  *=============================================================================
  */#include "XCSP3CoreParser.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 using namespace XCSP3Core;
 
@@ -44,6 +48,121 @@ int XCSP3CoreParser::parse(const char *filename) {
 }
 
 
+/***************************************************************************
+ * Reads the input by chunks, possibly in a second thread (read-ahead)
+ **************************************************************************/
+
+class XCSP3ChunkReader {
+    istream &in;
+    size_t chunkSize, maxChunkSize;
+    vector<char> buffers[2];     // the one being parsed and the one being read
+    size_t lengths[2];
+    bool full[2];                // the buffer contains a chunk not yet parsed
+    bool last[2];                // this chunk is the last one
+    int current;                 // the buffer returned by the last call to next, -1 if none
+    bool finished;
+    bool threaded, stopping;
+    std::exception_ptr error;    // thrown while reading
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::thread reader;
+
+
+    // Read a chunk in the buffer, chunks grow while the stream fills them
+    size_t read(int buffer) {
+        buffers[buffer].resize(chunkSize);
+        in.read(buffers[buffer].data(), chunkSize);
+        size_t length = in.gcount();
+        if(length == chunkSize && chunkSize < maxChunkSize)
+            chunkSize = std::min(chunkSize * 2, maxChunkSize);
+        return length;
+    }
+
+
+    void readAhead() {
+        int buffer = 0;
+        try {
+            for(;;) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&] { return stopping || !full[buffer]; });
+                    if(stopping)
+                        return;
+                }
+                size_t length = read(buffer);
+                bool end = !in.good();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    lengths[buffer] = length;
+                    last[buffer] = end;
+                    full[buffer] = true;
+                }
+                changed.notify_all();
+                if(end)
+                    return;
+                buffer = 1 - buffer;
+            }
+        } catch(...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+            lengths[buffer] = 0;
+            last[buffer] = full[buffer] = true;
+            changed.notify_all();
+        }
+    }
+
+
+public:
+    XCSP3ChunkReader(istream &i, size_t size, size_t maxSize, bool t) : in(i), chunkSize(size), maxChunkSize(maxSize), current(-1),
+                                                                         finished(false), threaded(t), stopping(false) {
+        full[0] = full[1] = last[0] = last[1] = false;
+        if(threaded)
+            reader = std::thread(&XCSP3ChunkReader::readAhead, this);
+    }
+
+
+    ~XCSP3ChunkReader() {
+        if(threaded) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            changed.notify_all();
+            reader.join();
+        }
+    }
+
+
+    // The next chunk, valid until the next call. Return false at the end of the stream
+    bool next(const char *&data, int &length) {
+        if(finished)
+            return false;
+        if(threaded == false) {
+            length = static_cast<int>(read(0));
+            data = buffers[0].data();
+            finished = !in.good();
+            return length > 0;
+        }
+
+        int buffer = current < 0 ? 0 : 1 - current;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if(current >= 0)
+                full[current] = false;
+            changed.notify_all();
+            changed.wait(lock, [&] { return full[buffer]; });
+        }
+        if(error)
+            std::rethrow_exception(error);
+        current = buffer;
+        finished = last[buffer];
+        data = buffers[buffer].data();
+        length = static_cast<int>(lengths[buffer]);
+        return length > 0;
+    }
+};
+
+
 int XCSP3CoreParser::parse(istream &in) {
     /**
      * We don't use the DOM interface because it reads the document as
@@ -58,12 +177,6 @@ int XCSP3CoreParser::parse(istream &in) {
      */
     const char *filename = NULL; // name of the input file
     xmlSAXHandler handler;
-    xmlParserCtxtPtr parserCtxt = nullptr;
-
-    const int bufSize = 4096;
-    std::unique_ptr<char[]> buffer { new char[bufSize] };
-
-    int size;
 
     xmlSAXVersion(&handler, 1); // use SAX1 for now ???
 
@@ -74,31 +187,67 @@ int XCSP3CoreParser::parse(istream &in) {
     handler.endElement = endElement;
     handler.comment = comment;
 
+    status = PARSE_COMPLETE;
+    error = nullptr;
+    callbacks->stopRequested = false;
 
-        xmlSubstituteEntitiesDefault(1);
-
-        in.read(buffer.get(), bufSize);
-        size = static_cast<int>(in.gcount());
-
-        if(size > 0) {
-            parserCtxt = xmlCreatePushParserCtxt(&handler, &cspParser, buffer.get(), size, filename);
+    // Pipes and sockets cannot seek: the next chunk is read while the current one is parsed
+    bool threaded = readAhead == READ_AHEAD_ALWAYS || (readAhead == READ_AHEAD_AUTO && in.tellg() == std::streampos(-1));
+    in.clear(in.rdstate() & ~ios::failbit);
+    XCSP3ChunkReader reader(in, chunkSize, maxChunkSize, threaded);
+    const char *chunk;
+    int size;
 
-            while(in.good()) {
-                in.read(buffer.get(), bufSize);
-                size = static_cast<int>(in.gcount());
+        xmlSubstituteEntitiesDefault(1);
 
-                if(size > 0)
-                    xmlParseChunk(parserCtxt, buffer.get(), size, 0);
+        if(reader.next(chunk, size)) {
+            // The SAX handlers receive this parser, they never let an exception go through libxml2
+            // The first bytes are enough to detect the encoding
+            int first = std::min(size, 4);
+            context = xmlCreatePushParserCtxt(&handler, this, chunk, first, filename);
+
+            try {
+                if(size > first)
+                    xmlParseChunk(context, chunk + first, size - first, 0);
+                while(!stopped()) {
+                    if(token != nullptr && token->isCancelled()) {
+                        status = PARSE_CANCELLED;
+                        break;
+                    }
+                    if(reader.next(chunk, size) == false)
+                        break;
+                    xmlParseChunk(context, chunk, size, 0);
+                }
+
+                if(!stopped())
+                    xmlParseChunk(context, nullptr, 0, 1);
+            } catch(...) {
+                error = std::current_exception();
             }
 
-            xmlParseChunk(parserCtxt, buffer.get(), 0, 1);
-
-            xmlFreeParserCtxt(parserCtxt);
+            xmlFreeParserCtxt(context);
+            context = nullptr;
+            if(stopped())
+                cspParser.abort();
 
             xmlCleanupParser();
         }
 
-    return 0;
+    if(error)
+        std::rethrow_exception(error);
+    return status;
+}
+
+
+void XCSP3CoreParser::checkStop() {
+    if(status == PARSE_COMPLETE) {
+        if(callbacks->stopRequested)
+            status = PARSE_STOPPED;
+        else if(token != nullptr && token->isCancelled())
+            status = PARSE_CANCELLED;
+    }
+    if(stopped() && context != nullptr)
+        xmlStopParser(context);
 }
 
 
@@ -106,31 +255,51 @@ int XCSP3CoreParser::parse(istream &in) {
 void XCSP3CoreParser::comment(void *, const xmlChar *) { }
 
 
-void XCSP3CoreParser::startDocument(void *parser) {
+void XCSP3CoreParser::startDocument(void *data) {
 #ifdef debug
     cout << "Parsing begins" << endl;
 #endif
-    static_cast<XMLParser *> (parser)->startDocument();
+    XCSP3CoreParser *parser = static_cast<XCSP3CoreParser *> (data);
+    parser->cspParser.startDocument();
 }
 
 
-void XCSP3CoreParser::endDocument(void *parser) {
+void XCSP3CoreParser::endDocument(void *data) {
 #ifdef debug
     cout << "Parsing ends" << endl;
 #endif
-    static_cast<XMLParser *> (parser)->endDocument();
+    XCSP3CoreParser *parser = static_cast<XCSP3CoreParser *> (data);
+    if(parser->stopped())
+        return;
+    try {
+        parser->cspParser.endDocument();
+    } catch(...) {
+        parser->error = std::current_exception();
+    }
+    parser->checkStop();
 }
 
 
-void XCSP3CoreParser::characters(void *parser, const xmlChar *ch, int len) {
+void XCSP3CoreParser::characters(void *data, const xmlChar *ch, int len) {
 #ifdef debug
     cout << "    chars '" << UTF8String(ch, ch + len) << "'" << endl;
 #endif
-    static_cast<XMLParser *> (parser)->characters(UTF8String(ch, ch + len));
+    XCSP3CoreParser *parser = static_cast<XCSP3CoreParser *> (data);
+    if(parser->stopped())
+        return;
+    try {
+        parser->cspParser.characters(UTF8String(ch, ch + len));
+    } catch(...) {
+        parser->error = std::current_exception();
+    }
+    parser->checkStop();
 }
 
 
-void XCSP3CoreParser::startElement(void *parser, const xmlChar *name, const xmlChar **attr) {
+void XCSP3CoreParser::startElement(void *data, const xmlChar *name, const xmlChar **attr) {
+    XCSP3CoreParser *parser = static_cast<XCSP3CoreParser *> (data);
+    if(parser->stopped())
+        return;
     AttributeList attributes(attr);
 #ifdef debug
     cout << "  begin element " << UTF8String(name) << endl;
@@ -139,16 +308,26 @@ void XCSP3CoreParser::startElement(void *parser, const xmlChar *name, const xmlC
                         << " = " << attributes.getValue(i) << endl;
             }
 #endif
-    static_cast<XMLParser *> (parser)->startElement(UTF8String(name), attributes);
+    try {
+        parser->cspParser.startElement(UTF8String(name), attributes);
+    } catch(...) {
+        parser->error = std::current_exception();
+    }
+    parser->checkStop();
 }
 
 
-void XCSP3CoreParser::endElement(void *parser, const xmlChar *name) {
+void XCSP3CoreParser::endElement(void *data, const xmlChar *name) {
 #ifdef debug
     cout << "  end element " << UTF8String(name) << endl;
 #endif
-    static_cast<XMLParser *> (parser)->endElement(UTF8String(name));
+    XCSP3CoreParser *parser = static_cast<XCSP3CoreParser *> (data);
+    if(parser->stopped())
+        return;
+    try {
+        parser->cspParser.endElement(UTF8String(name));
+    } catch(...) {
+        parser->error = std::current_exception();
+    }
+    parser->checkStop();
 }
-
-
-
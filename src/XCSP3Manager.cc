@@ -28,14 +28,38 @@
 #include "XCSP3Constants.h"
 #include "XCSP3Objective.h"
 #include "XCSP3TreeNode.h"
+#include "XCSP3Profiler.h"
 #include <string>
 #include <regex>
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 
 using namespace XCSP3Core;
 
 
+// Call the zero-copy version of a callback (arguments views) if useViews is set, the classical one otherwise
+#ifdef XCSP3_VIEWS
+#define XCSP3_VIEW_CALLBACK(method, views, classic)            \
+    do {                                                        \
+        if(callback->useViews)                                  \
+            XCSP3_CALLBACK(callback, method) views;             \
+        else                                                    \
+            XCSP3_CALLBACK(callback, method) classic;           \
+    } while(0)
+#else
+#define XCSP3_VIEW_CALLBACK(method, views, classic) XCSP3_CALLBACK(callback, method) classic
+#endif
+
+
 static OrderType expressionTypeToOrderType(ExpressionType e) {
     if(e == OLE) return LE;
     if(e == OLT) return LT;
@@ -47,6 +71,26 @@ static OrderType expressionTypeToOrderType(ExpressionType e) {
     return LE;
 }
 
+
+// Number of distinct variables of an expression, without building its tree (see SKIP_INTENSIONS)
+static int expressionArity(const string &expression) {
+    std::unordered_set<string> variables;
+    for(size_t i = 0 ; i < expression.size() ;) {
+        char c = expression[i];
+        if(isalpha(c) == false && c != '%') {
+            i++;
+            continue;
+        }
+        size_t j = i + 1;
+        while(j < expression.size() && (isalnum(expression[j]) || expression[j] == '_' || expression[j] == '[' || expression[j] == ']'))
+            j++;
+        if(j == expression.size() || expression[j] != '(')  // operators are followed by their parameters
+            variables.insert(expression.substr(i, j - i));
+        i = j;
+    }
+    return variables.size();
+}
+
 //--------------------------------------------------------------------------------------
 // Classes used to recognized expressions.
 //--------------------------------------------------------------------------------------
@@ -59,9 +103,10 @@ public :
     std::vector<ExpressionType> operators;
     XCSP3Manager &manager;
     std::string id;
+    int callbacks;   // SpecialCallback that post can call (it does not match the cases whose callback is missing)
 
 
-    PrimitivePattern(XCSP3Manager &m, string expr) : pattern(expr), manager(m) {}
+    PrimitivePattern(XCSP3Manager &m, string expr, int c) : pattern(expr), manager(m), callbacks(c) {}
 
 
     virtual ~PrimitivePattern() {}
@@ -92,7 +137,7 @@ public :
 
 class PrimitiveUnary1 : public XCSP3Core::PrimitivePattern {  // x op k
 public:
-    PrimitiveUnary1(XCSP3Manager &m) : PrimitivePattern(m, "eq(x,3)") {
+    PrimitiveUnary1(XCSP3Manager &m) : PrimitivePattern(m, "eq(x,3)", CALLBACK_UNARY_EXTENSION | CALLBACK_PRIMITIVE_XK) {
         pattern.root->type = OFAKEOP;
     }
 
@@ -100,16 +145,16 @@ public:
     bool post() override {
         if(operators.size() != 1 || isRelationalOperator(operators[0]) == false)
             return false;
-        if(operators[0] == OEQ || operators[0] == ONE) {
+        if((operators[0] == OEQ || operators[0] == ONE) && manager.callback->implements(CALLBACK_UNARY_EXTENSION)) {
             std::vector<int> values;
             values.push_back(constants[0]);
-            manager.callback->buildConstraintExtension(id, (XVariable *) manager.mapping[variables[0]], values,
-                                                       operators[0] == OEQ, false);
+            manager.buildUnaryExtension(id, (XVariable *) manager.mapping[variables[0]], values,
+                                        operators[0] == OEQ, false);
             return true;
         }
-        if(operators[0] == OLE) {
-            manager.callback->buildConstraintPrimitive(id, LE, (XVariable *) manager.mapping[variables[0]],
-                                                       constants[0]);
+        if(operators[0] == OLE && manager.callback->implements(CALLBACK_PRIMITIVE_XK)) {
+            XCSP3_CALLBACK(manager.callback, buildConstraintPrimitive)(id, LE, (XVariable *) manager.mapping[variables[0]],
+                                                                       constants[0]);
             return true;
         }
         return false;
@@ -118,18 +163,18 @@ public:
 
 class PrimitiveUnary2 : public XCSP3Core::PrimitivePattern {  // x op k
 public:
-    PrimitiveUnary2(XCSP3Manager &m) : PrimitivePattern(m, "le(3,x)") {}
+    PrimitiveUnary2(XCSP3Manager &m) : PrimitivePattern(m, "le(3,x)", CALLBACK_PRIMITIVE_XK) {}
 
 
     bool post() override {
-        manager.callback->buildConstraintPrimitive(id, GE, (XVariable *) manager.mapping[variables[0]], constants[0]);
+        XCSP3_CALLBACK(manager.callback, buildConstraintPrimitive)(id, GE, (XVariable *) manager.mapping[variables[0]], constants[0]);
         return true;
     }
 };
 
 class PrimitiveUnary3 : public XCSP3Core::PrimitivePattern {  // x in {1,3 5...}
 public:
-    PrimitiveUnary3(XCSP3Manager &m) : PrimitivePattern(m, "in(x,set(1,3,5))") {
+    PrimitiveUnary3(XCSP3Manager &m) : PrimitivePattern(m, "in(x,set(1,3,5))", CALLBACK_UNARY_EXTENSION) {
         pattern.root->type = OFAKEOP;
     }
 
@@ -143,13 +188,13 @@ public:
             values.push_back((dynamic_cast<NodeConstant *>(n))->val);
         if(values.size() == 0) {
             if(operators[0] == OIN)
-                manager.callback->buildConstraintFalse(id);
+                XCSP3_CALLBACK(manager.callback, buildConstraintFalse)(id);
             else
-                manager.callback->buildConstraintTrue(id);
+                XCSP3_CALLBACK(manager.callback, buildConstraintTrue)(id);
             return true;
         }
-        manager.callback->buildConstraintExtension(id, (XVariable *) manager.mapping[variables[0]], values,
-                                                   operators[0] == OIN, false);
+        manager.buildUnaryExtension(id, (XVariable *) manager.mapping[variables[0]], values,
+                                    operators[0] == OIN, false);
         return true;
     }
 };
@@ -157,7 +202,7 @@ public:
 
 class PrimitiveUnary4 : public XCSP3Core::PrimitivePattern {  // x>=1 and x<=4
 public:
-    PrimitiveUnary4(XCSP3Manager &m) : PrimitivePattern(m, "and(le(x,1),le(4,x))") {
+    PrimitiveUnary4(XCSP3Manager &m) : PrimitivePattern(m, "and(le(x,1),le(4,x))", CALLBACK_PRIMITIVE_IN) {
         pattern.root->type = OFAKEOP;
     }
 
@@ -167,17 +212,17 @@ public:
             return false;
         if(operators[0] == OAND) {
             if(constants[1] > constants[0])
-                manager.callback->buildConstraintFalse(id);
+                XCSP3_CALLBACK(manager.callback, buildConstraintFalse)(id);
             else
-                manager.callback->buildConstraintPrimitive(id, (XVariable *) manager.mapping[variables[0]], true,
-                                                           constants[1], constants[0]);
+                XCSP3_CALLBACK(manager.callback, buildConstraintPrimitive)(id, (XVariable *) manager.mapping[variables[0]], true,
+                                                                           constants[1], constants[0]);
             return true;
         }
         if(constants[0] > constants[1])
-            manager.callback->buildConstraintTrue(id);
+            XCSP3_CALLBACK(manager.callback, buildConstraintTrue)(id);
         else
-            manager.callback->buildConstraintPrimitive(id, (XVariable *) manager.mapping[variables[0]], false,
-                                                       constants[0] + 1, constants[1] - 1);
+            XCSP3_CALLBACK(manager.callback, buildConstraintPrimitive)(id, (XVariable *) manager.mapping[variables[0]], false,
+                                                                       constants[0] + 1, constants[1] - 1);
         return true;
     }
 };
@@ -185,7 +230,7 @@ public:
 
 class PrimitiveBinary1 : public XCSP3Core::PrimitivePattern {  // x <op> y
 public:
-    PrimitiveBinary1(XCSP3Manager &m) : PrimitivePattern(m, "eq(x,y)") {
+    PrimitiveBinary1(XCSP3Manager &m) : PrimitivePattern(m, "eq(x,y)", CALLBACK_PRIMITIVE_XKY) {
         pattern.root->type = OFAKEOP;
     }
 
@@ -193,16 +238,16 @@ public:
     bool post() override {
         if(operators.size() != 1 || isRelationalOperator(operators[0]) == false)
             return false;
-        manager.callback->buildConstraintPrimitive(id, expressionTypeToOrderType(operators[0]),
-                                                   (XVariable *) manager.mapping[variables[0]], 0,
-                                                   (XVariable *) manager.mapping[variables[1]]);
+        XCSP3_CALLBACK(manager.callback, buildConstraintPrimitive)(id, expressionTypeToOrderType(operators[0]),
+                                                                   (XVariable *) manager.mapping[variables[0]], 0,
+                                                                   (XVariable *) manager.mapping[variables[1]]);
         return true;
     }
 };
 
 class PrimitiveBinary2 : public XCSP3Core::PrimitivePattern {   // x + 3 <op> y
 public:
-    PrimitiveBinary2(XCSP3Manager &m) : PrimitivePattern(m, "eq(add(x,3),y)") {
+    PrimitiveBinary2(XCSP3Manager &m) : PrimitivePattern(m, "eq(add(x,3),y)", CALLBACK_PRIMITIVE_XKY) {
         pattern.root->type = OFAKEOP; // We do not care between logical operator
     }
 
@@ -210,9 +255,9 @@ public:
     bool post() override {
         if(operators.size() != 1 || isRelationalOperator(operators[0]) == false)
             return false;
-        manager.callback->buildConstraintPrimitive(id, expressionTypeToOrderType(operators[0]),
-                                                   (XVariable *) manager.mapping[variables[0]], constants[0],
-                                                   (XVariable *) manager.mapping[variables[1]]);
+        XCSP3_CALLBACK(manager.callback, buildConstraintPrimitive)(id, expressionTypeToOrderType(operators[0]),
+                                                                   (XVariable *) manager.mapping[variables[0]], constants[0],
+                                                                   (XVariable *) manager.mapping[variables[1]]);
 
         return true;
     }
@@ -221,7 +266,7 @@ public:
 
 class PrimitiveBinary3 : public XCSP3Core::PrimitivePattern { // x = y <op> 3
 public:
-    PrimitiveBinary3(XCSP3Manager &m) : PrimitivePattern(m, "eq(y,add(x,3))") {
+    PrimitiveBinary3(XCSP3Manager &m) : PrimitivePattern(m, "eq(y,add(x,3))", CALLBACK_PRIMITIVE_XKY) {
         pattern.root->type = OFAKEOP; // We do not care between logical operator
     }
 
@@ -230,9 +275,9 @@ public:
         if(operators.size() != 1 || isRelationalOperator(operators[0]) == false)
             return false;
         constants[0] = -constants[0];
-        manager.callback->buildConstraintPrimitive(id, expressionTypeToOrderType(operators[0]),
-                                                   (XVariable *) manager.mapping[variables[0]], constants[0],
-                                                   (XVariable *) manager.mapping[variables[1]]);
+        XCSP3_CALLBACK(manager.callback, buildConstraintPrimitive)(id, expressionTypeToOrderType(operators[0]),
+                                                                   (XVariable *) manager.mapping[variables[0]], constants[0],
+                                                                   (XVariable *) manager.mapping[variables[1]]);
 
         return true;
     }
@@ -241,7 +286,7 @@ public:
 
 class PrimitiveTernary1 : public XCSP3Core::PrimitivePattern { // x = y <op> 3
 public:
-    PrimitiveTernary1(XCSP3Manager &m) : PrimitivePattern(m, "eq(add(y,z),x)") {
+    PrimitiveTernary1(XCSP3Manager &m) : PrimitivePattern(m, "eq(add(y,z),x)", CALLBACK_SUM) {
         pattern.root->type = OFAKEOP; // We do not care between logical operator
     }
 
@@ -260,7 +305,7 @@ public:
         cond.operandType = INTEGER;
         cond.op = expressionTypeToOrderType(operators[0]);
         cond.val = 0;
-        manager.callback->buildConstraintSum(id, list, coefs, cond);
+        XCSP3_CALLBACK(manager.callback, buildConstraintSum)(id, list, coefs, cond);
 
         return true;
     }
@@ -269,43 +314,78 @@ public:
 
 class PrimitiveTernary2 : public XCSP3Core::PrimitivePattern { // x * y = z
 public:
-    PrimitiveTernary2(XCSP3Manager &m) : PrimitivePattern(m, "eq(mul(x,y),z)") {}
+    PrimitiveTernary2(XCSP3Manager &m) : PrimitivePattern(m, "eq(mul(x,y),z)", CALLBACK_MULT) {}
 
 
     bool post() override {
-        manager.callback->buildConstraintMult(id, (XVariable *) manager.mapping[variables[0]],
-                                              (XVariable *) manager.mapping[variables[1]],
-                                              (XVariable *) manager.mapping[variables[2]]);
+        XCSP3_CALLBACK(manager.callback, buildConstraintMult)(id, (XVariable *) manager.mapping[variables[0]],
+                                                              (XVariable *) manager.mapping[variables[1]],
+                                                              (XVariable *) manager.mapping[variables[2]]);
         return true;
     }
 };
 
 
+// True in the threads that unfold a group (see XCSP3GroupUnfolder)
+static thread_local bool unfoldingThread = false;
+
+// Matching a pattern modifies it: the unfolding threads that call the callbacks have their own patterns
+static thread_local struct ThreadPatterns {
+    std::vector<PrimitivePattern *> set;
+
+
+    ~ThreadPatterns() {
+        for(PrimitivePattern *p: set)
+            delete p;
+    }
+} threadPatterns;
+
+
 bool XCSP3Manager::recognizePrimitives(std::string id, Tree *tree) {
-    for(PrimitivePattern *p: patterns)
+    std::vector<PrimitivePattern *> *set = &patterns;
+    if(unfoldingThread) {
+        if(threadPatterns.set.empty())
+            createPrimitivePatterns(threadPatterns.set);
+        set = &threadPatterns.set;
+    }
+    for(PrimitivePattern *p: *set)
         if(p->setTarget(id, tree)->match())
             return true;
     return false;
 }
 
 
-void XCSP3Manager::createPrimitivePatterns() {
-    patterns.push_back(new PrimitiveUnary1(*this));
-    patterns.push_back(new PrimitiveUnary2(*this));
-    patterns.push_back(new PrimitiveUnary3(*this));
-    patterns.push_back(new PrimitiveUnary4(*this));
-    patterns.push_back(new PrimitiveBinary1(*this));
-    patterns.push_back(new PrimitiveBinary2(*this));
-    patterns.push_back(new PrimitiveBinary3(*this));
-    patterns.push_back(new PrimitiveTernary1(*this));
-    patterns.push_back(new PrimitiveTernary2(*this));
-
+void XCSP3Manager::createPrimitivePatterns(std::vector<PrimitivePattern *> &set) {
+    set.push_back(new PrimitiveUnary1(*this));
+    set.push_back(new PrimitiveUnary2(*this));
+    set.push_back(new PrimitiveUnary3(*this));
+    set.push_back(new PrimitiveUnary4(*this));
+    set.push_back(new PrimitiveBinary1(*this));
+    set.push_back(new PrimitiveBinary2(*this));
+    set.push_back(new PrimitiveBinary3(*this));
+    set.push_back(new PrimitiveTernary1(*this));
+    set.push_back(new PrimitiveTernary2(*this));
+
+    // Without any of the callbacks of a pattern, its expressions are given to buildConstraintIntension
+    for(PrimitivePattern *&p : set)
+        if((callback->implemented & p->callbacks) == 0) {
+            delete p;
+            p = nullptr;
+        }
+    set.erase(std::remove(set.begin(), set.end(), nullptr), set.end());
 }
 
 
-void XCSP3Manager::destroyPrimitivePatterns() {
-    for(PrimitivePattern *p: patterns)
+void XCSP3Manager::destroyPrimitivePatterns(std::vector<PrimitivePattern *> &set) {
+    for(PrimitivePattern *p: set)
         delete p;
+    set.clear();
+}
+
+
+void XCSP3Manager::endInstance() {
+    callback->endInstance();
+    XCSP3_PROFILE_REPORT(std::cerr);
 }
 
 
@@ -313,20 +393,18 @@ void XCSP3Manager::buildVariable(XVariable *variable) {
     if(discardedClasses(variable->classes))
         return;
 
-    if(variable->domain->values.size() == 1) {
-        callback->buildVariableInteger(variable->id, variable->domain->values[0]->minimum(),
-                                       variable->domain->values[0]->maximum());
+    XDomainInteger *domain = variable->domain;
+    if(domain->nbRuns() == 1) {
+        XCSP3_CALLBACK(callback, buildVariableInteger)(variable->id, domain->minimum(), domain->maximum());
         return;
     }
     std::vector<int> values;
-
-    for(unsigned int i = 0; i < variable->domain->values.size(); i++) {
-        for(int j = variable->domain->values[i]->minimum();
-            j <= variable->domain->values[i]->maximum(); j++) {
+    values.reserve(domain->nbValues());
+    for(int i = 0; i < domain->nbRuns(); i++) {
+        for(int j = domain->runMinimum(i); j <= domain->runMaximum(i); j++)
             values.push_back(j);
-        }
     }
-    callback->buildVariableInteger(variable->id, values);
+    XCSP3_CALLBACK(callback, buildVariableInteger)(variable->id, values);
 }
 
 
@@ -344,50 +422,102 @@ void XCSP3Manager::buildVariableArray(XVariableArray *variable) {
 //--------------------------------------------------------------------------------------
 
 
+void XCSP3Manager::buildUnaryExtension(string &id, XVariable *x, vector<int> &values, bool support, bool hasStar) {
+#ifdef XCSP3_VIEWS
+    if(callback->useViews) {
+        XCSP3_CALLBACK(callback, buildConstraintExtension)(XStringView(id), x, XSpan<int>(values), support, hasStar);
+        return;
+    }
+#endif
+    XCSP3_CALLBACK(callback, buildConstraintExtension)(id, x, values, support, hasStar);
+}
+
+
 void XCSP3Manager::newConstraintExtension(XConstraintExtension *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
+    if(callback->skip & SKIP_TUPLES) {
+        callback->skippedConstraint(constraint->id, "extension", constraint->list.size(), constraint->skippedBytes);
+        return;
+    }
 
-    if(constraint->list.size() == 1) {
+    if(constraint->list.size() == 1 && callback->implements(CALLBACK_UNARY_EXTENSION)) {
         std::vector<int> tuples;
+        tuples.reserve(constraint->tuples.size());
         for(vector<int> &tpl: constraint->tuples)
             tuples.push_back(tpl[0]);
-        callback->buildConstraintExtension(constraint->id, constraint->list[0], tuples, constraint->isSupport,
-                                           constraint->containsStar);
-    } else
-        callback->buildConstraintExtension(constraint->id, constraint->list, constraint->tuples,
-                                           constraint->isSupport, constraint->containsStar);
+        buildUnaryExtension(constraint->id, constraint->list[0], tuples, constraint->isSupport,
+                            constraint->containsStar);
+        return;
+    }
+#ifdef XCSP3_VIEWS
+    if(callback->useViews) {
+        XCSP3_CALLBACK(callback, buildConstraintExtension)(XStringView(constraint->id), XSpan<XVariable *>(constraint->list),
+                                                           XSpan<vector<int> >(constraint->tuples), constraint->isSupport,
+                                                           constraint->containsStar);
+        return;
+    }
+#endif
+    XCSP3_CALLBACK(callback, buildConstraintExtension)(constraint->id, constraint->list, constraint->tuples,
+                                                       constraint->isSupport, constraint->containsStar);
 }
 
 
 void XCSP3Manager::newConstraintExtensionAsLastOne(XConstraintExtension *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
-    callback->buildConstraintExtensionAs(constraint->id, constraint->list,
-                                         constraint->isSupport, constraint->containsStar);
+    if(callback->skip & SKIP_TUPLES) {
+        callback->skippedConstraint(constraint->id, "extension", constraint->list.size(), 0);
+        return;
+    }
+#ifdef XCSP3_VIEWS
+    if(callback->useViews) {
+        XCSP3_CALLBACK(callback, buildConstraintExtensionAs)(XStringView(constraint->id), XSpan<XVariable *>(constraint->list),
+                                                             constraint->isSupport, constraint->containsStar);
+        return;
+    }
+#endif
+    XCSP3_CALLBACK(callback, buildConstraintExtensionAs)(constraint->id, constraint->list,
+                                                         constraint->isSupport, constraint->containsStar);
 }
 
 
 void XCSP3Manager::newConstraintIntension(XConstraintIntension *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(callback->intensionUsingString && callback->recognizeSpecialIntensionCases)
         throw std::runtime_error(
                 "You have to choose: using string or be able to recognize special intension constraints");
     if(discardedClasses(constraint->classes))
         return;
+    if(callback->skip & SKIP_INTENSIONS) {
+        callback->skippedConstraint(constraint->id, "intension", expressionArity(constraint->function), constraint->function.size());
+        return;
+    }
     if(callback->intensionUsingString) {
-        callback->buildConstraintIntension(constraint->id, constraint->function);
+#ifdef XCSP3_VIEWS
+        if(callback->useViews) {
+            XCSP3_CALLBACK(callback, buildConstraintIntension)(XStringView(constraint->id), XStringView(constraint->function));
+            return;
+        }
+#endif
+        XCSP3_CALLBACK(callback, buildConstraintIntension)(constraint->id, constraint->function);
         return;
     }
 
     //std::cout << "ROOT1= " << constraint->function << std::endl;
-    Tree *tree = new Tree(constraint->function);
-    tree->canonize();
+    Tree *tree = constraint->tree; // already built by prepareUnfolded
+    if(tree == nullptr) {
+        tree = new Tree(constraint->function);
+        tree->canonize();
+    }
 
     //std::cout << "ROOT2= " ; tree->prefixe();std::cout << std::endl;
     if(callback->recognizeSpecialIntensionCases && recognizePrimitives(constraint->id, tree))
         return;
 
-    callback->buildConstraintIntension(constraint->id, tree);
+    XCSP3_CALLBACK(callback, buildConstraintIntension)(constraint->id, tree);
 
 }
 
@@ -397,17 +527,44 @@ void XCSP3Manager::newConstraintIntension(XConstraintIntension *constraint) {
 
 
 void XCSP3Manager::newConstraintRegular(XConstraintRegular *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
+    if(discardedClasses(constraint->classes))
+        return;
+    XAutomaton &automaton = *constraint->automaton;
+    int start = automaton.state(constraint->start);
+    vector<int> final;
+    final.reserve(constraint->final.size());
+    for(string &f : constraint->final)
+        final.push_back(automaton.state(f));
+    XCSP3_VIEW_CALLBACK(buildConstraintRegular, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), start, XSpan<int>(final), automaton),
+                        (constraint->id, constraint->list, start, final, automaton));
+}
+
+
+void XCSP3Manager::newConstraintRegularAsLastOne(XConstraintRegular *constraint, int start, vector<int> &final) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
-    callback->buildConstraintRegular(constraint->id, constraint->list, constraint->start, constraint->final,
-                                     constraint->transitions);
+    XCSP3_VIEW_CALLBACK(buildConstraintRegularAs, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), start, XSpan<int>(final), *constraint->automaton),
+                        (constraint->id, constraint->list, start, final, *constraint->automaton));
 }
 
 
 void XCSP3Manager::newConstraintMDD(XConstraintMDD *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
+    if(discardedClasses(constraint->classes))
+        return;
+    XCSP3_VIEW_CALLBACK(buildConstraintMDD, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), *constraint->automaton),
+                        (constraint->id, constraint->list, *constraint->automaton));
+}
+
+
+void XCSP3Manager::newConstraintMDDAsLastOne(XConstraintMDD *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
-    callback->buildConstraintMDD(constraint->id, constraint->list, constraint->transitions);
+    XCSP3_VIEW_CALLBACK(buildConstraintMDDAs, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), *constraint->automaton),
+                        (constraint->id, constraint->list, *constraint->automaton));
 }
 
 //--------------------------------------------------------------------------------------
@@ -416,41 +573,46 @@ void XCSP3Manager::newConstraintMDD(XConstraintMDD *constraint) {
 
 void XCSP3Manager::containsTrees(vector<XVariable *> &list, vector<Tree *> &trees) {
     trees.clear();
-    XTree *xt = nullptr;
+    bool hasTree = false;
     for(XVariable *x: list) {
-        xt = dynamic_cast<XTree *>(x);
-        if(xt != nullptr) { // The list contains at least one tree. Transform in list of trees
+        if(x != nullptr && x->kind == TREE_E) { // The list contains at least one tree. Transform in list of trees
+            hasTree = true;
             break;
         }
     }
-    if(xt == nullptr)
+    if(hasTree == false)
         return;
 
+    // Each call gets its own trees: copies of the canonized expressions, other entities become leaves
     for(XVariable *x: list) {
-        xt = dynamic_cast<XTree *>(x);
-        if(xt != nullptr) { // The list contains at least one tree. Transform in list of trees
-            Tree *t = new Tree(xt->id);
-            t->canonize();
-            trees.push_back(t);
-        } else {
-            Tree *t = new Tree(x->id);
-            trees.push_back(t);
+        if(x->kind == TREE_E) {
+            trees.push_back(static_cast<XTree *>(x)->canonizedTree()->copy());
+            continue;
         }
+        int value;
+        if(isInteger(x, value)) {
+            trees.push_back(new Tree(new NodeConstant(value)));
+            continue;
+        }
+        Tree *t = new Tree(new NodeVariable(x->id));
+        t->listOfVariables.push_back(x->id);
+        trees.push_back(t);
     }
 }
 
 
 void XCSP3Manager::newConstraintAllDiff(XConstraintAllDiff *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     vector<Tree *> trees;
     if(discardedClasses(constraint->classes))
         return;
     if(constraint->values.size() == 0) {
         containsTrees(constraint->list, trees);
         if(trees.size() > 0) { // alldif over tree
-            callback->buildConstraintAlldifferent(constraint->id, trees);
+            XCSP3_CALLBACK(callback, buildConstraintAlldifferent)(constraint->id, trees);
             return;
         }
-        callback->buildConstraintAlldifferent(constraint->id, constraint->list);
+        XCSP3_CALLBACK(callback, buildConstraintAlldifferent)(constraint->id, constraint->list);
     } else {
         vector<int> except;
         for(auto *xv: constraint->values) {
@@ -458,71 +620,76 @@ void XCSP3Manager::newConstraintAllDiff(XConstraintAllDiff *constraint) {
             isInteger(xv, v);
             except.push_back(v);
         }
-        callback->buildConstraintAlldifferentExcept(constraint->id, constraint->list, except);
+        XCSP3_CALLBACK(callback, buildConstraintAlldifferentExcept)(constraint->id, constraint->list, except);
     }
 }
 
 
 void XCSP3Manager::newConstraintAllDiffMatrix(XConstraintAllDiffMatrix *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
-    callback->buildConstraintAlldifferentMatrix(constraint->id, constraint->matrix);
+    XCSP3_CALLBACK(callback, buildConstraintAlldifferentMatrix)(constraint->id, constraint->matrix);
 }
 
 
 void XCSP3Manager::newConstraintAllDiffList(XConstraintAllDiffList *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
-    callback->buildConstraintAlldifferentList(constraint->id, constraint->matrix);
+    XCSP3_CALLBACK(callback, buildConstraintAlldifferentList)(constraint->id, constraint->matrix);
 }
 
 
 void XCSP3Manager::newConstraintAllEqual(XConstraintAllEqual *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     vector<Tree *> trees;
     containsTrees(constraint->list, trees);
     if(trees.size() > 0) { // alldif over tree
-        callback->buildConstraintAllEqual(constraint->id, trees);
+        XCSP3_CALLBACK(callback, buildConstraintAllEqual)(constraint->id, trees);
         return;
     }
 
-    callback->buildConstraintAllEqual(constraint->id, constraint->list);
+    XCSP3_CALLBACK(callback, buildConstraintAllEqual)(constraint->id, constraint->list);
 }
 
 
 void XCSP3Manager::newConstraintOrdered(XConstraintOrdered *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     if(constraint->lengths.size() > 0) {
-        auto *tmp = dynamic_cast<XInteger*>(constraint->lengths[0]);
-        if (tmp != nullptr) {
+        if (constraint->lengths[0]->kind == INTEGER_E) {
             vector<int> lengths;
             for(XVariable *x: constraint->lengths)
                 lengths.push_back(((XInteger *) x)->value);
-            callback->buildConstraintOrdered(constraint->id, constraint->list, lengths, constraint->op);
+            XCSP3_CALLBACK(callback, buildConstraintOrdered)(constraint->id, constraint->list, lengths, constraint->op);
         } else {
             vector<XVariable*> lengths;
 
-            callback->buildConstraintOrdered(constraint->id, constraint->list, constraint->lengths, constraint->op);
+            XCSP3_CALLBACK(callback, buildConstraintOrdered)(constraint->id, constraint->list, constraint->lengths, constraint->op);
 
         }
     } else
-        callback->buildConstraintOrdered(constraint->id, constraint->list, constraint->op);
+        XCSP3_CALLBACK(callback, buildConstraintOrdered)(constraint->id, constraint->list, constraint->op);
 }
 
 
 void XCSP3Manager::newConstraintLex(XConstraintLex *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
-    callback->buildConstraintLex(constraint->id, constraint->lists, constraint->op);
+    XCSP3_CALLBACK(callback, buildConstraintLex)(constraint->id, constraint->lists, constraint->op);
 }
 
 
 void XCSP3Manager::newConstraintLexMatrix(XConstraintLexMatrix *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
-    callback->buildConstraintLexMatrix(constraint->id, constraint->matrix, constraint->op);
+    XCSP3_CALLBACK(callback, buildConstraintLexMatrix)(constraint->id, constraint->matrix, constraint->op);
 }
 
 
@@ -530,34 +697,72 @@ void XCSP3Manager::newConstraintLexMatrix(XConstraintLexMatrix *constraint) {
 // Summin and Counting constraints
 //--------------------------------------------------------------------------------------
 
+// Variables are unique entities (one per id in mapping): pointers can be compared instead of ids
+// Short lists (most sums) are compared pairwise, without allocating a hash table
+#define MAX_SHORT_SUM 16
+
+bool XCSP3Manager::containsDuplicates(vector<XVariable *> &list) {
+    if(list.size() <= MAX_SHORT_SUM) {
+        for(size_t i = 1; i < list.size(); i++)
+            for(size_t j = 0; j < i; j++)
+                if(list[j] == list[i])
+                    return true;
+        return false;
+    }
+    std::unordered_set<XVariable *> seen;
+    seen.reserve(list.size());
+    for(XVariable *x : list)
+        if(seen.insert(x).second == false)
+            return true;
+    return false;
+}
+
+
 void XCSP3Manager::normalizeSum(vector<XVariable *> &list, vector<int> &coefs) {
-    // merge
-    for(unsigned int i = 0; i < list.size() - 1; i++) {
-        if(coefs[i] == 0) continue;
-        for(auto j = i + 1; j < list.size(); j++) {
-            if(coefs[j] != 0 && list[i]->id == list[j]->id) {
-                coefs[i] += coefs[j];
-                coefs[j] = 0;
+    // merge: coefficients are added to the first occurrence of the variable (with a non zero coefficient)
+    if(list.size() <= MAX_SHORT_SUM) {
+        bool first[MAX_SHORT_SUM];
+        for(size_t i = 0; i < list.size(); i++) {
+            first[i] = false;
+            if(coefs[i] == 0) continue;
+            size_t j = 0;
+            while(j < i && (first[j] == false || list[j] != list[i]))
+                j++;
+            if(j == i)
+                first[i] = true;
+            else {
+                coefs[j] += coefs[i];
+                coefs[i] = 0;
+            }
+        }
+    } else {
+        std::unordered_map<XVariable *, size_t> first;
+        first.reserve(list.size());
+        for(size_t i = 0; i < list.size(); i++) {
+            if(coefs[i] == 0) continue;
+            auto it = first.emplace(list[i], i);
+            if(it.second == false) {
+                coefs[it.first->second] += coefs[i];
+                coefs[i] = 0;
             }
         }
     }
-    vector<int> tmpc;
-    vector<XVariable *> tmpv;
+
     // remove coef=0
-    for(unsigned int i = 0; i < list.size(); i++)
+    size_t nb = 0;
+    for(size_t i = 0; i < list.size(); i++)
         if(coefs[i] != 0) {
-            tmpv.push_back(list[i]);
-            tmpc.push_back(coefs[i]);
+            list[nb] = list[i];
+            coefs[nb] = coefs[i];
+            nb++;
         }
-
-    list.clear();
-    list.assign(tmpv.begin(), tmpv.end());
-    coefs.clear();
-    coefs.assign(tmpc.begin(), tmpc.end());
+    list.resize(nb);
+    coefs.resize(nb);
 }
 
 
 void XCSP3Manager::newConstraintSum(XConstraintSum *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     XCondition xc;
@@ -567,7 +772,7 @@ void XCSP3Manager::newConstraintSum(XConstraintSum *constraint) {
     containsTrees(constraint->list, trees);
     if(trees.size() > 0) { // alldif over tree
         if(constraint->values.size() == 0)
-            callback->buildConstraintSum(constraint->id, trees, xc);
+            XCSP3_CALLBACK(callback, buildConstraintSum)(constraint->id, trees, xc);
         else {
             vector<int> coefs;
             int v;
@@ -575,7 +780,7 @@ void XCSP3Manager::newConstraintSum(XConstraintSum *constraint) {
                 isInteger(xe, v);
                 coefs.push_back(v);
             }
-            callback->buildConstraintSum(constraint->id, trees, coefs, xc);
+            XCSP3_CALLBACK(callback, buildConstraintSum)(constraint->id, trees, coefs, xc);
         }
         return;
     }
@@ -585,16 +790,13 @@ void XCSP3Manager::newConstraintSum(XConstraintSum *constraint) {
         bool toModify = false;
         if(callback->normalizeSum) {
             // Check if a variable appears two times
-            for(unsigned int i = 0; i < constraint->list.size() - 1; i++)
-                for(auto j = i + 1; j < constraint->list.size(); j++) {
-                    if(constraint->list[i]->id == constraint->list[j]->id)
-                        toModify = true;
-                }
+            toModify = containsDuplicates(constraint->list);
             if(toModify)
-                constraint->values.assign(constraint->list.size(), new XInteger("", 1));
+                constraint->values.assign(constraint->list.size(), XInteger::constant(1));
         }
         if(!toModify) {
-            callback->buildConstraintSum(constraint->id, constraint->list, xc);
+            XCSP3_VIEW_CALLBACK(buildConstraintSum, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), xc),
+                                (constraint->id, constraint->list, xc));
             return;
         }
     }
@@ -612,7 +814,8 @@ void XCSP3Manager::newConstraintSum(XConstraintSum *constraint) {
         if(callback->normalizeSum)
             normalizeSum(list, coefs);
 
-        callback->buildConstraintSum(constraint->id, list, coefs, xc);
+        XCSP3_VIEW_CALLBACK(buildConstraintSum, (XStringView(constraint->id), XSpan<XVariable *>(list), XSpan<int>(coefs), xc),
+                            (constraint->id, list, coefs, xc));
         return;
     }
 
@@ -620,11 +823,13 @@ void XCSP3Manager::newConstraintSum(XConstraintSum *constraint) {
     for(XEntity *xe: constraint->values) {
         xvalues.push_back((XVariable *) mapping[xe->id]);
     }
-    callback->buildConstraintSum(constraint->id, constraint->list, xvalues, xc);
+    XCSP3_VIEW_CALLBACK(buildConstraintSum, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), XSpan<XVariable *>(xvalues), xc),
+                        (constraint->id, constraint->list, xvalues, xc));
 }
 
 
 void XCSP3Manager::newConstraintCount(XConstraintCount *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     int value;
@@ -640,13 +845,13 @@ void XCSP3Manager::newConstraintCount(XConstraintCount *constraint) {
                 isInteger(xe, value);
                 values.push_back(value);
             }
-            callback->buildConstraintCount(constraint->id, trees, values, xc);
+            XCSP3_CALLBACK(callback, buildConstraintCount)(constraint->id, trees, values, xc);
             return;
         }
         std::vector<XVariable *> valuesV;
         for(XEntity *xe: constraint->values)
             valuesV.push_back((XVariable *) mapping[xe->id]);
-        callback->buildConstraintCount(constraint->id, trees, valuesV, xc);
+        XCSP3_CALLBACK(callback, buildConstraintCount)(constraint->id, trees, valuesV, xc);
         return;
     }
 
@@ -655,41 +860,41 @@ void XCSP3Manager::newConstraintCount(XConstraintCount *constraint) {
     // Special cases AtLeastK, ATMostK, ..
     if(callback->recognizeSpecialCountCases && constraint->values.size() == 1 &&
        isInteger(constraint->values[0], value)) {
-        if(xc.operandType == INTEGER && xc.op == OrderType::LE) {
-            callback->buildConstraintAtMost(constraint->id, constraint->list, value, xc.val);
+        if(xc.operandType == INTEGER && xc.op == OrderType::LE && callback->implements(CALLBACK_AT_MOST)) {
+            XCSP3_CALLBACK(callback, buildConstraintAtMost)(constraint->id, constraint->list, value, xc.val);
             return;
         }
-        if(xc.operandType == INTEGER && xc.op == OrderType::LT) {
-            callback->buildConstraintAtMost(constraint->id, constraint->list, value, xc.val - 1);
+        if(xc.operandType == INTEGER && xc.op == OrderType::LT && callback->implements(CALLBACK_AT_MOST)) {
+            XCSP3_CALLBACK(callback, buildConstraintAtMost)(constraint->id, constraint->list, value, xc.val - 1);
             return;
         }
-        if(xc.operandType == INTEGER && xc.op == OrderType::GE) {
-            callback->buildConstraintAtLeast(constraint->id, constraint->list, value, xc.val);
+        if(xc.operandType == INTEGER && xc.op == OrderType::GE && callback->implements(CALLBACK_AT_LEAST)) {
+            XCSP3_CALLBACK(callback, buildConstraintAtLeast)(constraint->id, constraint->list, value, xc.val);
             return;
         }
-        if(xc.operandType == INTEGER && xc.op == OrderType::GT) {
-            callback->buildConstraintAtLeast(constraint->id, constraint->list, value, xc.val + 1);
+        if(xc.operandType == INTEGER && xc.op == OrderType::GT && callback->implements(CALLBACK_AT_LEAST)) {
+            XCSP3_CALLBACK(callback, buildConstraintAtLeast)(constraint->id, constraint->list, value, xc.val + 1);
             return;
         }
-        if(xc.operandType == INTEGER && xc.op == OrderType::EQ) {
-            callback->buildConstraintExactlyK(constraint->id, constraint->list, value, xc.val);
+        if(xc.operandType == INTEGER && xc.op == OrderType::EQ && callback->implements(CALLBACK_EXACTLY_K)) {
+            XCSP3_CALLBACK(callback, buildConstraintExactlyK)(constraint->id, constraint->list, value, xc.val);
             return;
         }
-        if(xc.operandType == VARIABLE && xc.op == OrderType::EQ) {
-            callback->buildConstraintExactlyVariable(constraint->id, constraint->list, value,
-                                                     (XVariable *) mapping[xc.var]);
+        if(xc.operandType == VARIABLE && xc.op == OrderType::EQ && callback->implements(CALLBACK_EXACTLY_VARIABLE)) {
+            XCSP3_CALLBACK(callback, buildConstraintExactlyVariable)(constraint->id, constraint->list, value,
+                                                                     (XVariable *) mapping[xc.var]);
             return;
         }
     }
 
     // Among
-    if(callback->recognizeSpecialCountCases && xc.op == OrderType::EQ && xc.operandType == INTEGER &&
-       isInteger(constraint->values[0], value)) {
+    if(callback->recognizeSpecialCountCases && callback->implements(CALLBACK_AMONG) && xc.op == OrderType::EQ &&
+       xc.operandType == INTEGER && isInteger(constraint->values[0], value)) {
         for(XEntity *xe: constraint->values) {
             isInteger(xe, value);
             values.push_back(value);
         }
-        callback->buildConstraintAmong(constraint->id, constraint->list, values, xc.val);
+        XCSP3_CALLBACK(callback, buildConstraintAmong)(constraint->id, constraint->list, values, xc.val);
         return;
     }
 
@@ -700,18 +905,21 @@ void XCSP3Manager::newConstraintCount(XConstraintCount *constraint) {
             isInteger(xe, value);
             values.push_back(value);
         }
-        callback->buildConstraintCount(constraint->id, constraint->list, values, xc);
+        XCSP3_VIEW_CALLBACK(buildConstraintCount, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), XSpan<int>(values), xc),
+                            (constraint->id, constraint->list, values, xc));
     } else {
         std::vector<XVariable *> values;
         for(XEntity *xe: constraint->values) {
             values.push_back((XVariable *) mapping[xe->id]);
         }
-        callback->buildConstraintCount(constraint->id, constraint->list, values, xc);
+        XCSP3_VIEW_CALLBACK(buildConstraintCount, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), XSpan<XVariable *>(values), xc),
+                            (constraint->id, constraint->list, values, xc));
     }
 }
 
 
 void XCSP3Manager::newConstraintNValues(XConstraintNValues *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     XCondition xc;
@@ -721,49 +929,65 @@ void XCSP3Manager::newConstraintNValues(XConstraintNValues *constraint) {
     containsTrees(constraint->list, trees);
 
     // Special NotAllEqual case
-    if(callback->recognizeNValuesCases && xc.operandType == INTEGER && constraint->except.size() == 0
-       && ((xc.op == GE && xc.val == 2) || (xc.op == GT && xc.val == 1))) {
+    if(callback->recognizeNValuesCases && callback->implements(CALLBACK_NOT_ALL_EQUAL) && xc.operandType == INTEGER
+       && constraint->except.size() == 0 && ((xc.op == GE && xc.val == 2) || (xc.op == GT && xc.val == 1))) {
         if(trees.size() > 0)
             throw runtime_error("Not all Equal with expressions not yet implemented");
-        callback->buildConstraintNotAllEqual(constraint->id, constraint->list);
+        XCSP3_CALLBACK(callback, buildConstraintNotAllEqual)(constraint->id, constraint->list);
         return;
     }
 
     // Special AllEqual case
-    if(callback->recognizeNValuesCases && xc.operandType == INTEGER &&
+    if(callback->recognizeNValuesCases && callback->implements(CALLBACK_ALL_EQUAL) && xc.operandType == INTEGER &&
        constraint->except.size() == 0 && (xc.op == OrderType::EQ && xc.val == 1)) {
         if(trees.size() > 0)
-            callback->buildConstraintAllEqual(constraint->id, trees);
+            XCSP3_CALLBACK(callback, buildConstraintAllEqual)(constraint->id, trees);
         else
-            callback->buildConstraintAllEqual(constraint->id, constraint->list);
+            XCSP3_CALLBACK(callback, buildConstraintAllEqual)(constraint->id, constraint->list);
         return;
     }
 
     // Special AllDiff case
-    if(callback->recognizeNValuesCases && xc.operandType == INTEGER && constraint->except.size() == 0
-       && (xc.op == OrderType::EQ && ((unsigned int) xc.val) == constraint->list.size())) {
+    if(callback->recognizeNValuesCases && callback->implements(CALLBACK_ALL_DIFFERENT) && xc.operandType == INTEGER
+       && constraint->except.size() == 0 && (xc.op == OrderType::EQ && ((unsigned int) xc.val) == constraint->list.size())) {
         if(trees.size() > 0)
-            callback->buildConstraintAlldifferent(constraint->id, trees);
+            XCSP3_CALLBACK(callback, buildConstraintAlldifferent)(constraint->id, trees);
         else
-            callback->buildConstraintAlldifferent(constraint->id, constraint->list);
+            XCSP3_CALLBACK(callback, buildConstraintAlldifferent)(constraint->id, constraint->list);
         return;
     }
 
     if(constraint->except.size() == 0) {
 
         if(trees.size() > 0)
-            callback->buildConstraintNValues(constraint->id, trees, xc);
+            XCSP3_CALLBACK(callback, buildConstraintNValues)(constraint->id, trees, xc);
         else
-            callback->buildConstraintNValues(constraint->id, constraint->list, xc);
+            XCSP3_VIEW_CALLBACK(buildConstraintNValues, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), xc),
+                                (constraint->id, constraint->list, xc));
         return;
     }
     if(trees.size() > 0)
         throw runtime_error("NVAlues with expression and expect not yet implemented");
-    callback->buildConstraintNValues(constraint->id, constraint->list, constraint->except, xc);
+    XCSP3_VIEW_CALLBACK(buildConstraintNValues, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), XSpan<int>(constraint->except), xc),
+                        (constraint->id, constraint->list, constraint->except, xc));
+}
+
+
+template<class V, class O>
+void XCSP3Manager::buildCardinality(XConstraintCardinality *constraint, vector<V> &values, vector<O> &occurs) {
+#ifdef XCSP3_VIEWS
+    if(callback->useViews) {
+        XCSP3_CALLBACK(callback, buildConstraintCardinality)(XStringView(constraint->id), XSpan<XVariable *>(constraint->list),
+                                                             XSpan<V>(values), XSpan<O>(occurs), constraint->closed);
+        return;
+    }
+#endif
+    XCSP3_CALLBACK(callback, buildConstraintCardinality)(constraint->id, constraint->list, values, occurs, constraint->closed);
 }
 
 
 void XCSP3Manager::newConstraintCardinality(XConstraintCardinality *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     std::vector<int> intValues;
@@ -808,33 +1032,27 @@ void XCSP3Manager::newConstraintCardinality(XConstraintCardinality *constraint)
     }
 
     if(intValues.size() > 0 && intOccurs.size() > 0) {
-        callback->buildConstraintCardinality(constraint->id, constraint->list, intValues, intOccurs,
-                                             constraint->closed);
+        buildCardinality(constraint, intValues, intOccurs);
         return;
     }
     if(intValues.size() > 0 && varOccurs.size() > 0) {
-        callback->buildConstraintCardinality(constraint->id, constraint->list, intValues, varOccurs,
-                                             constraint->closed);
+        buildCardinality(constraint, intValues, varOccurs);
         return;
     }
     if(intValues.size() > 0 && intervalOccurs.size() > 0) {
-        callback->buildConstraintCardinality(constraint->id, constraint->list, intValues, intervalOccurs,
-                                             constraint->closed);
+        buildCardinality(constraint, intValues, intervalOccurs);
         return;
     }
     if(varValues.size() > 0 && intOccurs.size() > 0) {
-        callback->buildConstraintCardinality(constraint->id, constraint->list, varValues, intOccurs,
-                                             constraint->closed);
+        buildCardinality(constraint, varValues, intOccurs);
         return;
     }
     if(varValues.size() > 0 && varOccurs.size() > 0) {
-        callback->buildConstraintCardinality(constraint->id, constraint->list, varValues, varOccurs,
-                                             constraint->closed);
+        buildCardinality(constraint, varValues, varOccurs);
         return;
     }
     if(varValues.size() > 0 && intervalOccurs.size() > 0) {
-        callback->buildConstraintCardinality(constraint->id, constraint->list, varValues, intervalOccurs,
-                                             constraint->closed);
+        buildCardinality(constraint, varValues, intervalOccurs);
         return;
     }
 }
@@ -846,6 +1064,7 @@ void XCSP3Manager::newConstraintCardinality(XConstraintCardinality *constraint)
 
 
 void XCSP3Manager::newConstraintMinimum(XConstraintMinimum *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     XCondition xc;
@@ -855,17 +1074,18 @@ void XCSP3Manager::newConstraintMinimum(XConstraintMinimum *constraint) {
         vector<Tree *> trees;
         containsTrees(constraint->list, trees);
         if(trees.size() > 0)
-            callback->buildConstraintMinimum(constraint->id, trees, xc);
+            XCSP3_CALLBACK(callback, buildConstraintMinimum)(constraint->id, trees, xc);
         else
-            callback->buildConstraintMinimum(constraint->id, constraint->list, xc);
+            XCSP3_CALLBACK(callback, buildConstraintMinimum)(constraint->id, constraint->list, xc);
         return;
     }
-    callback->buildConstraintMinimum(constraint->id, constraint->list, constraint->index, constraint->startIndex,
-                                     constraint->rank, xc);
+    XCSP3_CALLBACK(callback, buildConstraintMinimum)(constraint->id, constraint->list, constraint->index, constraint->startIndex,
+                                                     constraint->rank, xc);
 }
 
 
 void XCSP3Manager::newConstraintMaximum(XConstraintMaximum *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     XCondition xc;
@@ -875,17 +1095,18 @@ void XCSP3Manager::newConstraintMaximum(XConstraintMaximum *constraint) {
         vector<Tree *> trees;
         containsTrees(constraint->list, trees);
         if(trees.size() > 0)
-            callback->buildConstraintMaximum(constraint->id, trees, xc);
+            XCSP3_CALLBACK(callback, buildConstraintMaximum)(constraint->id, trees, xc);
         else
-            callback->buildConstraintMaximum(constraint->id, constraint->list, xc);
+            XCSP3_CALLBACK(callback, buildConstraintMaximum)(constraint->id, constraint->list, xc);
         return;
     }
-    callback->buildConstraintMaximum(constraint->id, constraint->list, constraint->index, constraint->startIndex,
-                                     constraint->rank, xc);
+    XCSP3_CALLBACK(callback, buildConstraintMaximum)(constraint->id, constraint->list, constraint->index, constraint->startIndex,
+                                                     constraint->rank, xc);
 }
 
 
 void XCSP3Manager::newConstraintMinMaxArg(XConstraintMaximum *constraint, bool max) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     XCondition xc;
@@ -895,26 +1116,29 @@ void XCSP3Manager::newConstraintMinMaxArg(XConstraintMaximum *constraint, bool m
     containsTrees(constraint->list, trees);
     if(trees.size() > 0) {
         if(max)
-            callback->buildConstraintMaximumArg(constraint->id, trees, constraint->rank, xc);
+            XCSP3_CALLBACK(callback, buildConstraintMaximumArg)(constraint->id, trees, constraint->rank, xc);
         else
-            callback->buildConstraintMinimumArg(constraint->id, trees, constraint->rank, xc);
+            XCSP3_CALLBACK(callback, buildConstraintMinimumArg)(constraint->id, trees, constraint->rank, xc);
     } else {
         if(max)
-            callback->buildConstraintMaximumArg(constraint->id, constraint->list, constraint->rank, xc);
+            XCSP3_CALLBACK(callback, buildConstraintMaximumArg)(constraint->id, constraint->list, constraint->rank, xc);
         else
-            callback->buildConstraintMinimumArg(constraint->id, constraint->list, constraint->rank, xc);
+            XCSP3_CALLBACK(callback, buildConstraintMinimumArg)(constraint->id, constraint->list, constraint->rank, xc);
     }
 }
 
 void XCSP3Manager::newConstraintMinArg(XConstraintMaximum *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     newConstraintMinMaxArg(constraint, false);
 }
 
 void XCSP3Manager::newConstraintMaxArg(XConstraintMaximum *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     newConstraintMinMaxArg(constraint, true);
 }
 
 void XCSP3Manager::newConstraintElement(XConstraintElement *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     int v;
@@ -929,9 +1153,11 @@ void XCSP3Manager::newConstraintElement(XConstraintElement *constraint) {
         XCondition xc;
         constraint->extractCondition(xc);
         if(listOfIntegers.size() > 0)
-            callback->buildConstraintElement(constraint->id, listOfIntegers, constraint->index, constraint->startIndex, xc);
+            XCSP3_VIEW_CALLBACK(buildConstraintElement, (XStringView(constraint->id), XSpan<int>(listOfIntegers), constraint->index, constraint->startIndex, xc),
+                                (constraint->id, listOfIntegers, constraint->index, constraint->startIndex, xc));
         else
-        callback->buildConstraintElement(constraint->id, constraint->list, constraint->index, constraint->startIndex, xc);
+            XCSP3_VIEW_CALLBACK(buildConstraintElement, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), constraint->index, constraint->startIndex, xc),
+                                (constraint->id, constraint->list, constraint->index, constraint->startIndex, xc));
         return;
     }
 
@@ -940,13 +1166,15 @@ void XCSP3Manager::newConstraintElement(XConstraintElement *constraint) {
             if(listOfIntegers.size() > 0)
                 throw runtime_error("Not yet supported");
             else
-                callback->buildConstraintElement(constraint->id, constraint->list, v);
+                XCSP3_VIEW_CALLBACK(buildConstraintElement, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), v),
+                                    (constraint->id, constraint->list, v));
         } else {
             if(listOfIntegers.size() > 0)
-                callback->buildConstraintElement(constraint->id, listOfIntegers, constraint->startIndex, constraint->index, constraint->rank, v);
+                XCSP3_VIEW_CALLBACK(buildConstraintElement, (XStringView(constraint->id), XSpan<int>(listOfIntegers), constraint->startIndex, constraint->index, constraint->rank, v),
+                                    (constraint->id, listOfIntegers, constraint->startIndex, constraint->index, constraint->rank, v));
             else
-                callback->buildConstraintElement(constraint->id, constraint->list, constraint->startIndex,
-                                                 constraint->index, constraint->rank, v);
+                XCSP3_VIEW_CALLBACK(buildConstraintElement, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), constraint->startIndex, constraint->index, constraint->rank, v),
+                                    (constraint->id, constraint->list, constraint->startIndex, constraint->index, constraint->rank, v));
         }
         return;
     }
@@ -956,19 +1184,21 @@ void XCSP3Manager::newConstraintElement(XConstraintElement *constraint) {
         if(listOfIntegers.size() > 0)
             throw runtime_error("Not yet supported");
         else
-            callback->buildConstraintElement(constraint->id, constraint->list, xv);
+            XCSP3_VIEW_CALLBACK(buildConstraintElement, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), xv),
+                                (constraint->id, constraint->list, xv));
     } else {
         if(listOfIntegers.size() > 0)
-            callback->buildConstraintElement(constraint->id, listOfIntegers, constraint->startIndex,
-                                             constraint->index, constraint->rank, xv);
+            XCSP3_VIEW_CALLBACK(buildConstraintElement, (XStringView(constraint->id), XSpan<int>(listOfIntegers), constraint->startIndex, constraint->index, constraint->rank, xv),
+                                (constraint->id, listOfIntegers, constraint->startIndex, constraint->index, constraint->rank, xv));
         else
-            callback->buildConstraintElement(constraint->id, constraint->list, constraint->startIndex,
-                                             constraint->index, constraint->rank, xv);
+            XCSP3_VIEW_CALLBACK(buildConstraintElement, (XStringView(constraint->id), XSpan<XVariable *>(constraint->list), constraint->startIndex, constraint->index, constraint->rank, xv),
+                                (constraint->id, constraint->list, constraint->startIndex, constraint->index, constraint->rank, xv));
     }
 }
 
 
 void XCSP3Manager::newConstraintElementMatrix(XConstraintElementMatrix *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     int v;
@@ -984,11 +1214,11 @@ void XCSP3Manager::newConstraintElementMatrix(XConstraintElementMatrix *constrai
         if(constraint->value == nullptr) {
             XCondition xc;
             constraint->extractCondition(xc);
-            callback->buildConstraintElement(constraint->id, matrix, constraint->startRowIndex, constraint->index,
-                                             constraint->startColIndex, constraint->index2, xc);
+            XCSP3_CALLBACK(callback, buildConstraintElement)(constraint->id, matrix, constraint->startRowIndex, constraint->index,
+                                                             constraint->startColIndex, constraint->index2, xc);
         } else {
-            callback->buildConstraintElement(constraint->id, matrix, constraint->startRowIndex, constraint->index,
-                                 constraint->startColIndex, constraint->index2, constraint->value);
+            XCSP3_CALLBACK(callback, buildConstraintElement)(constraint->id, matrix, constraint->startRowIndex, constraint->index,
+                                                 constraint->startColIndex, constraint->index2, constraint->value);
         }
 
         return;
@@ -996,36 +1226,37 @@ void XCSP3Manager::newConstraintElementMatrix(XConstraintElementMatrix *constrai
     if (constraint->value == nullptr) {
         XCondition xc;
         constraint->extractCondition(xc);
-        callback->buildConstraintElement(constraint->id, constraint->matrix, constraint->startRowIndex, constraint->index,
-                                         constraint->startColIndex, constraint->index2, xc);
+        XCSP3_CALLBACK(callback, buildConstraintElement)(constraint->id, constraint->matrix, constraint->startRowIndex, constraint->index,
+                                                         constraint->startColIndex, constraint->index2, xc);
     } else
     {
         if(isInteger(constraint->value, v))
-            callback->buildConstraintElement(constraint->id, constraint->matrix, constraint->startRowIndex,
-                                             constraint->index, constraint->startColIndex, constraint->index2, v);
+            XCSP3_CALLBACK(callback, buildConstraintElement)(constraint->id, constraint->matrix, constraint->startRowIndex,
+                                                             constraint->index, constraint->startColIndex, constraint->index2, v);
         else
-            callback->buildConstraintElement(constraint->id, constraint->matrix, constraint->startRowIndex,
-                                             constraint->index, constraint->startColIndex, constraint->index2,
-                                            constraint->value);
+            XCSP3_CALLBACK(callback, buildConstraintElement)(constraint->id, constraint->matrix, constraint->startRowIndex,
+                                                             constraint->index, constraint->startColIndex, constraint->index2,
+                                                            constraint->value);
     }
 }
 
 
 void XCSP3Manager::newConstraintChannel(XConstraintChannel *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     if(constraint->secondList.size() == 0 && constraint->value == NULL) {
-        callback->buildConstraintChannel(constraint->id, constraint->list, constraint->startIndex1);
+        XCSP3_CALLBACK(callback, buildConstraintChannel)(constraint->id, constraint->list, constraint->startIndex1);
         return;
     }
 
     if(constraint->secondList.size() > 0 && constraint->value == NULL) {
-        callback->buildConstraintChannel(constraint->id, constraint->list, constraint->startIndex1,
-                                         constraint->secondList,
-                                         constraint->startIndex2);
+        XCSP3_CALLBACK(callback, buildConstraintChannel)(constraint->id, constraint->list, constraint->startIndex1,
+                                                         constraint->secondList,
+                                                         constraint->startIndex2);
         return;
     }
-    callback->buildConstraintChannel(constraint->id, constraint->list, constraint->startIndex1, constraint->value);
+    XCSP3_CALLBACK(callback, buildConstraintChannel)(constraint->id, constraint->list, constraint->startIndex1, constraint->value);
 }
 
 //--------------------------------------------------------------------------------------
@@ -1033,17 +1264,19 @@ void XCSP3Manager::newConstraintChannel(XConstraintChannel *constraint) {
 //--------------------------------------------------------------------------------------
 
 void XCSP3Manager::newConstraintStretch(XConstraintStretch *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     if(constraint->patterns.size() == 0)
-        callback->buildConstraintStretch(constraint->id, constraint->list, constraint->values, constraint->widths);
+        XCSP3_CALLBACK(callback, buildConstraintStretch)(constraint->id, constraint->list, constraint->values, constraint->widths);
     else
-        callback->buildConstraintStretch(constraint->id, constraint->list, constraint->values, constraint->widths,
-                                         constraint->patterns);
+        XCSP3_CALLBACK(callback, buildConstraintStretch)(constraint->id, constraint->list, constraint->values, constraint->widths,
+                                                         constraint->patterns);
 }
 
 
 void XCSP3Manager::newConstraintNoOverlap(XConstraintNoOverlap *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
 
@@ -1066,15 +1299,16 @@ void XCSP3Manager::newConstraintNoOverlap(XConstraintNoOverlap *constraint) {
     }
 
     if(intLengths.size() > 0)
-        callback->buildConstraintNoOverlap(constraint->id, constraint->origins, intLengths,
-                                           constraint->zeroIgnored);
+        XCSP3_CALLBACK(callback, buildConstraintNoOverlap)(constraint->id, constraint->origins, intLengths,
+                                                           constraint->zeroIgnored);
     else
-        callback->buildConstraintNoOverlap(constraint->id, constraint->origins, varLengths,
-                                           constraint->zeroIgnored);
+        XCSP3_CALLBACK(callback, buildConstraintNoOverlap)(constraint->id, constraint->origins, varLengths,
+                                                           constraint->zeroIgnored);
 }
 
 
 void XCSP3Manager::newConstraintNoOverlapKDim(XConstraintNoOverlap *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
 
@@ -1104,7 +1338,7 @@ void XCSP3Manager::newConstraintNoOverlapKDim(XConstraintNoOverlap *constraint)
             vL.push_back(tmp);
             iL.push_back(v);
         }
-        callback->buildConstraintNoOverlap(constraint->id, origins, vL, iL, constraint->zeroIgnored);
+        XCSP3_CALLBACK(callback, buildConstraintNoOverlap)(constraint->id, origins, vL, iL, constraint->zeroIgnored);
         return;
     }
 
@@ -1127,13 +1361,14 @@ void XCSP3Manager::newConstraintNoOverlapKDim(XConstraintNoOverlap *constraint)
 
 
     if(isInt)
-        callback->buildConstraintNoOverlap(constraint->id, origins, intLengths, constraint->zeroIgnored);
+        XCSP3_CALLBACK(callback, buildConstraintNoOverlap)(constraint->id, origins, intLengths, constraint->zeroIgnored);
     else
-        callback->buildConstraintNoOverlap(constraint->id, origins, varLengths, constraint->zeroIgnored);
+        XCSP3_CALLBACK(callback, buildConstraintNoOverlap)(constraint->id, origins, varLengths, constraint->zeroIgnored);
 }
 
 
 void XCSP3Manager::newConstraintCumulative(XConstraintCumulative *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     int v;
@@ -1165,31 +1400,32 @@ void XCSP3Manager::newConstraintCumulative(XConstraintCumulative *constraint) {
 
     if(constraint->ends.size() == 0) {
         if(intLengths.size() > 0 && intHeights.size() > 0)
-            callback->buildConstraintCumulative(constraint->id, constraint->origins, intLengths, intHeights, xc);
+            XCSP3_CALLBACK(callback, buildConstraintCumulative)(constraint->id, constraint->origins, intLengths, intHeights, xc);
         if(intLengths.size() > 0 && varHeights.size() > 0)
-            callback->buildConstraintCumulative(constraint->id, constraint->origins, intLengths, varHeights, xc);
+            XCSP3_CALLBACK(callback, buildConstraintCumulative)(constraint->id, constraint->origins, intLengths, varHeights, xc);
         if(varLengths.size() > 0 && intHeights.size() > 0)
-            callback->buildConstraintCumulative(constraint->id, constraint->origins, varLengths, intHeights, xc);
+            XCSP3_CALLBACK(callback, buildConstraintCumulative)(constraint->id, constraint->origins, varLengths, intHeights, xc);
         if(varLengths.size() > 0 && varHeights.size() > 0)
-            callback->buildConstraintCumulative(constraint->id, constraint->origins, varLengths, varHeights, xc);
+            XCSP3_CALLBACK(callback, buildConstraintCumulative)(constraint->id, constraint->origins, varLengths, varHeights, xc);
         return;
     }
     if(intLengths.size() > 0 && intHeights.size() > 0)
-        callback->buildConstraintCumulative(constraint->id, constraint->origins, intLengths, intHeights,
-                                            constraint->ends, xc);
+        XCSP3_CALLBACK(callback, buildConstraintCumulative)(constraint->id, constraint->origins, intLengths, intHeights,
+                                                            constraint->ends, xc);
     if(intLengths.size() > 0 && varHeights.size() > 0)
-        callback->buildConstraintCumulative(constraint->id, constraint->origins, intLengths, varHeights,
-                                            constraint->ends, xc);
+        XCSP3_CALLBACK(callback, buildConstraintCumulative)(constraint->id, constraint->origins, intLengths, varHeights,
+                                                            constraint->ends, xc);
     if(varLengths.size() > 0 && intHeights.size() > 0)
-        callback->buildConstraintCumulative(constraint->id, constraint->origins, varLengths, intHeights,
-                                            constraint->ends, xc);
+        XCSP3_CALLBACK(callback, buildConstraintCumulative)(constraint->id, constraint->origins, varLengths, intHeights,
+                                                            constraint->ends, xc);
     if(varLengths.size() > 0 && varHeights.size() > 0)
-        callback->buildConstraintCumulative(constraint->id, constraint->origins, varLengths, varHeights,
-                                            constraint->ends, xc);
+        XCSP3_CALLBACK(callback, buildConstraintCumulative)(constraint->id, constraint->origins, varLengths, varHeights,
+                                                            constraint->ends, xc);
 }
 
 // if loads=true, capacities are loads (operator =), otherwise capacities are limits (operator <=)
 void XCSP3Manager::newConstraintBinPacking(XConstraintBinPacking *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     int v;
@@ -1216,9 +1452,9 @@ void XCSP3Manager::newConstraintBinPacking(XConstraintBinPacking *constraint) {
         if(capacitiesVars.size() > 0 && capacitiesInt.size() > 0)
             throw runtime_error("In bickpacking, limits must all have the same type");
         if(capacitiesInt.size() > 0)
-            callback->buildConstraintBinPacking(constraint->id, constraint->list, sizes, capacitiesInt, false);
+            XCSP3_CALLBACK(callback, buildConstraintBinPacking)(constraint->id, constraint->list, sizes, capacitiesInt, false);
         else
-            callback->buildConstraintBinPacking(constraint->id, constraint->list, sizes, capacitiesVars, false);
+            XCSP3_CALLBACK(callback, buildConstraintBinPacking)(constraint->id, constraint->list, sizes, capacitiesVars, false);
         return;
     }
 
@@ -1234,9 +1470,9 @@ void XCSP3Manager::newConstraintBinPacking(XConstraintBinPacking *constraint) {
         if(capacitiesVars.size() > 0 && capacitiesInt.size() > 0)
             throw runtime_error("In bickpacking, loads must all have the same type");
         if(capacitiesInt.size() > 0)
-            callback->buildConstraintBinPacking(constraint->id, constraint->list, sizes, capacitiesInt, true);
+            XCSP3_CALLBACK(callback, buildConstraintBinPacking)(constraint->id, constraint->list, sizes, capacitiesInt, true);
         else
-            callback->buildConstraintBinPacking(constraint->id, constraint->list, sizes, capacitiesVars, true);
+            XCSP3_CALLBACK(callback, buildConstraintBinPacking)(constraint->id, constraint->list, sizes, capacitiesVars, true);
         return;
     }
     constraint->conditions = trim(constraint->conditions);
@@ -1252,14 +1488,14 @@ void XCSP3Manager::newConstraintBinPacking(XConstraintBinPacking *constraint) {
                 current = "";
             }
         }
-        callback->buildConstraintBinPacking(constraint->id, constraint->list, sizes, conditions, constraint->startIndex);
+        XCSP3_CALLBACK(callback, buildConstraintBinPacking)(constraint->id, constraint->list, sizes, conditions, constraint->startIndex);
         return;
     }
 
 
     XCondition xc;
     constraint->extractCondition(xc);
-    callback->buildConstraintBinPacking(constraint->id, constraint->list, sizes, xc);
+    XCSP3_CALLBACK(callback, buildConstraintBinPacking)(constraint->id, constraint->list, sizes, xc);
 }
 
 //--------------------------------------------------------------------------------------
@@ -1267,6 +1503,7 @@ void XCSP3Manager::newConstraintBinPacking(XConstraintBinPacking *constraint) {
 //--------------------------------------------------------------------------------------
 
 void XCSP3Manager::newConstraintInstantiation(XConstraintInstantiation *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
     vector<int> values;
@@ -1275,7 +1512,7 @@ void XCSP3Manager::newConstraintInstantiation(XConstraintInstantiation *constrai
         isInteger(xe, v);
         values.push_back(v);
     }
-    callback->buildConstraintInstantiation(constraint->id, constraint->list, values);
+    XCSP3_CALLBACK(callback, buildConstraintInstantiation)(constraint->id, constraint->list, values);
 }
 
 //--------------------------------------------------------------------------------------
@@ -1283,9 +1520,10 @@ void XCSP3Manager::newConstraintInstantiation(XConstraintInstantiation *constrai
 //--------------------------------------------------------------------------------------
 
 void XCSP3Manager::newConstraintClause(XConstraintClause *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
-    callback->buildConstraintClause(constraint->id, constraint->positive, constraint->negative);
+    XCSP3_CALLBACK(callback, buildConstraintClause)(constraint->id, constraint->positive, constraint->negative);
 }
 
 
@@ -1294,18 +1532,19 @@ void XCSP3Manager::newConstraintClause(XConstraintClause *constraint) {
 //--------------------------------------------------------------------------------------
 
 void XCSP3Manager::newConstraintCircuit(XConstraintCircuit *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
 
     if(constraint->value == nullptr)
-        callback->buildConstraintCircuit(constraint->id, constraint->list, constraint->startIndex);
+        XCSP3_CALLBACK(callback, buildConstraintCircuit)(constraint->id, constraint->list, constraint->startIndex);
     else {
         int value;
         if(isInteger(constraint->value, value))
-            callback->buildConstraintCircuit(constraint->id, constraint->list, constraint->startIndex, value);
+            XCSP3_CALLBACK(callback, buildConstraintCircuit)(constraint->id, constraint->list, constraint->startIndex, value);
         else
-            callback->buildConstraintCircuit(constraint->id, constraint->list, constraint->startIndex,
-                                             (XVariable *) constraint->value);
+            XCSP3_CALLBACK(callback, buildConstraintCircuit)(constraint->id, constraint->list, constraint->startIndex,
+                                                             (XVariable *) constraint->value);
     }
 
 }
@@ -1316,6 +1555,7 @@ void XCSP3Manager::newConstraintCircuit(XConstraintCircuit *constraint) {
 //--------------------------------------------------------------------------------------
 
 void XCSP3Manager::newConstraintPrecedence(XConstraintPrecedence *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
 
@@ -1326,9 +1566,9 @@ void XCSP3Manager::newConstraintPrecedence(XConstraintPrecedence *constraint) {
         values.push_back(v);
     }
     if(values.empty())
-        callback->buildConstraintPrecedence(constraint->id, constraint->list, constraint->covered);
+        XCSP3_CALLBACK(callback, buildConstraintPrecedence)(constraint->id, constraint->list, constraint->covered);
     else
-        callback->buildConstraintPrecedence(constraint->id, constraint->list, values, constraint->covered);
+        XCSP3_CALLBACK(callback, buildConstraintPrecedence)(constraint->id, constraint->list, values, constraint->covered);
 }
 
 
@@ -1337,6 +1577,7 @@ void XCSP3Manager::newConstraintPrecedence(XConstraintPrecedence *constraint) {
 //--------------------------------------------------------------------------------------
 
 void XCSP3Manager::newConstraintFlow(XConstraintFlow *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
 
@@ -1352,7 +1593,7 @@ void XCSP3Manager::newConstraintFlow(XConstraintFlow *constraint) {
     }
     XCondition xc;
     constraint->extractCondition(xc);
-    callback->buildConstraintFlow(constraint->id, constraint->list, balance, weights, constraint->arcs, xc);
+    XCSP3_CALLBACK(callback, buildConstraintFlow)(constraint->id, constraint->list, balance, weights, constraint->arcs, xc);
 }
 
 
@@ -1361,6 +1602,7 @@ void XCSP3Manager::newConstraintFlow(XConstraintFlow *constraint) {
 //--------------------------------------------------------------------------------------
 
 void XCSP3Manager::newConstraintKnapsack(XConstraintKnapsack *constraint) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(discardedClasses(constraint->classes))
         return;
 
@@ -1379,7 +1621,7 @@ void XCSP3Manager::newConstraintKnapsack(XConstraintKnapsack *constraint) {
 
     XCSP3Core::XConstraintKnapsack::extract(weightsCondition, constraint->condition);
     XCSP3Core::XConstraintKnapsack::extract(profitsCondition, c->profitCondition.condition);
-    callback->buildConstraintKnapsack(constraint->id, constraint->list, weights, profits, weightsCondition, profitsCondition);
+    XCSP3_CALLBACK(callback, buildConstraintKnapsack)(constraint->id, constraint->list, weights, profits, weightsCondition, profitsCondition);
 }
 
 
@@ -1389,27 +1631,278 @@ void XCSP3Manager::newConstraintKnapsack(XConstraintKnapsack *constraint) {
 //--------------------------------------------------------------------------------------
 
 
+// Below this number of constraints, a group is unfolded sequentially
+#define MIN_PARALLEL_GROUP 4096
+// Number of constraints unfolded by a thread each time it takes work
+#define UNFOLD_BATCH 64
+// Number of unfolded batches, per thread, that can wait for their callbacks
+#define UNFOLD_WINDOW 8
+
+/**
+ * Unfolds the constraints of a group on a pool of threads (see XCSP3CoreCallbacks::unfoldThreads).
+ * Each idle thread takes the next batch of constraints, a slow batch (long expressions...) does not hold the others.
+ * If the callbacks are not thread safe, the constraints wait in their batch until the parsing thread gives them to
+ * the callbacks, in the order of the group; threads do not take batches too far ahead of it, this bounds the memory.
+ * The first exception (from unfolding or from a callback) stops the threads and is rethrown by run.
+ */
+class XCSP3GroupUnfolder {
+    int nbRows, nbBatches;
+    bool ordered;                                    // callbacks called by the parsing thread, in the order of the group
+    std::function<XConstraint *(int)> unfold;       // builds the ith constraint
+    std::function<void(XConstraint *)> deliver;     // gives it to the callbacks
+    std::vector<std::unique_ptr<XConstraint>> rows; // unfolded constraints that wait for their callbacks
+    std::vector<int> lastRows;                      // for each batch, its end (or the constraint that threw)
+    std::vector<std::exception_ptr> errors;         // for each batch
+    std::vector<bool> done;
+    int next, finished, delivered, window;   // batches taken, unfolded and delivered
+    bool stopping;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::thread> threads;
+
+
+    void work() {
+        unfoldingThread = true;
+        for(;;) {
+            int b;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [this] {
+                    return stopping || next == nbBatches || ordered == false || next < delivered + window;
+                });
+                if(stopping || next == nbBatches)
+                    return;
+                b = next++;
+            }
+            int i = b * UNFOLD_BATCH;
+            try {
+                for(; i < lastRows[b]; i++) {
+                    std::unique_ptr<XConstraint> constraint(unfold(i));
+                    if(ordered)
+                        rows[i] = std::move(constraint);
+                    else
+                        deliver(constraint.get());
+                }
+            } catch(...) {
+                errors[b] = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                lastRows[b] = i;
+                done[b] = true;
+                finished++;
+                if(errors[b])
+                    stopping = true; // the batches already taken are ended, the ordered delivery needs them
+            }
+            changed.notify_all();
+        }
+    }
+
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        for(std::thread &thread : threads)
+            if(thread.joinable())
+                thread.join();
+    }
+
+
+public :
+    XCSP3GroupUnfolder(int n, int nbThreads, bool o, std::function<XConstraint *(int)> u, std::function<void(XConstraint *)> d)
+            : nbRows(n), nbBatches((n + UNFOLD_BATCH - 1) / UNFOLD_BATCH), ordered(o), unfold(u), deliver(d),
+              errors(nbBatches), done(nbBatches, false), next(0), finished(0), delivered(0), window(nbThreads * UNFOLD_WINDOW),
+              stopping(false) {
+        if(ordered)
+            rows.resize(nbRows);
+        for(int b = 0; b < nbBatches; b++)
+            lastRows.push_back(std::min(nbRows, (b + 1) * UNFOLD_BATCH));
+        for(int t = 0; t < nbThreads; t++)
+            threads.emplace_back(&XCSP3GroupUnfolder::work, this);
+    }
+
+
+    ~XCSP3GroupUnfolder() { stop(); }
+
+
+    void run() {
+        if(ordered) {
+            for(int b = 0; b < nbBatches; b++) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [this, b] { return done[b]; });
+                }
+                for(int i = b * UNFOLD_BATCH; i < lastRows[b]; i++) {
+                    deliver(rows[i].get());
+                    rows[i].reset();
+                }
+                if(errors[b])
+                    std::rethrow_exception(errors[b]);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    delivered++;
+                }
+                changed.notify_all();
+            }
+        } else {
+            // Wait for the batches taken (all of them unless one threw)
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return finished == next && (stopping || next == nbBatches); });
+        }
+        stop();
+        for(std::exception_ptr &error : errors)
+            if(error)
+                std::rethrow_exception(error);
+    }
+};
+
+
 template<class T>
 void XCSP3Manager::unfoldConstraint(XConstraintGroup *group, int i, void (XCSP3Manager::*newConstraint)(T *)) {
-    T *constraint = new T(group->constraint->id, group->constraint->classes);
-    group->unfoldArgumentNumber(i, constraint);
-    (this->*newConstraint)(constraint);
-    delete constraint;
+    // Freed even if a callback throws (the parsing is then stopped)
+    std::unique_ptr<T> constraint(new T(group->constraint->id, group->constraint->classes));
+    group->unfoldArgumentNumber(i, constraint.get());
+    (this->*newConstraint)(constraint.get());
+}
+
+
+void XCSP3Manager::prepareUnfolded(XConstraintIntension *constraint) {
+    // Same conditions as in newConstraintIntension
+    if(callback->intensionUsingString || (callback->skip & SKIP_INTENSIONS) || discardedClasses(constraint->classes))
+        return;
+    constraint->tree = new Tree(constraint->function);
+    constraint->tree->canonize();
+}
+
+
+template<class T>
+void XCSP3Manager::unfoldConstraintsInParallel(XConstraintGroup *group, void (XCSP3Manager::*newConstraint)(T *)) {
+    XCSP3GroupUnfolder unfolder(
+            static_cast<int>(group->arguments.size()), callback->unfoldThreads, callback->threadSafeCallbacks == false,
+            [this, group](int i) -> XConstraint * {
+                std::unique_ptr<T> constraint(new T(group->constraint->id, group->constraint->classes));
+                group->unfoldArgumentNumber(i, constraint.get());
+                prepareUnfolded(constraint.get());
+                return constraint.release();
+            },
+            [this, newConstraint](XConstraint *constraint) { (this->*newConstraint)(static_cast<T *>(constraint)); });
+    unfolder.run();
+}
+
+
+bool XCSP3Manager::unfoldGroupInParallel(XConstraintGroup *group) {
+    if(callback->unfoldThreads <= 1 || group->arguments.size() < MIN_PARALLEL_GROUP)
+        return false;
+    switch(group->type) {
+        case INTENSION:
+            unfoldConstraintsInParallel<XConstraintIntension>(group, &XCSP3Manager::newConstraintIntension);
+            return true;
+        case CLAUSE:
+            unfoldConstraintsInParallel<XConstraintClause>(group, &XCSP3Manager::newConstraintClause);
+            return true;
+        case INSTANTIATION:
+            unfoldConstraintsInParallel<XConstraintInstantiation>(group, &XCSP3Manager::newConstraintInstantiation);
+            return true;
+        case ALLDIFF:
+            unfoldConstraintsInParallel<XConstraintAllDiff>(group, &XCSP3Manager::newConstraintAllDiff);
+            return true;
+        case ALLEQUAL:
+            unfoldConstraintsInParallel<XConstraintAllEqual>(group, &XCSP3Manager::newConstraintAllEqual);
+            return true;
+        case SUM:
+            unfoldConstraintsInParallel<XConstraintSum>(group, &XCSP3Manager::newConstraintSum);
+            return true;
+        case ORDERED:
+            unfoldConstraintsInParallel<XConstraintOrdered>(group, &XCSP3Manager::newConstraintOrdered);
+            return true;
+        case COUNT:
+            unfoldConstraintsInParallel<XConstraintCount>(group, &XCSP3Manager::newConstraintCount);
+            return true;
+        case NVALUES:
+            unfoldConstraintsInParallel<XConstraintNValues>(group, &XCSP3Manager::newConstraintNValues);
+            return true;
+        case CARDINALITY:
+            unfoldConstraintsInParallel<XConstraintCardinality>(group, &XCSP3Manager::newConstraintCardinality);
+            return true;
+        case MAXIMUM:
+            unfoldConstraintsInParallel<XConstraintMaximum>(group, &XCSP3Manager::newConstraintMaximum);
+            return true;
+        case MINIMUM:
+            unfoldConstraintsInParallel<XConstraintMinimum>(group, &XCSP3Manager::newConstraintMinimum);
+            return true;
+        case ELEMENT:
+            unfoldConstraintsInParallel<XConstraintElement>(group, &XCSP3Manager::newConstraintElement);
+            return true;
+        case ELEMENTMATRIX:
+            unfoldConstraintsInParallel<XConstraintElementMatrix>(group, &XCSP3Manager::newConstraintElementMatrix);
+            return true;
+        case NOOVERLAP:
+            unfoldConstraintsInParallel<XConstraintNoOverlap>(group, &XCSP3Manager::newConstraintNoOverlap);
+            return true;
+        case STRETCH:
+            unfoldConstraintsInParallel<XConstraintStretch>(group, &XCSP3Manager::newConstraintStretch);
+            return true;
+        case LEX:
+            unfoldConstraintsInParallel<XConstraintLex>(group, &XCSP3Manager::newConstraintLex);
+            return true;
+        case CHANNEL:
+            unfoldConstraintsInParallel<XConstraintChannel>(group, &XCSP3Manager::newConstraintChannel);
+            return true;
+        case CIRCUIT:
+            unfoldConstraintsInParallel<XConstraintCircuit>(group, &XCSP3Manager::newConstraintCircuit);
+            return true;
+        case CUMULATIVE:
+            unfoldConstraintsInParallel<XConstraintCumulative>(group, &XCSP3Manager::newConstraintCumulative);
+            return true;
+        case FLOW:
+            unfoldConstraintsInParallel<XConstraintFlow>(group, &XCSP3Manager::newConstraintFlow);
+            return true;
+        case BINPACKING:
+            unfoldConstraintsInParallel<XConstraintBinPacking>(group, &XCSP3Manager::newConstraintBinPacking);
+            return true;
+        case KNAPSACK:
+            unfoldConstraintsInParallel<XConstraintKnapsack>(group, &XCSP3Manager::newConstraintKnapsack);
+            return true;
+        case MAXARG:
+            unfoldConstraintsInParallel<XConstraintMaximum>(group, &XCSP3Manager::newConstraintMaxArg);
+            return true;
+        case MINARG:
+            unfoldConstraintsInParallel<XConstraintMaximum>(group, &XCSP3Manager::newConstraintMinArg);
+            return true;
+        case PRECEDENCE:
+            unfoldConstraintsInParallel<XConstraintPrecedence>(group, &XCSP3Manager::newConstraintPrecedence);
+            return true;
+        default: // extension, regular and mdd constraints depend on the previous one of the group
+            return false;
+    }
 }
 
 
 void XCSP3Manager::newConstraintGroup(XConstraintGroup *group) {
-    if(discardedClasses(group->classes))
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
+    // Nothing is unfolded if the constraints of the group are discarded
+    if(discardedClasses(group->classes) || (group->constraint != nullptr && discardedClasses(group->constraint->classes)))
         return;
     vector<XVariable *> previousArguments; // Used to check if extension arguments have same domains
+    bool sameAutomaton = false;            // Used by regular constraints without parameters in start and final states
+    int start = -1;
+    vector<int> final;
     callback->_arguments = &(group->arguments);
+    callback->groupArguments(group->id, group->arguments);
+    if(unfoldGroupInParallel(group)) {
+        callback->_arguments = nullptr;
+        return;
+    }
 
     for(unsigned int i = 0; i < group->arguments.size(); i++) {
         if(group->type == INTENSION)
             unfoldConstraint<XConstraintIntension>(group, i, &XCSP3Manager::newConstraintIntension);
         if(group->type == EXTENSION) {
-            XConstraintExtension *ce = new XConstraintExtension(group->constraint->id, group->constraint->classes);
-            group->unfoldArgumentNumber(i, ce);
+            std::unique_ptr<XConstraintExtension> ce(new XConstraintExtension(group->constraint->id, group->constraint->classes));
+            group->unfoldArgumentNumber(i, ce.get());
 
             if(i > 0) {
                 // Check previous arguments
@@ -1425,7 +1918,7 @@ void XCSP3Manager::newConstraintGroup(XConstraintGroup *group) {
 
 
             if(i > 0 && previousArguments.size() > 0)
-                newConstraintExtensionAsLastOne(ce);
+                newConstraintExtensionAsLastOne(ce.get());
             else {
                 vector<XVariable *> list;
                 list.assign(group->constraint->list.begin(), group->constraint->list.end());
@@ -1434,7 +1927,6 @@ void XCSP3Manager::newConstraintGroup(XConstraintGroup *group) {
                 newConstraintExtension((XConstraintExtension *) group->constraint);
                 group->constraint->list.assign(list.begin(), list.end());
             }
-            delete ce;
         }
 
         if(group->type == CLAUSE)
@@ -1471,10 +1963,31 @@ void XCSP3Manager::newConstraintGroup(XConstraintGroup *group) {
             unfoldConstraint<XConstraintLex>(group, i, &XCSP3Manager::newConstraintLex);
         if(group->type == CHANNEL)
             unfoldConstraint<XConstraintChannel>(group, i, &XCSP3Manager::newConstraintChannel);
-        if(group->type == REGULAR)
-            unfoldConstraint<XConstraintRegular>(group, i, &XCSP3Manager::newConstraintRegular);
-        if(group->type == MDD)
-            unfoldConstraint<XConstraintMDD>(group, i, &XCSP3Manager::newConstraintMDD);
+        if(group->type == REGULAR) {
+            XConstraintRegular *original = (XConstraintRegular *) group->constraint;
+            if(i == 0) {
+                sameAutomaton = original->hasParameters() == false;
+                if(sameAutomaton) {
+                    start = original->automaton->state(original->start);
+                    for(string &f : original->final)
+                        final.push_back(original->automaton->state(f));
+                }
+            }
+            if(i > 0 && sameAutomaton) {
+                // Only the scope changes: the automaton is shared with the previous constraint
+                std::unique_ptr<XConstraintRegular> cr(new XConstraintRegular(original->id, original->classes));
+                cr->XConstraint::unfoldParameters(group, group->arguments[i], original);
+                cr->automaton = original->automaton;
+                newConstraintRegularAsLastOne(cr.get(), start, final);
+            } else
+                unfoldConstraint<XConstraintRegular>(group, i, &XCSP3Manager::newConstraintRegular);
+        }
+        if(group->type == MDD) {
+            if(i > 0)
+                unfoldConstraint<XConstraintMDD>(group, i, &XCSP3Manager::newConstraintMDDAsLastOne);
+            else
+                unfoldConstraint<XConstraintMDD>(group, i, &XCSP3Manager::newConstraintMDD);
+        }
         if(group->type == CIRCUIT)
             unfoldConstraint<XConstraintCircuit>(group, i, &XCSP3Manager::newConstraintCircuit);
         if(group->type == CUMULATIVE)
@@ -1501,19 +2014,20 @@ void XCSP3Manager::newConstraintGroup(XConstraintGroup *group) {
 
 
 void XCSP3Manager::addObjective(XObjective *objective) {
+    XCSP3_PROFILE_SCOPE(PROFILE_CONSTRAINT, __func__);
     if(objective->type == EXPRESSION_O) {
         XVariable *x = (XVariable *) mapping[objective->expression];
         if(x != NULL) {
             if(objective->goal == MINIMIZE)
-                callback->buildObjectiveMinimizeVariable(x);
+                XCSP3_CALLBACK(callback, buildObjectiveMinimizeVariable)(x);
             else
-                callback->buildObjectiveMaximizeVariable(x);
+                XCSP3_CALLBACK(callback, buildObjectiveMaximizeVariable)(x);
             return;
         }
         if(objective->goal == MINIMIZE)
-            callback->buildObjectiveMinimizeExpression(objective->expression);
+            XCSP3_VIEW_CALLBACK(buildObjectiveMinimizeExpression, (XStringView(objective->expression)), (objective->expression));
         else
-            callback->buildObjectiveMaximizeExpression(objective->expression);
+            XCSP3_VIEW_CALLBACK(buildObjectiveMaximizeExpression, (XStringView(objective->expression)), (objective->expression));
         return;
     }
 
@@ -1539,22 +2053,22 @@ void XCSP3Manager::addObjective(XObjective *objective) {
     if(trees.size() > 0) { // alldif over tree
         if(objective->coeffs.size() == 0) {
             if(objective->goal == MINIMIZE)
-                callback->buildObjectiveMinimize(objective->type, trees);
+                XCSP3_CALLBACK(callback, buildObjectiveMinimize)(objective->type, trees);
             else
-                callback->buildObjectiveMaximize(objective->type, trees);
+                XCSP3_CALLBACK(callback, buildObjectiveMaximize)(objective->type, trees);
             return;
         }
         if(objective->goal == MINIMIZE) {
             if(intcoeffs.size() > 0)
-                callback->buildObjectiveMinimize(objective->type, trees, intcoeffs);
+                XCSP3_CALLBACK(callback, buildObjectiveMinimize)(objective->type, trees, intcoeffs);
             else
-                callback->buildObjectiveMinimize(objective->type, trees, varcoeffs);
+                XCSP3_CALLBACK(callback, buildObjectiveMinimize)(objective->type, trees, varcoeffs);
         }
         else {
             if(intcoeffs.size() > 0)
-                callback->buildObjectiveMaximize(objective->type, trees, intcoeffs);
+                XCSP3_CALLBACK(callback, buildObjectiveMaximize)(objective->type, trees, intcoeffs);
             else
-                callback->buildObjectiveMaximize(objective->type, trees, varcoeffs);
+                XCSP3_CALLBACK(callback, buildObjectiveMaximize)(objective->type, trees, varcoeffs);
         }
         return;
     }
@@ -1562,13 +2076,8 @@ void XCSP3Manager::addObjective(XObjective *objective) {
 
     if(objective->type == SUM_O && (intcoeffs.size() > 0 || (objective->coeffs.size() == 0)) &&  callback->normalizeSum) {
         if(objective->coeffs.size() == 0) {
-            bool toModify = false;
             // Check if a variable appears two times
-            for(unsigned int i = 0; i < objective->list.size() - 1; i++)
-                for(auto j = i + 1; j < objective->list.size(); j++) {
-                    if(objective->list[i]->id == objective->list[j]->id)
-                        toModify = true;
-                }
+            bool toModify = containsDuplicates(objective->list);
             if(toModify)
                 intcoeffs.assign(objective->list.size(), 1);
         }
@@ -1578,22 +2087,22 @@ void XCSP3Manager::addObjective(XObjective *objective) {
 
     if(objective->coeffs.size() == 0) {
         if(objective->goal == MINIMIZE)
-            callback->buildObjectiveMinimize(objective->type, objective->list);
+            XCSP3_CALLBACK(callback, buildObjectiveMinimize)(objective->type, objective->list);
         else
-            callback->buildObjectiveMaximize(objective->type, objective->list);
+            XCSP3_CALLBACK(callback, buildObjectiveMaximize)(objective->type, objective->list);
         return;
     }
     if(objective->goal == MINIMIZE) {
         if(intcoeffs.size() > 0)
-            callback->buildObjectiveMinimize(objective->type, objective->list, intcoeffs);
+            XCSP3_CALLBACK(callback, buildObjectiveMinimize)(objective->type, objective->list, intcoeffs);
         else
-            callback->buildObjectiveMinimize(objective->type, objective->list, varcoeffs);
+            XCSP3_CALLBACK(callback, buildObjectiveMinimize)(objective->type, objective->list, varcoeffs);
 
     } else {
         if(intcoeffs.size() > 0)
-            callback->buildObjectiveMaximize(objective->type, objective->list, intcoeffs);
+            XCSP3_CALLBACK(callback, buildObjectiveMaximize)(objective->type, objective->list, intcoeffs);
         else
-            callback->buildObjectiveMaximize(objective->type, objective->list, varcoeffs);
+            XCSP3_CALLBACK(callback, buildObjectiveMaximize)(objective->type, objective->list, varcoeffs);
 
     }
 }
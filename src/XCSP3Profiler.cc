@@ -0,0 +1,84 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#include "XCSP3Profiler.h"
+
+#ifdef XCSP3_PROFILE
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+using namespace XCSP3Core;
+
+
+XCSP3Profiler &XCSP3Profiler::instance() {
+    static XCSP3Profiler profiler;
+    return profiler;
+}
+
+
+void XCSP3Profiler::record(Category category, const std::string &name, double seconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry &e = entries[std::make_pair(static_cast<int>(category), name)];
+    e.calls++;
+    e.total += seconds;
+    if(seconds > e.max)
+        e.max = seconds;
+}
+
+
+void XCSP3Profiler::addBytes(Category category, const std::string &name, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[std::make_pair(static_cast<int>(category), name)].bytes += bytes;
+}
+
+
+void XCSP3Profiler::report(std::ostream &out) {
+    static const char *titles[] = {"tags", "constraints (manager)", "callbacks"};
+    std::lock_guard<std::mutex> lock(mutex);
+    char line[256];
+    for(int category = PROFILE_TAG ; category <= PROFILE_CALLBACK ; category++) {
+        std::vector<std::pair<std::string, Entry> > sorted;
+        for(auto &e : entries)
+            if(e.first.first == category)
+                sorted.push_back(std::make_pair(e.first.second, e.second));
+        if(sorted.empty())
+            continue;
+        std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, Entry> &a, const std::pair<std::string, Entry> &b) {
+            return a.second.total > b.second.total;
+        });
+        out << "c profile " << titles[category] << std::endl;
+        std::snprintf(line, sizeof(line), "c   %-40s %10s %12s %12s %12s\n", "name", "calls", "total(ms)", "max(ms)", "bytes");
+        out << line;
+        for(auto &e : sorted) {
+            std::snprintf(line, sizeof(line), "c   %-40s %10llu %12.3f %12.3f %12llu\n", e.first.c_str(), e.second.calls,
+                          e.second.total * 1000, e.second.max * 1000, e.second.bytes);
+            out << line;
+        }
+    }
+    entries.clear();
+}
+
+#endif
@@ -0,0 +1,2436 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#include "XCSP3SolutionChecker.h"
+#include <algorithm>
+#include <climits>
+#include <sstream>
+#include <thread>
+
+using namespace XCSP3Core;
+
+// Below this number of constraints per thread, checking is sequential
+#define MIN_CONSTRAINTS_PER_THREAD 8192
+// Below this number of rows per thread, batch checking is sequential
+#define MIN_ROWS_PER_THREAD 256
+// Extension tables are indexed by a bitset if their cartesian product is smaller than this
+#define MAX_TUPLES_BITSET (1 << 24)
+
+namespace XCSP3Core {
+
+    static bool compare(long long a, OrderType op, long long b) {
+        switch(op) {
+            case LE :
+                return a <= b;
+            case LT :
+                return a < b;
+            case GE :
+                return a >= b;
+            case GT :
+                return a > b;
+            case EQ :
+                return a == b;
+            case NE :
+                return a != b;
+            default :
+                throw runtime_error("checker: bad operator");
+        }
+    }
+
+
+    static bool isSupported(ExpressionType op) {
+        switch(op) {
+            case ONEG : case OABS : case OSQR : case ONOT : case OSUB : case ODIV : case OMOD : case OPOW : case ODIST :
+            case OLT : case OLE : case OGE : case OGT : case ONE : case OIMP : case OIF : case OADD : case OMUL : case OMIN :
+            case OMAX : case OEQ : case OAND : case OOR : case OXOR : case OIFF : case OIN : case ONOTIN :
+                return true;
+            default :
+                return false;
+        }
+    }
+
+
+    /*
+     * Arithmetic in long long: an overflow, a division by zero or a negative exponent makes the
+     * expression undefined (XCheckerUndefined), and the constraint is violated.
+     */
+
+    static long long checkedNeg(long long a) {
+        if(a == LLONG_MIN)
+            throw XCheckerUndefined("overflow");
+        return -a;
+    }
+
+
+    static long long checkedAdd(long long a, long long b) {
+        if((b > 0 && a > LLONG_MAX - b) || (b < 0 && a < LLONG_MIN - b))
+            throw XCheckerUndefined("overflow");
+        return a + b;
+    }
+
+
+    static long long checkedSub(long long a, long long b) {
+        if((b < 0 && a > LLONG_MAX + b) || (b > 0 && a < LLONG_MIN + b))
+            throw XCheckerUndefined("overflow");
+        return a - b;
+    }
+
+
+    static long long checkedMul(long long a, long long b) {
+        if(a == 0 || b == 0)
+            return 0;
+        bool overflow;
+        if(a > 0)
+            overflow = b > 0 ? a > LLONG_MAX / b : b < LLONG_MIN / a;
+        else
+            overflow = b > 0 ? a < LLONG_MIN / b : a < LLONG_MAX / b;
+        if(overflow)
+            throw XCheckerUndefined("overflow");
+        return a * b;
+    }
+
+
+    static long long checkedDiv(long long a, long long b) {
+        if(b == 0)
+            throw XCheckerUndefined("division by zero");
+        if(a == LLONG_MIN && b == -1)
+            throw XCheckerUndefined("overflow");
+        return a / b;
+    }
+
+
+    static long long checkedMod(long long a, long long b) {
+        if(b == 0)
+            throw XCheckerUndefined("modulo by zero");
+        return b == -1 ? 0 : a % b;
+    }
+
+
+    static long long checkedPow(long long a, long long b) {
+        if(b < 0)
+            throw XCheckerUndefined("negative exponent");
+        if(a == 0 || a == 1)
+            return b == 0 ? 1 : a;
+        if(a == -1)
+            return b % 2 == 0 ? 1 : -1;
+        long long v = 1;    // |a| >= 2: overflows after at most 63 steps
+        for(long long i = 0 ; i < b ; i++)
+            v = checkedMul(v, a);
+        return v;
+    }
+
+
+    static int toInt(long long v) {
+        if(v < INT_MIN || v > INT_MAX)
+            throw XCheckerUndefined("overflow");
+        return v;
+    }
+
+
+    static long long apply(ExpressionType op, const long long *args, int n) {
+        long long v;
+        switch(op) {
+            case ONEG :
+                return checkedNeg(args[0]);
+            case OABS :
+                return args[0] < 0 ? checkedNeg(args[0]) : args[0];
+            case OSQR :
+                return checkedMul(args[0], args[0]);
+            case ONOT :
+                return args[0] == 0;
+            case OSUB :
+                return checkedSub(args[0], args[1]);
+            case ODIV :
+                return checkedDiv(args[0], args[1]);
+            case OMOD :
+                return checkedMod(args[0], args[1]);
+            case OPOW :
+                return checkedPow(args[0], args[1]);
+            case ODIST :
+                return args[0] > args[1] ? checkedSub(args[0], args[1]) : checkedSub(args[1], args[0]);
+            case OLT :
+                return args[0] < args[1];
+            case OLE :
+                return args[0] <= args[1];
+            case OGE :
+                return args[0] >= args[1];
+            case OGT :
+                return args[0] > args[1];
+            case ONE :
+                return args[0] != args[1];
+            case OIMP :
+                return args[0] == 0 || args[1] != 0;
+            case OIF :
+                return args[0] ? args[1] : args[2];
+            case OADD :
+                v = 0;
+                for(int i = 0 ; i < n ; i++)
+                    v = checkedAdd(v, args[i]);
+                return v;
+            case OMUL :
+                v = 1;
+                for(int i = 0 ; i < n ; i++)
+                    v = checkedMul(v, args[i]);
+                return v;
+            case OMIN :
+                return *std::min_element(args, args + n);
+            case OMAX :
+                return *std::max_element(args, args + n);
+            case OEQ :
+                for(int i = 1 ; i < n ; i++)
+                    if(args[i] != args[0])
+                        return 0;
+                return 1;
+            case OAND :
+                for(int i = 0 ; i < n ; i++)
+                    if(args[i] == 0)
+                        return 0;
+                return 1;
+            case OOR :
+                for(int i = 0 ; i < n ; i++)
+                    if(args[i] != 0)
+                        return 1;
+                return 0;
+            case OXOR :
+                v = 0;
+                for(int i = 0 ; i < n ; i++)
+                    v += args[i] != 0;
+                return v % 2;
+            case OIFF :
+                for(int i = 1 ; i < n ; i++)
+                    if((args[i] != 0) != (args[0] != 0))
+                        return 0;
+                return 1;
+            case OIN :
+                return std::find(args + 1, args + n, args[0]) != args + n;
+            case ONOTIN :
+                return std::find(args + 1, args + n, args[0]) == args + n;
+            default :
+                throw runtime_error("checker: operator " + operatorToString(op) + " is not supported");
+        }
+    }
+
+
+    // Batch version of apply: operand k of row r is args[k * BLOCK + r], the result replaces operand 0
+    static void applyRows(ExpressionType op, long long *args, int n, int nbRows) {
+        const int BLOCK = XCheckerExpression::BLOCK;
+        long long *result = args, *second = args + BLOCK;
+        switch(op) {
+            case ONEG :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = checkedNeg(result[r]);
+                return;
+            case OABS :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = result[r] < 0 ? checkedNeg(result[r]) : result[r];
+                return;
+            case OSQR :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = checkedMul(result[r], result[r]);
+                return;
+            case ONOT :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = result[r] == 0;
+                return;
+            case OSUB :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = checkedSub(result[r], second[r]);
+                return;
+            case ODIST :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = result[r] > second[r] ? checkedSub(result[r], second[r]) : checkedSub(second[r], result[r]);
+                return;
+            case OLT :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = result[r] < second[r];
+                return;
+            case OLE :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = result[r] <= second[r];
+                return;
+            case OGE :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = result[r] >= second[r];
+                return;
+            case OGT :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = result[r] > second[r];
+                return;
+            case ONE :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = result[r] != second[r];
+                return;
+            case OIMP :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = result[r] == 0 || second[r] != 0;
+                return;
+            case OIF :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = result[r] ? second[r] : second[BLOCK + r];
+                return;
+            case OADD :
+                for(int k = 1 ; k < n ; k++)
+                    for(int r = 0 ; r < nbRows ; r++)
+                        result[r] = checkedAdd(result[r], args[k * BLOCK + r]);
+                return;
+            case OMUL :
+                for(int k = 1 ; k < n ; k++)
+                    for(int r = 0 ; r < nbRows ; r++)
+                        result[r] = checkedMul(result[r], args[k * BLOCK + r]);
+                return;
+            case OMIN :
+                for(int k = 1 ; k < n ; k++)
+                    for(int r = 0 ; r < nbRows ; r++)
+                        result[r] = std::min(result[r], args[k * BLOCK + r]);
+                return;
+            case OMAX :
+                for(int k = 1 ; k < n ; k++)
+                    for(int r = 0 ; r < nbRows ; r++)
+                        result[r] = std::max(result[r], args[k * BLOCK + r]);
+                return;
+            case OEQ :  // operand 1 accumulates the result
+                for(int k = 1 ; k < n ; k++)
+                    for(int r = 0 ; r < nbRows ; r++)
+                        second[r] = k == 1 ? result[r] == second[r] : second[r] & (result[r] == args[k * BLOCK + r]);
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = second[r];
+                return;
+            case OAND :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = result[r] != 0;
+                for(int k = 1 ; k < n ; k++)
+                    for(int r = 0 ; r < nbRows ; r++)
+                        result[r] &= args[k * BLOCK + r] != 0;
+                return;
+            case OOR :
+                for(int r = 0 ; r < nbRows ; r++)
+                    result[r] = result[r] != 0;
+                for(int k = 1 ; k < n ; k++)
+                    for(int r = 0 ; r < nbRows ; r++)
+                        result[r] |= args[k * BLOCK + r] != 0;
+                return;
+            default : { // row by row
+                long long local[16];
+                vector<long long> large;
+                long long *row = local;
+                if(n > 16) {
+                    large.resize(n);
+                    row = large.data();
+                }
+                for(int r = 0 ; r < nbRows ; r++) {
+                    for(int k = 0 ; k < n ; k++)
+                        row[k] = args[k * BLOCK + r];
+                    result[r] = apply(op, row, n);
+                }
+            }
+        }
+    }
+
+
+    /***************************************************************************
+     * Tuples of extension constraints (sorted if there is no star)
+     * Small tables without star are also stored in a bitset indexed by the tuples.
+     **************************************************************************/
+
+    class XCheckerTuples {
+    public :
+        int arity;
+        bool hasStar;
+        vector<int> tuples;
+        vector<int> lower, sizes;           // the range of values of each column (bitset only)
+        vector<unsigned long long> bits;    // empty: no bitset
+
+
+        XCheckerTuples(vector<vector<int> > &list, bool star) : arity(list.empty() ? 0 : list[0].size()), hasStar(star) {
+            vector<int> order(list.size());
+            for(unsigned int i = 0 ; i < list.size() ; i++)
+                order[i] = i;
+            if(hasStar == false)
+                std::sort(order.begin(), order.end(), [&list](int a, int b) { return list[a] < list[b]; });
+            tuples.reserve(list.size() * arity);
+            for(int i : order)
+                tuples.insert(tuples.end(), list[i].begin(), list[i].end());
+            buildBitset();
+        }
+
+
+        XCheckerTuples(vector<int> &values, bool star) : arity(1), hasStar(star), tuples(values) {
+            std::sort(tuples.begin(), tuples.end());
+            buildBitset();
+        }
+
+
+        void buildBitset() {
+            if(hasStar || tuples.empty() || arity == 0)
+                return;
+            lower.assign(arity, INT_MAX);
+            vector<int> upper(arity, INT_MIN);
+            for(unsigned int i = 0 ; i < tuples.size() ; i++) {
+                lower[i % arity] = std::min(lower[i % arity], tuples[i]);
+                upper[i % arity] = std::max(upper[i % arity], tuples[i]);
+            }
+            long long size = 1;
+            sizes.resize(arity);
+            for(int i = 0 ; i < arity ; i++) {
+                size *= (long long) upper[i] - lower[i] + 1;
+                sizes[i] = upper[i] - lower[i] + 1;
+                if(size > MAX_TUPLES_BITSET) {
+                    lower.clear();
+                    sizes.clear();
+                    return;
+                }
+            }
+            bits.assign((size + 63) / 64, 0);
+            for(unsigned int t = 0 ; t < tuples.size() ; t += arity) {
+                long long index = 0;
+                for(int i = 0 ; i < arity ; i++)
+                    index = index * sizes[i] + tuples[t + i] - lower[i];
+                bits[index >> 6] |= 1ULL << (index & 63);
+            }
+        }
+
+
+        bool contains(const int *tuple) const {
+            if(bits.empty() == false) {
+                long long index = 0;
+                for(int i = 0 ; i < arity ; i++) {
+                    unsigned int v = tuple[i] - lower[i];
+                    if(v >= (unsigned int) sizes[i])
+                        return false;
+                    index = index * sizes[i] + v;
+                }
+                return (bits[index >> 6] >> (index & 63)) & 1;
+            }
+            int nb = arity == 0 ? 0 : tuples.size() / arity;
+            if(hasStar) {
+                for(int t = 0 ; t < nb ; t++) {
+                    const int *current = tuples.data() + t * arity;
+                    int i = 0;
+                    while(i < arity && (current[i] == STAR || current[i] == tuple[i]))
+                        i++;
+                    if(i == arity)
+                        return true;
+                }
+                return false;
+            }
+            int low = 0, high = nb;     // binary search in [low, high[
+            while(low < high) {
+                int middle = (low + high) / 2;
+                const int *current = tuples.data() + middle * arity;
+                int i = 0;
+                while(i < arity && current[i] == tuple[i])
+                    i++;
+                if(i == arity)
+                    return true;
+                if(current[i] < tuple[i])
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            return false;
+        }
+    };
+
+
+    /***************************************************************************
+     * Automaton of regular and mdd constraints
+     **************************************************************************/
+
+    class XCheckerAutomaton {
+    public :
+        int nbStates;
+        vector<int> offsets;                // transitions of state s are arcs[offsets[s]..offsets[s + 1][
+        vector<pair<int, int> > arcs;       // (value, next state) sorted by value
+        bool deterministic;
+
+
+        XCheckerAutomaton(XAutomaton &automaton) : nbStates(automaton.nbStates()), offsets(automaton.nbStates() + 1, 0),
+                                                    deterministic(true) {
+            vector<int> &transitions = automaton.transitions;
+            for(unsigned int i = 0 ; i < transitions.size() ; i += 3)
+                offsets[transitions[i] + 1]++;
+            for(int s = 0 ; s < nbStates ; s++)
+                offsets[s + 1] += offsets[s];
+            arcs.resize(transitions.size() / 3);
+            vector<int> position(offsets.begin(), offsets.end() - 1);
+            for(unsigned int i = 0 ; i < transitions.size() ; i += 3)
+                arcs[position[transitions[i]]++] = std::make_pair(transitions[i + 1], transitions[i + 2]);
+            for(int s = 0 ; s < nbStates ; s++) {
+                std::sort(arcs.begin() + offsets[s], arcs.begin() + offsets[s + 1]);
+                for(int i = offsets[s] + 1 ; i < offsets[s + 1] ; i++)
+                    if(arcs[i].first == arcs[i - 1].first)
+                        deterministic = false;
+            }
+        }
+
+
+        // The first arc of state s with this value (or the end of the arcs of s)
+        int next(int s, int value) const {
+            auto it = std::lower_bound(arcs.begin() + offsets[s], arcs.begin() + offsets[s + 1], std::make_pair(value, INT_MIN));
+            return it - arcs.begin();
+        }
+    };
+
+
+    /***************************************************************************
+     * Objective (it reuses terms and expressions of constraints)
+     **************************************************************************/
+
+    class XCheckerObjective : public XCheckerConstraint {
+    public :
+        ExpressionObjective type;
+        vector<int> coefs;                  // empty: all coefficients are equal to 1
+
+
+        XCheckerObjective(ExpressionObjective t) : XCheckerConstraint("objective"), type(t) {
+            if(type == LEX_O)
+                throw runtime_error("checker: lex objective is not supported");
+        }
+
+
+        bool satisfied(const int *) const override {
+            return true;
+        }
+
+
+        long long evaluate(const int *assignment) const {
+            long long result = type == PRODUCT_O ? 1 : 0;
+            vector<int> values;
+            for(unsigned int i = 0 ; i < terms.size() ; i++) {
+                long long v = (long long) value(terms[i], assignment) * (coefs.empty() ? 1 : coefs[i]);
+                if(type == SUM_O || type == EXPRESSION_O)
+                    result = checkedAdd(result, v);
+                if(type == PRODUCT_O)
+                    result = checkedMul(result, v);
+                if((type == MINIMUM_O && (i == 0 || v < result)) || (type == MAXIMUM_O && (i == 0 || v > result)))
+                    result = v;
+                if(type == NVALUES_O)
+                    values.push_back(v);
+            }
+            if(type == NVALUES_O) {
+                std::sort(values.begin(), values.end());
+                result = std::unique(values.begin(), values.end()) - values.begin();
+            }
+            return result;
+        }
+    };
+
+
+    /***************************************************************************
+     * Constraints
+     **************************************************************************/
+
+    class XCheckerExtension : public XCheckerConstraint {
+    public :
+        shared_ptr<XCheckerTuples> tuples;
+        bool support;
+
+
+        XCheckerExtension(string id, shared_ptr<XCheckerTuples> t, bool s) : XCheckerConstraint(id), tuples(t), support(s) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            int local[16];
+            vector<int> large;
+            int *tuple = local;
+            if(terms.size() > 16) {
+                large.resize(terms.size());
+                tuple = large.data();
+            }
+            for(unsigned int i = 0 ; i < terms.size() ; i++)
+                tuple[i] = value(terms[i], assignment);
+            return tuples->contains(tuple) == support;
+        }
+
+
+        void satisfiedRows(const int *assignments, int stride, int nbRows, char *result) const override {
+            int local[16];
+            vector<int> large;
+            int *tuple = local;
+            if(terms.size() > 16) {
+                large.resize(terms.size());
+                tuple = large.data();
+            }
+            for(int r = 0 ; r < nbRows ; r++) {
+                const int *assignment = assignments + r * stride;
+                for(unsigned int i = 0 ; i < terms.size() ; i++)
+                    tuple[i] = value(terms[i], assignment);
+                result[r] = tuples->contains(tuple) == support;
+            }
+        }
+    };
+
+
+    class XCheckerIntension : public XCheckerConstraint {
+    public :
+        XCheckerIntension(string id) : XCheckerConstraint(id) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            return value(terms[0], assignment) != 0;
+        }
+
+
+        void satisfiedRows(const int *assignments, int stride, int nbRows, char *result) const override {
+            if(terms[0].variable != XCheckerTerm::EXPRESSION) {
+                XCheckerConstraint::satisfiedRows(assignments, stride, nbRows, result);
+                return;
+            }
+            int values[XCheckerExpression::BLOCK];
+            for(int from = 0 ; from < nbRows ; from += XCheckerExpression::BLOCK) {
+                int nb = std::min(nbRows - from, (int) XCheckerExpression::BLOCK);
+                expressions[terms[0].value].evaluate(assignments + (long) from * stride, stride, nb, values);
+                for(int r = 0 ; r < nb ; r++)
+                    result[from + r] = values[r] != 0;
+            }
+        }
+    };
+
+
+    class XCheckerInstantiation : public XCheckerConstraint {
+    public :
+        vector<int> values;
+
+
+        XCheckerInstantiation(string id, vector<int> &v) : XCheckerConstraint(id), values(v) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            for(unsigned int i = 0 ; i < terms.size() ; i++)
+                if(value(terms[i], assignment) != values[i])
+                    return false;
+            return true;
+        }
+    };
+
+
+    class XCheckerClause : public XCheckerConstraint {
+    public :
+        unsigned int nbPositive;            // positive literals first, then negative ones
+
+
+        XCheckerClause(string id, int n) : XCheckerConstraint(id), nbPositive(n) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            for(unsigned int i = 0 ; i < terms.size() ; i++)
+                if((value(terms[i], assignment) != 0) == (i < nbPositive))
+                    return true;
+            return false;
+        }
+    };
+
+
+    class XCheckerAllDifferent : public XCheckerConstraint {
+    public :
+        vector<int> except;                 // sorted
+
+
+        XCheckerAllDifferent(string id) : XCheckerConstraint(id) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            vector<int> values;
+            values.reserve(terms.size());
+            for(const XCheckerTerm &t : terms) {
+                int v = value(t, assignment);
+                if(except.empty() || std::binary_search(except.begin(), except.end(), v) == false)
+                    values.push_back(v);
+            }
+            std::sort(values.begin(), values.end());
+            return std::adjacent_find(values.begin(), values.end()) == values.end();
+        }
+    };
+
+
+    class XCheckerAllDifferentList : public XCheckerConstraint {
+    public :
+        int size;                           // terms contains all lists, one after the other
+
+
+        XCheckerAllDifferentList(string id, int s) : XCheckerConstraint(id), size(s) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            int nb = terms.size() / size;
+            for(int i = 0 ; i < nb ; i++)
+                for(int j = i + 1 ; j < nb ; j++) {
+                    int k = 0;
+                    while(k < size && value(terms[i * size + k], assignment) == value(terms[j * size + k], assignment))
+                        k++;
+                    if(k == size)
+                        return false;
+                }
+            return true;
+        }
+    };
+
+
+    class XCheckerAllEqual : public XCheckerConstraint {
+    public :
+        bool notAllEqual;
+
+
+        XCheckerAllEqual(string id, bool n) : XCheckerConstraint(id), notAllEqual(n) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            bool equal = true;
+            for(unsigned int i = 1 ; equal && i < terms.size() ; i++)
+                equal = value(terms[i], assignment) == value(terms[0], assignment);
+            return equal != notAllEqual;
+        }
+    };
+
+
+    class XCheckerOrdered : public XCheckerConstraint {
+    public :
+        vector<XCheckerTerm> lengths;       // empty if no lengths
+        OrderType op;
+
+
+        XCheckerOrdered(string id, OrderType o) : XCheckerConstraint(id), op(o) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            for(unsigned int i = 0 ; i + 1 < terms.size() ; i++) {
+                long long v = value(terms[i], assignment);
+                if(lengths.empty() == false)
+                    v += value(lengths[i], assignment);
+                if(compare(v, op, value(terms[i + 1], assignment)) == false)
+                    return false;
+            }
+            return true;
+        }
+    };
+
+
+    class XCheckerLex : public XCheckerConstraint {
+    public :
+        int size;                           // terms contains all lists, one after the other
+        OrderType op;
+
+
+        XCheckerLex(string id, int s, OrderType o) : XCheckerConstraint(id), size(s), op(o) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            int nb = terms.size() / size;
+            for(int i = 0 ; i + 1 < nb ; i++) {
+                int k = 0, a = 0, b = 0;
+                for(; k < size ; k++) {
+                    a = value(terms[i * size + k], assignment);
+                    b = value(terms[(i + 1) * size + k], assignment);
+                    if(a != b)
+                        break;
+                }
+                if(compare(k == size ? 0 : (a < b ? -1 : 1), op, 0) == false)
+                    return false;
+            }
+            return true;
+        }
+    };
+
+
+    class XCheckerSum : public XCheckerConstraint {
+    public :
+        vector<int> coefs;                  // empty: all coefficients are equal to 1
+        vector<XCheckerTerm> coefTerms;     // variable coefficients
+        XCheckerCondition condition;
+
+
+        XCheckerSum(string id, XCheckerCondition c) : XCheckerConstraint(id), condition(c) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            long long sum = 0;
+            for(unsigned int i = 0 ; i < terms.size() ; i++) {
+                long long coef = coefTerms.empty() ? (coefs.empty() ? 1 : coefs[i]) : value(coefTerms[i], assignment);
+                sum += coef * value(terms[i], assignment);
+            }
+            return condition.holds(sum, assignment);
+        }
+    };
+
+
+    class XCheckerCount : public XCheckerConstraint {
+    public :
+        vector<XCheckerTerm> values;
+        XCheckerCondition condition;
+
+
+        XCheckerCount(string id, XCheckerCondition c) : XCheckerConstraint(id), condition(c) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            long long nb = 0;
+            for(const XCheckerTerm &t : terms) {
+                int v = value(t, assignment);
+                for(const XCheckerTerm &w : values)
+                    if(value(w, assignment) == v) {
+                        nb++;
+                        break;
+                    }
+            }
+            return condition.holds(nb, assignment);
+        }
+    };
+
+
+    class XCheckerNValues : public XCheckerConstraint {
+    public :
+        vector<int> except;                 // sorted
+        XCheckerCondition condition;
+
+
+        XCheckerNValues(string id, XCheckerCondition c) : XCheckerConstraint(id), condition(c) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            vector<int> values;
+            values.reserve(terms.size());
+            for(const XCheckerTerm &t : terms) {
+                int v = value(t, assignment);
+                if(except.empty() || std::binary_search(except.begin(), except.end(), v) == false)
+                    values.push_back(v);
+            }
+            std::sort(values.begin(), values.end());
+            return condition.holds(std::unique(values.begin(), values.end()) - values.begin(), assignment);
+        }
+    };
+
+
+    class XCheckerCardinality : public XCheckerConstraint {
+    public :
+        vector<XCheckerTerm> values;
+        vector<XCheckerTerm> occurs;        // used if not empty, otherwise intervals
+        vector<XInterval> intervals;
+        bool closed;
+
+
+        XCheckerCardinality(string id, bool c) : XCheckerConstraint(id), closed(c) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            vector<int> nb(values.size(), 0);
+            for(const XCheckerTerm &t : terms) {
+                int v = value(t, assignment);
+                bool found = false;
+                for(unsigned int i = 0 ; i < values.size() ; i++)
+                    if(value(values[i], assignment) == v) {
+                        nb[i]++;
+                        found = true;
+                    }
+                if(closed && found == false)
+                    return false;
+            }
+            for(unsigned int i = 0 ; i < values.size() ; i++) {
+                if(occurs.empty() == false && nb[i] != value(occurs[i], assignment))
+                    return false;
+                if(occurs.empty() && (nb[i] < intervals[i].min || nb[i] > intervals[i].max))
+                    return false;
+            }
+            return true;
+        }
+    };
+
+
+    // minimum, maximum and arg versions: terms is the list, index is used if hasIndex is true
+    class XCheckerExtremum : public XCheckerConstraint {
+    public :
+        bool maximum, arg, hasIndex;
+        XCheckerTerm index;
+        int startIndex;
+        RankType rank;
+        XCheckerCondition condition;
+
+
+        XCheckerExtremum(string id, bool max, bool a, XCheckerCondition c) : XCheckerConstraint(id), maximum(max), arg(a),
+                                                                             hasIndex(false), index(XCheckerTerm::CONSTANT, 0),
+                                                                             startIndex(0), rank(ANY), condition(c) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            int n = terms.size();
+            long long best = value(terms[0], assignment);
+            for(int i = 1 ; i < n ; i++) {
+                int v = value(terms[i], assignment);
+                if((maximum && v > best) || (maximum == false && v < best))
+                    best = v;
+            }
+            // Positions that must or may be the index
+            int first = 0, last = n - 1;
+            while(value(terms[first], assignment) != best)
+                first++;
+            while(value(terms[last], assignment) != best)
+                last--;
+            if(arg) {
+                if(rank == FIRST)
+                    return condition.holds(first, assignment);
+                if(rank == LAST)
+                    return condition.holds(last, assignment);
+                for(int i = first ; i <= last ; i++)
+                    if(value(terms[i], assignment) == best && condition.holds(i, assignment))
+                        return true;
+                return false;
+            }
+            if(hasIndex) {
+                int i = value(index, assignment) - startIndex;
+                if(i < 0 || i >= n || value(terms[i], assignment) != best)
+                    return false;
+                if((rank == FIRST && i != first) || (rank == LAST && i != last))
+                    return false;
+            }
+            return condition.holds(best, assignment);
+        }
+    };
+
+
+    // element: terms is the list. Without index, one element of the list must satisfy the condition
+    class XCheckerElement : public XCheckerConstraint {
+    public :
+        bool hasIndex;
+        XCheckerTerm index;
+        int startIndex;
+        RankType rank;
+        XCheckerCondition condition;
+
+
+        XCheckerElement(string id, XCheckerCondition c) : XCheckerConstraint(id), hasIndex(false), index(XCheckerTerm::CONSTANT, 0),
+                                                          startIndex(0), rank(ANY), condition(c) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            int n = terms.size();
+            if(hasIndex == false) {
+                for(int i = 0 ; i < n ; i++)
+                    if(condition.holds(value(terms[i], assignment), assignment))
+                        return true;
+                return false;
+            }
+            int i = value(index, assignment) - startIndex;
+            if(i < 0 || i >= n || condition.holds(value(terms[i], assignment), assignment) == false)
+                return false;
+            for(int j = 0 ; rank == FIRST && j < i ; j++)
+                if(condition.holds(value(terms[j], assignment), assignment))
+                    return false;
+            for(int j = i + 1 ; rank == LAST && j < n ; j++)
+                if(condition.holds(value(terms[j], assignment), assignment))
+                    return false;
+            return true;
+        }
+    };
+
+
+    // element on a matrix: terms is the matrix, row by row
+    class XCheckerElementMatrix : public XCheckerConstraint {
+    public :
+        int nbColumns;
+        XCheckerTerm rowIndex, colIndex;
+        int startRowIndex, startColIndex;
+        XCheckerCondition condition;
+
+
+        XCheckerElementMatrix(string id, int nb, XCheckerTerm row, int startRow, XCheckerTerm col, int startCol, XCheckerCondition c)
+                : XCheckerConstraint(id), nbColumns(nb), rowIndex(row), colIndex(col), startRowIndex(startRow), startColIndex(startCol),
+                  condition(c) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            int nbRows = terms.size() / nbColumns;
+            int row = value(rowIndex, assignment) - startRowIndex;
+            int col = value(colIndex, assignment) - startColIndex;
+            if(row < 0 || row >= nbRows || col < 0 || col >= nbColumns)
+                return false;
+            return condition.holds(value(terms[row * nbColumns + col], assignment), assignment);
+        }
+    };
+
+
+    // channel on one list: x[i] = j <=> x[j] = i
+    class XCheckerChannel : public XCheckerConstraint {
+    public :
+        int startIndex;
+
+
+        XCheckerChannel(string id, int s) : XCheckerConstraint(id), startIndex(s) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            int n = terms.size();
+            for(int i = 0 ; i < n ; i++) {
+                int j = value(terms[i], assignment) - startIndex;
+                if(j < 0 || j >= n || value(terms[j], assignment) - startIndex != i)
+                    return false;
+            }
+            return true;
+        }
+    };
+
+
+    // channel on two lists (terms contains list1 then list2): x[i] = j => y[j] = i (<=> if same size)
+    class XCheckerChannel2 : public XCheckerConstraint {
+    public :
+        int size1, startIndex1, startIndex2;
+
+
+        XCheckerChannel2(string id, int s, int start1, int start2) : XCheckerConstraint(id), size1(s), startIndex1(start1),
+                                                                    startIndex2(start2) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            int size2 = terms.size() - size1;
+            for(int i = 0 ; i < size1 ; i++) {
+                int j = value(terms[i], assignment) - startIndex2;
+                if(j < 0 || j >= size2 || value(terms[size1 + j], assignment) - startIndex1 != i)
+                    return false;
+            }
+            for(int j = 0 ; size1 == size2 && j < size2 ; j++) {
+                int i = value(terms[size1 + j], assignment) - startIndex1;
+                if(i < 0 || i >= size1 || value(terms[i], assignment) - startIndex2 != j)
+                    return false;
+            }
+            return true;
+        }
+    };
+
+
+    // channel with a value: x[i] = 1 <=> value = i, exactly one x[i] = 1
+    class XCheckerChannelValue : public XCheckerConstraint {
+    public :
+        int startIndex;
+        XCheckerTerm val;
+
+
+        XCheckerChannelValue(string id, int s, XCheckerTerm v) : XCheckerConstraint(id), startIndex(s), val(v) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            int n = terms.size();
+            int k = value(val, assignment) - startIndex;
+            if(k < 0 || k >= n)
+                return false;
+            for(int i = 0 ; i < n ; i++)
+                if(value(terms[i], assignment) != (i == k ? 1 : 0))
+                    return false;
+            return true;
+        }
+    };
+
+
+    class XCheckerRegular : public XCheckerConstraint {
+    public :
+        shared_ptr<XCheckerAutomaton> automaton;
+        int start;
+        vector<char> final;
+
+
+        XCheckerRegular(string id, shared_ptr<XCheckerAutomaton> a, int s) : XCheckerConstraint(id), automaton(a), start(s),
+                                                                              final(a->nbStates, 0) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            const XCheckerAutomaton &a = *automaton;
+            if(a.deterministic) {
+                int s = start;
+                for(const XCheckerTerm &t : terms) {
+                    int v = value(t, assignment);
+                    int arc = a.next(s, v);
+                    if(arc == a.offsets[s + 1] || a.arcs[arc].first != v)
+                        return false;
+                    s = a.arcs[arc].second;
+                }
+                return final[s];
+            }
+            vector<char> current(a.nbStates, 0), next(a.nbStates, 0);
+            current[start] = 1;
+            for(const XCheckerTerm &t : terms) {
+                int v = value(t, assignment);
+                std::fill(next.begin(), next.end(), 0);
+                bool reached = false;
+                for(int s = 0 ; s < a.nbStates ; s++) {
+                    if(current[s] == 0)
+                        continue;
+                    for(int arc = a.next(s, v) ; arc < a.offsets[s + 1] && a.arcs[arc].first == v ; arc++)
+                        next[a.arcs[arc].second] = reached = true;
+                }
+                if(reached == false)
+                    return false;
+                current.swap(next);
+            }
+            for(int s = 0 ; s < a.nbStates ; s++)
+                if(current[s] && final[s])
+                    return true;
+            return false;
+        }
+    };
+
+
+    // circuit: x[i] = j means j is the successor of i. Nodes with x[i] = i are not in the circuit
+    class XCheckerCircuit : public XCheckerConstraint {
+    public :
+        int startIndex;
+
+
+        XCheckerCircuit(string id, int s) : XCheckerConstraint(id), startIndex(s) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            int n = terms.size(), first = -1, nb = 0;
+            for(int i = 0 ; i < n ; i++) {
+                int j = value(terms[i], assignment) - startIndex;
+                if(j < 0 || j >= n)
+                    return false;
+                if(j != i) {
+                    nb++;
+                    first = i;
+                }
+            }
+            if(nb < 2)
+                return false;
+            int current = first, length = 0;
+            do {
+                current = value(terms[current], assignment) - startIndex;
+                length++;
+            } while(current != first && length <= nb);
+            return current == first && length == nb;
+        }
+    };
+
+
+    // noOverlap in k dimensions: terms contains the origins (box by box), lengths the lengths
+    class XCheckerNoOverlap : public XCheckerConstraint {
+    public :
+        vector<XCheckerTerm> lengths;
+        int k;
+        bool zeroIgnored;
+
+
+        XCheckerNoOverlap(string id, int d, bool z) : XCheckerConstraint(id), k(d), zeroIgnored(z) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            int n = terms.size() / k;
+            vector<long long> origins(terms.size()), ls(terms.size());
+            vector<char> ignored(n, 0);
+            for(unsigned int i = 0 ; i < terms.size() ; i++) {
+                origins[i] = value(terms[i], assignment);
+                ls[i] = value(lengths[i], assignment);
+                if(zeroIgnored && ls[i] == 0)
+                    ignored[i / k] = 1;
+            }
+            for(int i = 0 ; i < n ; i++)
+                for(int j = i + 1 ; ignored[i] == 0 && j < n ; j++) {
+                    if(ignored[j])
+                        continue;
+                    bool separated = false;
+                    for(int d = 0 ; separated == false && d < k ; d++)
+                        separated = origins[i * k + d] + ls[i * k + d] <= origins[j * k + d] ||
+                                    origins[j * k + d] + ls[j * k + d] <= origins[i * k + d];
+                    if(separated == false)
+                        return false;
+                }
+            return true;
+        }
+    };
+
+
+    // cumulative: terms contains the origins
+    class XCheckerCumulative : public XCheckerConstraint {
+    public :
+        vector<XCheckerTerm> lengths, heights;
+        XCheckerCondition condition;
+
+
+        XCheckerCumulative(string id, XCheckerCondition c) : XCheckerConstraint(id), condition(c) {}
+
+
+        bool satisfied(const int *assignment) const override {
+            int n = terms.size();
+            vector<long long> origins(n), ls(n), hs(n);
+            for(int i = 0 ; i < n ; i++) {
+                origins[i] = value(terms[i], assignment);
+                ls[i] = value(lengths[i], assignment);
+                hs[i] = value(heights[i], assignment);
+            }
+            // The height is maximal at the start of a task
+            for(int i = 0 ; i < n ; i++) {
+                if(ls[i] == 0)
+                    continue;
+                long long height = 0;
+                for(int j = 0 ; j < n ; j++)
+                    if(origins[j] <= origins[i] && origins[i] < origins[j] + ls[j])
+                        height += hs[j];
+                if(condition.holds(height, assignment) == false)
+                    return false;
+            }
+            return true;
+        }
+    };
+}
+
+
+/***************************************************************************
+ * Expressions and conditions
+ **************************************************************************/
+
+XCheckerExpression::XCheckerExpression(Node *root, const unordered_map<string, int> &variables) {
+    depth = compile(root, variables);
+}
+
+
+// Add the code of the node and returns the size of the stack needed to evaluate it
+int XCheckerExpression::compile(Node *node, const unordered_map<string, int> &variables) {
+    if(node->type == OVAR) {
+        auto it = variables.find(((NodeVariable *) node)->var);
+        if(it == variables.end())
+            throw runtime_error("checker: unknown variable " + ((NodeVariable *) node)->var);
+        code.push_back(Instruction(OVAR, it->second));
+        return 1;
+    }
+    if(node->type == ODECIMAL) {
+        code.push_back(Instruction(ODECIMAL, ((NodeConstant *) node)->val));
+        return 1;
+    }
+
+    vector<Node *> operands(node->parameters);
+    if(node->type == OIN || node->type == ONOTIN) { // in(x, set(a,b,c)) : x a b c in
+        if(operands.size() != 2 || operands[1]->type != OSET)
+            throw runtime_error("checker: in requires a set as second parameter");
+        operands.pop_back();
+        operands.insert(operands.end(), node->parameters[1]->parameters.begin(), node->parameters[1]->parameters.end());
+    }
+    if(isSupported(node->type) == false)
+        throw runtime_error("checker: operator " + operatorToString(node->type) + " is not supported");
+    bool unary = node->type == ONEG || node->type == OABS || node->type == OSQR || node->type == ONOT || node->type == OIN || node->type == ONOTIN;
+    if(operands.size() < (unary ? 1 : (node->type == OIF ? 3 : 2)))
+        throw runtime_error("checker: operator " + operatorToString(node->type) + " has too few parameters");
+    int d = 1, n = 0;
+    for(Node *operand : operands) {
+        d = std::max(d, n + compile(operand, variables));
+        n++;
+    }
+    code.push_back(Instruction(node->type, n));
+    return d;
+}
+
+
+int XCheckerExpression::evaluate(const int *assignment) const {
+    long long local[32];
+    vector<long long> large;
+    long long *stack = local;
+    int top = 0;
+    if(depth > 32) {
+        large.resize(depth);
+        stack = large.data();
+    }
+    for(const Instruction &instruction : code) {
+        if(instruction.op == OVAR)
+            stack[top++] = assignment[instruction.arg];
+        else if(instruction.op == ODECIMAL)
+            stack[top++] = instruction.arg;
+        else {
+            top -= instruction.arg;
+            stack[top] = apply(instruction.op, stack + top, instruction.arg);
+            top++;
+        }
+    }
+    return toInt(stack[0]);
+}
+
+
+void XCheckerExpression::evaluate(const int *assignments, int stride, int nbRows, int *results) const {
+    // The stack contains one block of BLOCK values per level
+    long long local[16 * BLOCK];
+    vector<long long> large;
+    long long *stack = local;
+    if(depth > 16) {
+        large.resize(depth * BLOCK);
+        stack = large.data();
+    }
+    for(int from = 0 ; from < nbRows ; from += BLOCK) {
+        int nb = std::min(nbRows - from, (int) BLOCK), top = 0;
+        const int *rows = assignments + (long) from * stride;
+        for(const Instruction &instruction : code) {
+            if(instruction.op == OVAR) {
+                long long *block = stack + top * BLOCK;
+                for(int r = 0 ; r < nb ; r++)
+                    block[r] = rows[(long) r * stride + instruction.arg];
+                top++;
+            } else if(instruction.op == ODECIMAL) {
+                std::fill(stack + top * BLOCK, stack + top * BLOCK + nb, instruction.arg);
+                top++;
+            } else {
+                top -= instruction.arg;
+                applyRows(instruction.op, stack + top * BLOCK, instruction.arg, nb);
+                top++;
+            }
+        }
+        for(int r = 0 ; r < nb ; r++)
+            results[from + r] = toInt(stack[r]);
+    }
+}
+
+
+bool XCheckerConstraint::isSatisfied(const int *assignment) const {
+    try {
+        return satisfied(assignment);
+    } catch(XCheckerUndefined &e) {
+        return false;
+    }
+}
+
+
+void XCheckerConstraint::satisfiedRows(const int *assignments, int stride, int nbRows, char *result) const {
+    for(int r = 0 ; r < nbRows ; r++)
+        result[r] = isSatisfied(assignments + (long) r * stride);
+}
+
+
+XCheckerCondition::XCheckerCondition(XCondition &xc, const unordered_map<string, int> &variables) : op(xc.op), operandType(xc.operandType),
+                                                                                                    val(xc.val), min(xc.min), max(xc.max),
+                                                                                                    variable(-1), set(xc.set) {
+    std::sort(set.begin(), set.end());
+    if(operandType == VARIABLE) {
+        auto it = variables.find(xc.var);
+        if(it == variables.end())
+            throw runtime_error("checker: unknown variable " + xc.var);
+        variable = it->second;
+    }
+}
+
+
+bool XCheckerCondition::holds(long long value, const int *assignment) const {
+    if(operandType == INTERVAL || operandType == SET) {
+        bool in = operandType == INTERVAL ? value >= min && value <= max : std::binary_search(set.begin(), set.end(), value);
+        return op == NOTIN ? !in : in;
+    }
+    return compare(value, op, operandType == VARIABLE ? assignment[variable] : val);
+}
+
+
+/***************************************************************************
+ * The checker
+ **************************************************************************/
+
+XCSP3SolutionChecker::XCSP3SolutionChecker() : firstArrayVariable(0), objective(nullptr), minimize(true) {
+    nbThreads = std::max(1, (int) std::thread::hardware_concurrency());
+    intensionUsingString = false;
+    recognizeSpecialIntensionCases = false;
+    recognizeSpecialCountCases = false;
+    recognizeNValuesCases = false;
+}
+
+
+XCSP3SolutionChecker::~XCSP3SolutionChecker() {
+    for(XCheckerConstraint *c : constraints)
+        delete c;
+    delete objective;
+}
+
+
+int XCSP3SolutionChecker::variable(const string &id) const {
+    auto it = variableIndexes.find(id);
+    return it == variableIndexes.end() ? -1 : it->second;
+}
+
+
+void XCSP3SolutionChecker::parseInstantiation(const string &xml, vector<int> &assignment) const {
+    size_t listBegin = xml.find("<list"), valuesBegin = xml.find("<values");
+    if(listBegin == string::npos || valuesBegin == string::npos)
+        throw runtime_error("checker: the instantiation needs a list and values");
+    listBegin = xml.find('>', listBegin) + 1;
+    valuesBegin = xml.find('>', valuesBegin) + 1;
+    std::istringstream list(xml.substr(listBegin, xml.find("</list>", listBegin) - listBegin));
+    std::istringstream values(xml.substr(valuesBegin, xml.find("</values>", valuesBegin) - valuesBegin));
+
+    // The scope: -1 for empty cells of arrays
+    vector<int> scope;
+    string token;
+    while(list >> token) {
+        int x = variable(token);
+        if(x >= 0) {
+            scope.push_back(x);
+            continue;
+        }
+        size_t pos = token.find('[');
+        auto it = arrays.find(token.substr(0, pos));
+        if(pos == string::npos || it == arrays.end())
+            throw runtime_error("checker: unknown variable " + token);
+        const Array &array = it->second;
+        vector<int> mins, maxs;
+        while(pos < token.size() && token[pos] == '[') {
+            size_t end = token.find(']', pos);
+            if(end == string::npos || mins.size() == array.sizes.size())
+                throw runtime_error("checker: bad compact form " + token);
+            string range = token.substr(pos + 1, end - pos - 1);
+            size_t dotdot = range.find("..");
+            if(range.empty()) {
+                mins.push_back(0);
+                maxs.push_back(array.sizes[mins.size() - 1] - 1);
+            } else if(dotdot == string::npos) {
+                mins.push_back(std::stoi(range));
+                maxs.push_back(mins.back());
+            } else {
+                mins.push_back(std::stoi(range.substr(0, dotdot)));
+                maxs.push_back(std::stoi(range.substr(dotdot + 2)));
+            }
+            if(mins.back() < 0 || maxs.back() >= array.sizes[mins.size() - 1])
+                throw runtime_error("checker: bad compact form " + token);
+            pos = end + 1;
+        }
+        if(mins.size() != array.sizes.size())
+            throw runtime_error("checker: bad compact form " + token);
+        vector<int> current(mins);
+        while(true) {
+            int flat = 0;
+            for(unsigned int d = 0 ; d < current.size() ; d++)
+                flat = flat * array.sizes[d] + current[d];
+            scope.push_back(array.cells[flat]);
+            int d = current.size() - 1;
+            while(d >= 0 && current[d] == maxs[d]) {
+                current[d] = mins[d];
+                d--;
+            }
+            if(d < 0)
+                break;
+            current[d]++;
+        }
+    }
+
+    assignment.assign(variableIds.size(), STAR);
+    unsigned int i = 0;
+    while(values >> token) {
+        size_t times = token.find('x');
+        int nb = times == string::npos ? 1 : std::stoi(token.substr(times + 1));
+        string v = token.substr(0, times);
+        int value = v == "*" ? STAR : std::stoi(v);
+        for(int k = 0 ; k < nb ; k++, i++) {
+            if(i >= scope.size())
+                throw runtime_error("checker: the instantiation contains more values than variables");
+            if(scope[i] >= 0)
+                assignment[scope[i]] = value;
+        }
+    }
+    if(i != scope.size())
+        throw runtime_error("checker: the instantiation contains less values than variables");
+}
+
+
+void XCSP3SolutionChecker::checkDomains(const vector<int> &assignment, vector<int> &variables) const {
+    variables.clear();
+    for(unsigned int x = 0 ; x < variableIds.size() ; x++) {
+        int v = x < assignment.size() ? assignment[x] : STAR;
+        bool in = v >= mins[x] && v <= maxs[x];
+        if(in && domainValues[x].empty() == false)
+            in = std::binary_search(domainValues[x].begin(), domainValues[x].end(), v);
+        if(in == false)
+            variables.push_back(x);
+    }
+}
+
+
+void XCSP3SolutionChecker::checkConstraints(int from, int to, const int *assignment, vector<int> &violated) const {
+    for(int c = from ; c < to ; c++)
+        if(constraints[c]->isSatisfied(assignment) == false)
+            violated.push_back(c);
+}
+
+
+bool XCSP3SolutionChecker::check(const vector<int> &assignment, vector<int> &violated) const {
+    if(assignment.size() != variableIds.size())
+        throw runtime_error("checker: the assignment must contain one value per variable");
+    violated.clear();
+    int n = constraints.size();
+    int nbChunks = std::min(nbThreads, (n + MIN_CONSTRAINTS_PER_THREAD - 1) / MIN_CONSTRAINTS_PER_THREAD);
+    if(nbChunks <= 1) {
+        checkConstraints(0, n, assignment.data(), violated);
+        return violated.empty();
+    }
+
+    // Each thread checks a contiguous range of constraints, results are concatenated in order
+    vector<vector<int> > results(nbChunks);
+    vector<std::thread> threads;
+    for(int t = 0 ; t < nbChunks ; t++) {
+        int from = (long long) n * t / nbChunks, to = (long long) n * (t + 1) / nbChunks;
+        threads.emplace_back(&XCSP3SolutionChecker::checkConstraints, this, from, to, assignment.data(), std::ref(results[t]));
+    }
+    for(std::thread &thread : threads)
+        thread.join();
+    for(vector<int> &result : results)
+        violated.insert(violated.end(), result.begin(), result.end());
+    return violated.empty();
+}
+
+
+void XCSP3SolutionChecker::checkRows(const int *assignments, int nbRows, char *feasible, long long *objectives) const {
+    const int BLOCK = XCheckerExpression::BLOCK;
+    int stride = variableIds.size();
+    char result[BLOCK];
+    for(int from = 0 ; from < nbRows ; from += BLOCK) {
+        int nb = std::min(nbRows - from, BLOCK), nbFeasible = nb;
+        const int *rows = assignments + (long) from * stride;
+        std::fill(feasible + from, feasible + from + nb, 1);
+        // Constraint by constraint on a block of rows, until all rows are unfeasible
+        for(unsigned int c = 0 ; c < constraints.size() && nbFeasible > 0 ; c++) {
+            try {
+                constraints[c]->satisfiedRows(rows, stride, nb, result);
+            } catch(XCheckerUndefined &e) {   // undefined for some row of the block: row by row
+                for(int r = 0 ; r < nb ; r++)
+                    result[r] = constraints[c]->isSatisfied(rows + (long) r * stride);
+            }
+            nbFeasible = 0;
+            for(int r = 0 ; r < nb ; r++) {
+                feasible[from + r] &= result[r];
+                nbFeasible += feasible[from + r];
+            }
+        }
+        if(objectives != nullptr)
+            for(int r = 0 ; r < nb ; r++) {
+                try {
+                    objectives[from + r] = objective->evaluate(rows + (long) r * stride);
+                } catch(XCheckerUndefined &e) {   // an undefined objective makes the row unfeasible
+                    feasible[from + r] = 0;
+                    objectives[from + r] = 0;
+                }
+            }
+    }
+}
+
+
+int XCSP3SolutionChecker::checkBatch(const vector<int> &assignments, vector<char> &feasible, vector<long long> &objectives) const {
+    int stride = variableIds.size();
+    if(stride == 0 || assignments.size() % stride != 0)
+        throw runtime_error("checker: the batch must contain one value per variable for each assignment");
+    int nbRows = assignments.size() / stride;
+    feasible.assign(nbRows, 0);
+    objectives.assign(objective == nullptr ? 0 : nbRows, 0);
+    long long *values = objective == nullptr ? nullptr : objectives.data();
+
+    int nbChunks = std::max(1, std::min(nbThreads, nbRows / MIN_ROWS_PER_THREAD));
+    if(nbChunks == 1)
+        checkRows(assignments.data(), nbRows, feasible.data(), values);
+    else {
+        // Each thread checks a contiguous range of rows
+        vector<std::thread> threads;
+        for(int t = 0 ; t < nbChunks ; t++) {
+            int from = (long long) nbRows * t / nbChunks, to = (long long) nbRows * (t + 1) / nbChunks;
+            threads.emplace_back(&XCSP3SolutionChecker::checkRows, this, assignments.data() + (long) from * stride, to - from,
+                                 feasible.data() + from, values == nullptr ? nullptr : values + from);
+        }
+        for(std::thread &thread : threads)
+            thread.join();
+    }
+    return std::count(feasible.begin(), feasible.end(), 1);
+}
+
+
+long long XCSP3SolutionChecker::objectiveValue(const vector<int> &assignment) const {
+    if(objective == nullptr)
+        throw runtime_error("checker: the instance has no objective");
+    return objective->evaluate(assignment.data());
+}
+
+
+//--------------------------------------------------------------------------------------
+// Helpers
+//--------------------------------------------------------------------------------------
+
+XCheckerTerm XCSP3SolutionChecker::term(XVariable *x, XCheckerConstraint *) {
+    if(x->kind == INTEGER_E)
+        return XCheckerTerm(XCheckerTerm::CONSTANT, ((XInteger *) x)->value);
+    int index = variable(x->id);
+    if(index < 0)
+        throw runtime_error("checker: unknown variable " + x->id);
+    return XCheckerTerm(index, 0);
+}
+
+
+XCheckerTerm XCSP3SolutionChecker::term(Tree *tree, XCheckerConstraint *c) {
+    if(tree->root->type == OVAR && variable(((NodeVariable *) tree->root)->var) >= 0)
+        return XCheckerTerm(variable(((NodeVariable *) tree->root)->var), 0);
+    if(tree->root->type == ODECIMAL)
+        return XCheckerTerm(XCheckerTerm::CONSTANT, ((NodeConstant *) tree->root)->val);
+    c->expressions.push_back(XCheckerExpression(tree->root, variableIndexes));
+    return XCheckerTerm(XCheckerTerm::EXPRESSION, c->expressions.size() - 1);
+}
+
+
+XCheckerTerm XCSP3SolutionChecker::term(int value, XCheckerConstraint *) {
+    return XCheckerTerm(XCheckerTerm::CONSTANT, value);
+}
+
+
+template<class T>
+void XCSP3SolutionChecker::terms(vector<T> &list, XCheckerConstraint *c, vector<XCheckerTerm> &result) {
+    result.reserve(result.size() + list.size());
+    for(T &e : list)
+        result.push_back(term(e, c));
+}
+
+
+void XCSP3SolutionChecker::constants(vector<int> &values, vector<XCheckerTerm> &result) {
+    result.reserve(result.size() + values.size());
+    for(int v : values)
+        result.push_back(XCheckerTerm(XCheckerTerm::CONSTANT, v));
+}
+
+
+XCheckerCondition XCSP3SolutionChecker::condition(XCondition &xc) {
+    return XCheckerCondition(xc, variableIndexes);
+}
+
+
+XCheckerCondition XCSP3SolutionChecker::equalTo(XVariable *x) {
+    if(x->kind == INTEGER_E)
+        return equalTo(((XInteger *) x)->value);
+    XCheckerCondition c;
+    c.operandType = VARIABLE;
+    c.variable = variable(x->id);
+    if(c.variable < 0)
+        throw runtime_error("checker: unknown variable " + x->id);
+    return c;
+}
+
+
+XCheckerCondition XCSP3SolutionChecker::equalTo(int value) {
+    XCheckerCondition c;
+    c.val = value;
+    return c;
+}
+
+
+static void setIndex(XCheckerElement *c, XCheckerTerm index, int startIndex, RankType rank) {
+    c->hasIndex = true;
+    c->index = index;
+    c->startIndex = startIndex;
+    c->rank = rank;
+}
+
+
+template<class T>
+void XCSP3SolutionChecker::addElementMatrix(string &id, vector<vector<T> > &matrix, int startRowIndex, XVariable *rowIndex,
+                                            int startColIndex, XVariable *colIndex, XCheckerCondition xc) {
+    XCheckerElementMatrix *c = new XCheckerElementMatrix(id, matrix.empty() ? 1 : matrix[0].size(), term(rowIndex, nullptr), startRowIndex,
+                                                         term(colIndex, nullptr), startColIndex, xc);
+    for(vector<T> &row : matrix)
+        terms(row, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::addAutomaton(string &id, vector<XVariable *> &list, int start, vector<int> &final) {
+    XCheckerRegular *c = new XCheckerRegular(id, lastAutomaton, start);
+    for(int f : final)
+        c->final[f] = 1;
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::setObjective(bool min, XCheckerObjective *o) {
+    delete objective;
+    objective = o;
+    minimize = min;
+}
+
+
+//--------------------------------------------------------------------------------------
+// Variables
+//--------------------------------------------------------------------------------------
+
+void XCSP3SolutionChecker::addVariable(string &id) {
+    if(variableIndexes.find(id) != variableIndexes.end())
+        throw runtime_error("checker: variable " + id + " is already defined");
+    variableIndexes[id] = variableIds.size();
+    variableIds.push_back(id);
+}
+
+
+void XCSP3SolutionChecker::beginVariableArray(string id) {
+    currentArray = id;
+    firstArrayVariable = variableIds.size();
+}
+
+
+void XCSP3SolutionChecker::endVariableArray() {
+    Array &array = arrays[currentArray];
+    vector<vector<int> > indexes;
+    for(unsigned int x = firstArrayVariable ; x < variableIds.size() ; x++) {
+        // x[2][3] -> 2 3
+        const string &id = variableIds[x];
+        indexes.push_back(vector<int>());
+        for(size_t pos = id.find('[', currentArray.size()) ; pos != string::npos ; pos = id.find('[', pos + 1))
+            indexes.back().push_back(std::stoi(id.substr(pos + 1)));
+        if(array.sizes.size() < indexes.back().size())
+            array.sizes.resize(indexes.back().size(), 0);
+        for(unsigned int d = 0 ; d < indexes.back().size() ; d++)
+            array.sizes[d] = std::max(array.sizes[d], indexes.back()[d] + 1);
+    }
+    int nbCells = 1;
+    for(int size : array.sizes)
+        nbCells *= size;
+    array.cells.assign(indexes.empty() ? 0 : nbCells, -1);
+    for(unsigned int i = 0 ; i < indexes.size() ; i++) {
+        int flat = 0;
+        for(unsigned int d = 0 ; d < indexes[i].size() ; d++)
+            flat = flat * array.sizes[d] + indexes[i][d];
+        array.cells[flat] = firstArrayVariable + i;
+    }
+    currentArray.clear();
+}
+
+
+void XCSP3SolutionChecker::buildVariableInteger(string id, int minValue, int maxValue) {
+    addVariable(id);
+    mins.push_back(minValue);
+    maxs.push_back(maxValue);
+    domainValues.push_back(vector<int>());
+}
+
+
+void XCSP3SolutionChecker::buildVariableInteger(string id, vector<int> &values) {
+    addVariable(id);
+    domainValues.push_back(values);
+    std::sort(domainValues.back().begin(), domainValues.back().end());
+    mins.push_back(values.empty() ? 0 : domainValues.back().front());
+    maxs.push_back(values.empty() ? -1 : domainValues.back().back());
+}
+
+
+//--------------------------------------------------------------------------------------
+// Generic constraints
+//--------------------------------------------------------------------------------------
+
+void XCSP3SolutionChecker::buildConstraintExtension(string id, vector<XVariable *> list, vector<vector<int>> &tuples, bool support, bool hasStar) {
+    lastTuples = std::make_shared<XCheckerTuples>(tuples, hasStar);
+    buildConstraintExtensionAs(id, list, support, hasStar);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintExtension(string id, XVariable *variable, vector<int> &tuples, bool support, bool hasStar) {
+    XCheckerExtension *c = new XCheckerExtension(id, std::make_shared<XCheckerTuples>(tuples, hasStar), support);
+    c->terms.push_back(term(variable, c));
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintExtensionAs(string id, vector<XVariable *> list, bool support, bool) {
+    XCheckerExtension *c = new XCheckerExtension(id, lastTuples, support);
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintIntension(string id, Tree *tree) {
+    XCheckerIntension *c = new XCheckerIntension(id);
+    c->terms.push_back(term(tree, c));
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintInstantiation(string id, vector<XVariable *> &list, vector<int> &values) {
+    XCheckerInstantiation *c = new XCheckerInstantiation(id, values);
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintClause(string id, vector<XVariable *> &positive, vector<XVariable *> &negative) {
+    XCheckerClause *c = new XCheckerClause(id, positive.size());
+    terms(positive, c, c->terms);
+    terms(negative, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+//--------------------------------------------------------------------------------------
+// Comparison constraints
+//--------------------------------------------------------------------------------------
+
+void XCSP3SolutionChecker::buildConstraintAlldifferent(string id, vector<XVariable *> &list) {
+    XCheckerAllDifferent *c = new XCheckerAllDifferent(id);
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintAlldifferent(string id, vector<Tree *> &list) {
+    XCheckerAllDifferent *c = new XCheckerAllDifferent(id);
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintAlldifferentExcept(string id, vector<XVariable *> &list, vector<int> &except) {
+    XCheckerAllDifferent *c = new XCheckerAllDifferent(id);
+    terms(list, c, c->terms);
+    c->except = except;
+    std::sort(c->except.begin(), c->except.end());
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintAlldifferentList(string id, vector<vector<XVariable *>> &lists) {
+    XCheckerAllDifferentList *c = new XCheckerAllDifferentList(id, lists.empty() ? 1 : lists[0].size());
+    for(vector<XVariable *> &list : lists)
+        terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintAlldifferentMatrix(string id, vector<vector<XVariable *>> &matrix) {
+    // One alldifferent per row and per column
+    for(vector<XVariable *> &row : matrix)
+        buildConstraintAlldifferent(id, row);
+    for(unsigned int j = 0 ; matrix.empty() == false && j < matrix[0].size() ; j++) {
+        vector<XVariable *> column;
+        for(vector<XVariable *> &row : matrix)
+            column.push_back(row[j]);
+        buildConstraintAlldifferent(id, column);
+    }
+}
+
+
+void XCSP3SolutionChecker::buildConstraintAllEqual(string id, vector<XVariable *> &list) {
+    XCheckerAllEqual *c = new XCheckerAllEqual(id, false);
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintAllEqual(string id, vector<Tree *> &list) {
+    XCheckerAllEqual *c = new XCheckerAllEqual(id, false);
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintNotAllEqual(string id, vector<XVariable *> &list) {
+    XCheckerAllEqual *c = new XCheckerAllEqual(id, true);
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintOrdered(string id, vector<XVariable *> &list, OrderType order) {
+    XCheckerOrdered *c = new XCheckerOrdered(id, order);
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintOrdered(string id, vector<XVariable *> &list, vector<int> &lengths, OrderType order) {
+    XCheckerOrdered *c = new XCheckerOrdered(id, order);
+    terms(list, c, c->terms);
+    constants(lengths, c->lengths);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintOrdered(string id, vector<XVariable *> &list, vector<XVariable *> &lengths, OrderType order) {
+    XCheckerOrdered *c = new XCheckerOrdered(id, order);
+    terms(list, c, c->terms);
+    terms(lengths, c, c->lengths);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintLex(string id, vector<vector<XVariable *>> &lists, OrderType order) {
+    XCheckerLex *c = new XCheckerLex(id, lists.empty() ? 1 : lists[0].size(), order);
+    for(vector<XVariable *> &list : lists)
+        terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintLexMatrix(string id, vector<vector<XVariable *>> &matrix, OrderType order) {
+    // Rows and columns are ordered
+    buildConstraintLex(id, matrix, order);
+    vector<vector<XVariable *> > columns(matrix.empty() ? 0 : matrix[0].size());
+    for(vector<XVariable *> &row : matrix)
+        for(unsigned int j = 0 ; j < row.size() ; j++)
+            columns[j].push_back(row[j]);
+    buildConstraintLex(id, columns, order);
+}
+
+
+//--------------------------------------------------------------------------------------
+// Counting and summing constraints
+//--------------------------------------------------------------------------------------
+
+void XCSP3SolutionChecker::buildConstraintSum(string id, vector<XVariable *> &list, vector<int> &coeffs, XCondition &cond) {
+    XCheckerSum *c = new XCheckerSum(id, condition(cond));
+    terms(list, c, c->terms);
+    c->coefs = coeffs;
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintSum(string id, vector<XVariable *> &list, XCondition &cond) {
+    XCheckerSum *c = new XCheckerSum(id, condition(cond));
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintSum(string id, vector<XVariable *> &list, vector<XVariable *> &coeffs, XCondition &cond) {
+    XCheckerSum *c = new XCheckerSum(id, condition(cond));
+    terms(list, c, c->terms);
+    terms(coeffs, c, c->coefTerms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintSum(string id, vector<Tree *> &trees, XCondition &cond) {
+    XCheckerSum *c = new XCheckerSum(id, condition(cond));
+    terms(trees, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintSum(string id, vector<Tree *> &trees, vector<int> &coefs, XCondition &cond) {
+    XCheckerSum *c = new XCheckerSum(id, condition(cond));
+    terms(trees, c, c->terms);
+    c->coefs = coefs;
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCount(string id, vector<XVariable *> &list, vector<int> &values, XCondition &xc) {
+    XCheckerCount *c = new XCheckerCount(id, condition(xc));
+    terms(list, c, c->terms);
+    constants(values, c->values);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCount(string id, vector<XVariable *> &list, vector<XVariable *> &values, XCondition &xc) {
+    XCheckerCount *c = new XCheckerCount(id, condition(xc));
+    terms(list, c, c->terms);
+    terms(values, c, c->values);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCount(string id, vector<Tree *> &trees, vector<int> &values, XCondition &xc) {
+    XCheckerCount *c = new XCheckerCount(id, condition(xc));
+    terms(trees, c, c->terms);
+    constants(values, c->values);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCount(string id, vector<Tree *> &trees, vector<XVariable *> &values, XCondition &xc) {
+    XCheckerCount *c = new XCheckerCount(id, condition(xc));
+    terms(trees, c, c->terms);
+    terms(values, c, c->values);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintNValues(string id, vector<XVariable *> &list, vector<int> &except, XCondition &xc) {
+    XCheckerNValues *c = new XCheckerNValues(id, condition(xc));
+    terms(list, c, c->terms);
+    c->except = except;
+    std::sort(c->except.begin(), c->except.end());
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintNValues(string id, vector<Tree *> &trees, XCondition &xc) {
+    XCheckerNValues *c = new XCheckerNValues(id, condition(xc));
+    terms(trees, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintNValues(string id, vector<XVariable *> &list, XCondition &xc) {
+    XCheckerNValues *c = new XCheckerNValues(id, condition(xc));
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCardinality(string id, vector<XVariable *> &list, vector<int> values, vector<int> &occurs, bool closed) {
+    XCheckerCardinality *c = new XCheckerCardinality(id, closed);
+    terms(list, c, c->terms);
+    constants(values, c->values);
+    constants(occurs, c->occurs);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCardinality(string id, vector<XVariable *> &list, vector<int> values, vector<XVariable *> &occurs, bool closed) {
+    XCheckerCardinality *c = new XCheckerCardinality(id, closed);
+    terms(list, c, c->terms);
+    constants(values, c->values);
+    terms(occurs, c, c->occurs);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCardinality(string id, vector<XVariable *> &list, vector<int> values, vector<XInterval> &occurs, bool closed) {
+    XCheckerCardinality *c = new XCheckerCardinality(id, closed);
+    terms(list, c, c->terms);
+    constants(values, c->values);
+    c->intervals = occurs;
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCardinality(string id, vector<XVariable *> &list, vector<XVariable *> values, vector<int> &occurs, bool closed) {
+    XCheckerCardinality *c = new XCheckerCardinality(id, closed);
+    terms(list, c, c->terms);
+    terms(values, c, c->values);
+    constants(occurs, c->occurs);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCardinality(string id, vector<XVariable *> &list, vector<XVariable *> values, vector<XVariable *> &occurs, bool closed) {
+    XCheckerCardinality *c = new XCheckerCardinality(id, closed);
+    terms(list, c, c->terms);
+    terms(values, c, c->values);
+    terms(occurs, c, c->occurs);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCardinality(string id, vector<XVariable *> &list, vector<XVariable *> values, vector<XInterval> &occurs, bool closed) {
+    XCheckerCardinality *c = new XCheckerCardinality(id, closed);
+    terms(list, c, c->terms);
+    terms(values, c, c->values);
+    c->intervals = occurs;
+    constraints.push_back(c);
+}
+
+
+//--------------------------------------------------------------------------------------
+// Connection constraints
+//--------------------------------------------------------------------------------------
+
+void XCSP3SolutionChecker::buildConstraintMinimum(string id, vector<XVariable *> &list, XCondition &xc) {
+    XCheckerExtremum *c = new XCheckerExtremum(id, false, false, condition(xc));
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintMinimum(string id, vector<Tree *> &list, XCondition &xc) {
+    XCheckerExtremum *c = new XCheckerExtremum(id, false, false, condition(xc));
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintMinimum(string id, vector<XVariable *> &list, XVariable *index, int startIndex, RankType rank, XCondition &xc) {
+    XCheckerExtremum *c = new XCheckerExtremum(id, false, false, condition(xc));
+    terms(list, c, c->terms);
+    c->hasIndex = true;
+    c->index = term(index, c);
+    c->startIndex = startIndex;
+    c->rank = rank;
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintMaximum(string id, vector<XVariable *> &list, XCondition &xc) {
+    XCheckerExtremum *c = new XCheckerExtremum(id, true, false, condition(xc));
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintMaximum(string id, vector<Tree *> &list, XCondition &xc) {
+    XCheckerExtremum *c = new XCheckerExtremum(id, true, false, condition(xc));
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintMaximum(string id, vector<XVariable *> &list, XVariable *index, int startIndex, RankType rank, XCondition &xc) {
+    XCheckerExtremum *c = new XCheckerExtremum(id, true, false, condition(xc));
+    terms(list, c, c->terms);
+    c->hasIndex = true;
+    c->index = term(index, c);
+    c->startIndex = startIndex;
+    c->rank = rank;
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintMaximumArg(string id, vector<XVariable *> &list, RankType rank, XCondition &xc) {
+    XCheckerExtremum *c = new XCheckerExtremum(id, true, true, condition(xc));
+    terms(list, c, c->terms);
+    c->rank = rank;
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintMaximumArg(string id, vector<Tree *> &list, RankType rank, XCondition &xc) {
+    XCheckerExtremum *c = new XCheckerExtremum(id, true, true, condition(xc));
+    terms(list, c, c->terms);
+    c->rank = rank;
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintMinimumArg(string id, vector<XVariable *> &list, RankType rank, XCondition &xc) {
+    XCheckerExtremum *c = new XCheckerExtremum(id, false, true, condition(xc));
+    terms(list, c, c->terms);
+    c->rank = rank;
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintMinimumArg(string id, vector<Tree *> &list, RankType rank, XCondition &xc) {
+    XCheckerExtremum *c = new XCheckerExtremum(id, false, true, condition(xc));
+    terms(list, c, c->terms);
+    c->rank = rank;
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintElement(string id, vector<XVariable *> &list, int value) {
+    XCheckerElement *c = new XCheckerElement(id, equalTo(value));
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintElement(string id, vector<XVariable *> &list, XVariable *value) {
+    XCheckerElement *c = new XCheckerElement(id, equalTo(value));
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintElement(string id, vector<int> &list, XVariable *index, int startIndex, XCondition &xc) {
+    XCheckerElement *c = new XCheckerElement(id, condition(xc));
+    constants(list, c->terms);
+    setIndex(c, term(index, c), startIndex, ANY);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintElement(string id, vector<XVariable *> &list, XVariable *index, int startIndex, XCondition &xc) {
+    XCheckerElement *c = new XCheckerElement(id, condition(xc));
+    terms(list, c, c->terms);
+    setIndex(c, term(index, c), startIndex, ANY);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintElement(string id, vector<int> &list, int startIndex, XVariable *index, RankType rank, int value) {
+    XCheckerElement *c = new XCheckerElement(id, equalTo(value));
+    constants(list, c->terms);
+    setIndex(c, term(index, c), startIndex, rank);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintElement(string id, vector<XVariable *> &list, int startIndex, XVariable *index, RankType rank, int value) {
+    XCheckerElement *c = new XCheckerElement(id, equalTo(value));
+    terms(list, c, c->terms);
+    setIndex(c, term(index, c), startIndex, rank);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintElement(string id, vector<int> &list, int startIndex, XVariable *index, RankType rank, XVariable *value) {
+    XCheckerElement *c = new XCheckerElement(id, equalTo(value));
+    constants(list, c->terms);
+    setIndex(c, term(index, c), startIndex, rank);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintElement(string id, vector<XVariable *> &list, int startIndex, XVariable *index, RankType rank, XVariable *value) {
+    XCheckerElement *c = new XCheckerElement(id, equalTo(value));
+    terms(list, c, c->terms);
+    setIndex(c, term(index, c), startIndex, rank);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintElement(string id, vector<vector<XVariable *> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex,
+                                                  XVariable *colIndex, XVariable *value) {
+    addElementMatrix(id, matrix, startRowIndex, rowIndex, startColIndex, colIndex, equalTo(value));
+}
+
+
+void XCSP3SolutionChecker::buildConstraintElement(string id, vector<vector<XVariable *> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex,
+                                                  XVariable *colIndex, int value) {
+    addElementMatrix(id, matrix, startRowIndex, rowIndex, startColIndex, colIndex, equalTo(value));
+}
+
+
+void XCSP3SolutionChecker::buildConstraintElement(string id, vector<vector<int> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex,
+                                                  XVariable *colIndex, XVariable *value) {
+    addElementMatrix(id, matrix, startRowIndex, rowIndex, startColIndex, colIndex, equalTo(value));
+}
+
+
+void XCSP3SolutionChecker::buildConstraintElement(string id, vector<vector<int> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex,
+                                                  XVariable *colIndex, XCondition &xc) {
+    addElementMatrix(id, matrix, startRowIndex, rowIndex, startColIndex, colIndex, condition(xc));
+}
+
+
+void XCSP3SolutionChecker::buildConstraintElement(string id, vector<vector<XVariable *> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex,
+                                                  XVariable *colIndex, XCondition &xc) {
+    addElementMatrix(id, matrix, startRowIndex, rowIndex, startColIndex, colIndex, condition(xc));
+}
+
+
+void XCSP3SolutionChecker::buildConstraintChannel(string id, vector<XVariable *> &list, int startIndex) {
+    XCheckerChannel *c = new XCheckerChannel(id, startIndex);
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintChannel(string id, vector<XVariable *> &list1, int startIndex1, vector<XVariable *> &list2, int startIndex2) {
+    XCheckerChannel2 *c = new XCheckerChannel2(id, list1.size(), startIndex1, startIndex2);
+    terms(list1, c, c->terms);
+    terms(list2, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintChannel(string id, vector<XVariable *> &list, int startIndex, XVariable *value) {
+    XCheckerChannelValue *c = new XCheckerChannelValue(id, startIndex, term(value, nullptr));
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+//--------------------------------------------------------------------------------------
+// Languages constraints
+//--------------------------------------------------------------------------------------
+
+void XCSP3SolutionChecker::buildConstraintRegular(string id, vector<XVariable *> &list, int start, vector<int> &final, XAutomaton &automaton) {
+    lastAutomaton = std::make_shared<XCheckerAutomaton>(automaton);
+    addAutomaton(id, list, start, final);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintRegularAs(string id, vector<XVariable *> &list, int start, vector<int> &final, XAutomaton &automaton) {
+    if(lastAutomaton == nullptr || lastAutomaton->nbStates != automaton.nbStates())
+        lastAutomaton = std::make_shared<XCheckerAutomaton>(automaton);
+    addAutomaton(id, list, start, final);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintMDD(string id, vector<XVariable *> &list, XAutomaton &automaton) {
+    lastAutomaton = std::make_shared<XCheckerAutomaton>(automaton);
+    buildConstraintMDDAs(id, list, automaton);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintMDDAs(string id, vector<XVariable *> &list, XAutomaton &automaton) {
+    if(lastAutomaton == nullptr || lastAutomaton->nbStates != automaton.nbStates())
+        lastAutomaton = std::make_shared<XCheckerAutomaton>(automaton);
+    // The root has no incoming transition, terminal nodes have no outgoing transitions
+    vector<char> incoming(automaton.nbStates(), 0);
+    for(unsigned int i = 2 ; i < automaton.transitions.size() ; i += 3)
+        incoming[automaton.transitions[i]] = 1;
+    int root = std::find(incoming.begin(), incoming.end(), 0) - incoming.begin();
+    if(root == automaton.nbStates())
+        throw runtime_error("checker: mdd " + id + " has no root");
+    vector<int> terminals;
+    for(int s = 0 ; s < automaton.nbStates() ; s++)
+        if(lastAutomaton->offsets[s] == lastAutomaton->offsets[s + 1])
+            terminals.push_back(s);
+    addAutomaton(id, list, root, terminals);
+}
+
+
+//--------------------------------------------------------------------------------------
+// Graph and scheduling constraints
+//--------------------------------------------------------------------------------------
+
+void XCSP3SolutionChecker::buildConstraintCircuit(string id, vector<XVariable *> &list, int startIndex) {
+    XCheckerCircuit *c = new XCheckerCircuit(id, startIndex);
+    terms(list, c, c->terms);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintNoOverlap(string id, vector<XVariable *> &origins, vector<int> &lengths, bool zeroIgnored) {
+    XCheckerNoOverlap *c = new XCheckerNoOverlap(id, 1, zeroIgnored);
+    terms(origins, c, c->terms);
+    constants(lengths, c->lengths);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintNoOverlap(string id, vector<XVariable *> &origins, vector<XVariable *> &lengths, bool zeroIgnored) {
+    XCheckerNoOverlap *c = new XCheckerNoOverlap(id, 1, zeroIgnored);
+    terms(origins, c, c->terms);
+    terms(lengths, c, c->lengths);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintNoOverlap(string id, vector<vector<XVariable *>> &origins, vector<vector<int>> &lengths, bool zeroIgnored) {
+    XCheckerNoOverlap *c = new XCheckerNoOverlap(id, origins.empty() ? 1 : origins[0].size(), zeroIgnored);
+    for(unsigned int i = 0 ; i < origins.size() ; i++) {
+        terms(origins[i], c, c->terms);
+        constants(lengths[i], c->lengths);
+    }
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintNoOverlap(string id, vector<vector<XVariable *>> &origins, vector<vector<XVariable *>> &lengths, bool zeroIgnored) {
+    XCheckerNoOverlap *c = new XCheckerNoOverlap(id, origins.empty() ? 1 : origins[0].size(), zeroIgnored);
+    for(unsigned int i = 0 ; i < origins.size() ; i++) {
+        terms(origins[i], c, c->terms);
+        terms(lengths[i], c, c->lengths);
+    }
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<int> &lengths, vector<int> &heights, XCondition &xc) {
+    XCheckerCumulative *c = new XCheckerCumulative(id, condition(xc));
+    terms(origins, c, c->terms);
+    constants(lengths, c->lengths);
+    constants(heights, c->heights);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<int> &lengths, vector<XVariable *> &varHeights, XCondition &xc) {
+    XCheckerCumulative *c = new XCheckerCumulative(id, condition(xc));
+    terms(origins, c, c->terms);
+    constants(lengths, c->lengths);
+    terms(varHeights, c, c->heights);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<XVariable *> &lengths, vector<int> &heights, XCondition &xc) {
+    XCheckerCumulative *c = new XCheckerCumulative(id, condition(xc));
+    terms(origins, c, c->terms);
+    terms(lengths, c, c->lengths);
+    constants(heights, c->heights);
+    constraints.push_back(c);
+}
+
+
+void XCSP3SolutionChecker::buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<XVariable *> &lengths, vector<XVariable *> &heights, XCondition &xc) {
+    XCheckerCumulative *c = new XCheckerCumulative(id, condition(xc));
+    terms(origins, c, c->terms);
+    terms(lengths, c, c->lengths);
+    terms(heights, c, c->heights);
+    constraints.push_back(c);
+}
+
+
+//--------------------------------------------------------------------------------------
+// Objectives
+//--------------------------------------------------------------------------------------
+
+void XCSP3SolutionChecker::buildObjectiveMinimizeExpression(string expr) {
+    Tree tree(expr);
+    XCheckerObjective *o = new XCheckerObjective(EXPRESSION_O);
+    o->terms.push_back(term(&tree, o));
+    setObjective(true, o);
+}
+
+
+void XCSP3SolutionChecker::buildObjectiveMaximizeExpression(string expr) {
+    buildObjectiveMinimizeExpression(expr);
+    minimize = false;
+}
+
+
+void XCSP3SolutionChecker::buildObjectiveMinimizeVariable(XVariable *x) {
+    XCheckerObjective *o = new XCheckerObjective(EXPRESSION_O);
+    o->terms.push_back(term(x, o));
+    setObjective(true, o);
+}
+
+
+void XCSP3SolutionChecker::buildObjectiveMaximizeVariable(XVariable *x) {
+    buildObjectiveMinimizeVariable(x);
+    minimize = false;
+}
+
+
+void XCSP3SolutionChecker::buildObjectiveMinimize(ExpressionObjective type, vector<XVariable *> &list, vector<int> &coefs) {
+    XCheckerObjective *o = new XCheckerObjective(type);
+    terms(list, o, o->terms);
+    o->coefs = coefs;
+    setObjective(true, o);
+}
+
+
+void XCSP3SolutionChecker::buildObjectiveMaximize(ExpressionObjective type, vector<XVariable *> &list, vector<int> &coefs) {
+    buildObjectiveMinimize(type, list, coefs);
+    minimize = false;
+}
+
+
+void XCSP3SolutionChecker::buildObjectiveMinimize(ExpressionObjective type, vector<XVariable *> &list) {
+    XCheckerObjective *o = new XCheckerObjective(type);
+    terms(list, o, o->terms);
+    setObjective(true, o);
+}
+
+
+void XCSP3SolutionChecker::buildObjectiveMaximize(ExpressionObjective type, vector<XVariable *> &list) {
+    buildObjectiveMinimize(type, list);
+    minimize = false;
+}
+
+
+void XCSP3SolutionChecker::buildObjectiveMinimize(ExpressionObjective type, vector<Tree *> &trees, vector<int> &coefs) {
+    XCheckerObjective *o = new XCheckerObjective(type);
+    terms(trees, o, o->terms);
+    o->coefs = coefs;
+    setObjective(true, o);
+}
+
+
+void XCSP3SolutionChecker::buildObjectiveMaximize(ExpressionObjective type, vector<Tree *> &trees, vector<int> &coefs) {
+    buildObjectiveMinimize(type, trees, coefs);
+    minimize = false;
+}
+
+
+void XCSP3SolutionChecker::buildObjectiveMinimize(ExpressionObjective type, vector<Tree *> &trees) {
+    XCheckerObjective *o = new XCheckerObjective(type);
+    terms(trees, o, o->terms);
+    setObjective(true, o);
+}
+
+
+void XCSP3SolutionChecker::buildObjectiveMaximize(ExpressionObjective type, vector<Tree *> &trees) {
+    buildObjectiveMinimize(type, trees);
+    minimize = false;
+}
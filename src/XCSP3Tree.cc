@@ -27,6 +27,7 @@
 
 #include "XCSP3Tree.h"
 #include "XCSP3TreeNode.h"
+#include "XCSP3utils.h"
 #include <sstream>
 #include <vector>
 #include <limits>
@@ -37,26 +38,6 @@ using namespace XCSP3Core;
 using namespace std;
 
 
-// trim from start
-
-static inline std::string &ltrim(std::string &s) {
-    s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char c){ return !std::isspace(c); }));
-    return s;
-}
-
-// trim from end
-
-static inline std::string &rtrim(std::string &s) {
-    s.erase(std::find_if(s.rbegin(), s.rend(), [](unsigned char c){ return !std::isspace(c); }).base(), s.end());
-    return s;
-}
-
-// trim from both ends
-
-static inline std::string &trim(std::string &s) {
-    return ltrim(rtrim(s));
-}
-
 template <typename T>
 static T min(T v1, T v2, T v3) {
     if (v1 == -1) v1 = std::numeric_limits<T>::max();
@@ -108,6 +89,28 @@ Node *Tree::fromStringToTree(std::string current) {
 }
 
 extern NodeOperator* createNodeOperator(std::string currentElement);
+extern NodeOperator *createNodeOperator(ExpressionType type);
+
+
+static Node *copyNode(Node *node) {
+    if(node->type == ODECIMAL)
+        return new NodeConstant(static_cast<NodeConstant *>(node)->val);
+    if(node->type == OVAR)
+        return new NodeVariable(static_cast<NodeVariable *>(node)->var);
+    NodeOperator *tmp = createNodeOperator(node->type);
+    for(Node *p : node->parameters)
+        tmp->addParameter(copyNode(p));
+    return tmp;
+}
+
+
+Tree *Tree::copy() {
+    Tree *tree = new Tree(copyNode(root));
+    tree->expr = expr;
+    tree->listOfVariables = listOfVariables;
+    return tree;
+}
+
 void Tree::createOperator(string currentElement, std::vector<NodeOperator*> &stack,std::vector<Node*> &params) {
 
     NodeOperator *tmp = createNodeOperator(currentElement);
@@ -139,10 +142,10 @@ void Tree::closeOperator(std::vector<NodeOperator*> &stack,std::vector<Node*> &p
 
 // string currentElement, std::vector<NodeOperator*> &stack,std::vector<Node*> &params
 void Tree::createBasicParameter(string currentElement, std::vector<NodeOperator*> &,std::vector<Node*> &params) {
-    try {
-        int nb = stoi(currentElement);
+    int nb;
+    if(parseInteger(currentElement, nb))
         params.push_back(new NodeConstant(nb));
-    } catch (invalid_argument const &) {
+    else {
         int position = -1;
         for (unsigned int i = 0; i < listOfVariables.size(); i++)
             if (listOfVariables[i] == currentElement) {
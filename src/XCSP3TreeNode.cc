@@ -150,6 +150,49 @@ NodeOperator *createNodeOperator(std::string op) {
 }
 
 
+NodeOperator *createNodeOperator(ExpressionType type) {
+    switch(type) {
+        case ONEG: return new NodeNeg();
+        case OABS: return new NodeAbs();
+
+        case OADD: return new NodeAdd();
+        case OSUB: return new NodeSub();
+        case OMUL: return new NodeMult();
+        case ODIV: return new NodeDiv();
+        case OMOD: return new NodeMod();
+
+        case OSQR: return new NodeSquare();
+        case OPOW: return new NodePow();
+
+        case OMIN: return new NodeMin();
+        case OMAX: return new NodeMax();
+        case ODIST: return new NodeDist();
+
+        case OLE: return new NodeLE();
+        case OLT: return new NodeLT();
+        case OGE: return new NodeGE();
+        case OGT: return new NodeGT();
+
+        case ONE: return new NodeNE();
+        case OEQ: return new NodeEQ();
+
+        case ONOT: return new NodeNot();
+        case OAND: return new NodeAnd();
+        case OOR: return new NodeOr();
+        case OXOR: return new NodeXor();
+        case OIMP: return new NodeImp();
+        case OIF: return new NodeIf();
+        case OIFF: return new NodeIff();
+
+        case OIN: return new NodeIn();
+        case ONOTIN: return new NodeNotIn();
+        case OSET: return new NodeSet();
+        default:
+            throw std::runtime_error("in expression, unexpected operator " + operatorToString(type));
+    }
+}
+
+
 ExpressionType XCSP3Core::logicalInversion(ExpressionType type) {
     return type == OLT ? OGE
                        : type == OLE ? OGT
@@ -216,194 +259,287 @@ bool compareNodes(Node *a, Node *b) {
 }
 
 
-bool pattern(Node *node, std::string s,
-             std::vector<ExpressionType> &operators, std::vector<int> &constants, std::vector<std::string> &variables, bool fakeR=false) {
-    constants.clear();
-    variables.clear();
-    operators.clear();
-    Tree pattern(s);
-    if(fakeR)
-        pattern.root->type= OFAKEOP;
-    return Node::areSimilar(node, pattern.root, operators, constants, variables);
-}
-
+// -----------------------------------------
+// Canonization rules
+// -----------------------------------------
+// A rule receives an operator whose parameters are canonized (and sorted if the operator is symmetric).
+// It returns nullptr if it does not apply, the rewritten node otherwise. Rules are dispatched on the type
+// of the operator (see canonizeRules) and applied until none matches (see canonizeRoot).
 
-Node *NodeOperator::canonize() {
-    std::vector<int> constants;
-    std::vector<std::string> variables;
-    std::vector<ExpressionType> operators;
+typedef Node *(*CanonizeRule)(NodeOperator *node);
 
+static Node *canonizeRoot(Node *node);
 
-    std::vector<Node *> newParams;
-    for(Node *n : parameters)
-        newParams.push_back(n->canonize());
 
-    if(isSymmetricOperator(type))
-        std::sort(newParams.begin(), newParams.end(), compareNodes);
+// A pattern tree, parsed once. If anyOperator is true, the root of the pattern matches any operator
+class CanonizePattern {
+    Tree tree;
 
+public:
+    CanonizePattern(std::string expression, bool anyOperator) : tree(expression) {
+        if(anyOperator)
+            tree.root->type = OFAKEOP;
+    }
 
-    ExpressionType newType = type;
 
-    // newParams are potentially sorted if the type corresponds to a non-symmetric binary relational operator (in that case, we swap newParams and
-    // arithmetically
-    // inverse the operator)
-    if(newParams.size() == 2 && isNonSymmetricRelationalOperator(type) &&
-       (static_cast<int>(arithmeticInversion(type)) < static_cast<int>(type)
-        || (arithmeticInversion(type) == type && equalNodes(newParams[0], newParams[1]) > 0))) {
-        newType = arithmeticInversion(type);
-        Node *tmp = newParams[0];
-        newParams[0] = newParams[1];
-        newParams[1] = tmp;
-        return createNodeOperator(operatorToString(newType))->addParameters(newParams)->canonize();
+    bool match(Node *node, std::vector<int> &constants, std::vector<std::string> &variables) const {
+        std::vector<ExpressionType> operators;
+        constants.clear();
+        variables.clear();
+        return Node::areSimilar(node, tree.root, operators, constants, variables);
     }
+};
+
+
+// The parameters are sorted if the type corresponds to a non-symmetric binary relational operator
+// (in that case, we swap the parameters and arithmetically inverse the operator)
+static Node *invertRelation(NodeOperator *node) {
+    ExpressionType type = node->type;
+    if(node->parameters.size() != 2 || (static_cast<int>(arithmeticInversion(type)) >= static_cast<int>(type)
+       && (arithmeticInversion(type) != type || equalNodes(node->parameters[0], node->parameters[1]) <= 0)))
+        return nullptr;
+    return createNodeOperator(arithmeticInversion(type))->addParameter(node->parameters[1])->addParameter(node->parameters[0]);
+}
 
 
-    // Now, some specific reformulation rules are applied
-    if(newType == OLT && newParams[1]->type == ODECIMAL) { // lt(x,k) becomes le(x,k-1)
-        NodeConstant *c = dynamic_cast<NodeConstant *>(newParams[1]);
+static Node *strictToLarge(NodeOperator *node) {
+    if(node->parameters.size() != 2)
+        return nullptr;
+    if(node->parameters[1]->type == ODECIMAL) { // lt(x,k) becomes le(x,k-1)
+        NodeConstant *c = static_cast<NodeConstant *>(node->parameters[1]);
         c->val = c->val - 1;
-        return (new NodeLE())->addParameter(newParams[0])->addParameter(newParams[1])->canonize();
+        return (new NodeLE())->addParameters(node->parameters);
     }
-    if(newType == OLT && newParams[0]->type == ODECIMAL) { // lt(k,x) becomes le(k+1,x)
-        NodeConstant *c = dynamic_cast<NodeConstant *>(newParams[0]);
+    if(node->parameters[0]->type == ODECIMAL) { // lt(k,x) becomes le(k+1,x)
+        NodeConstant *c = static_cast<NodeConstant *>(node->parameters[0]);
         c->val = c->val + 1;
-        return (new NodeLE())->addParameter(newParams[0])->addParameter(newParams[1])->canonize();
+        return (new NodeLE())->addParameters(node->parameters);
     }
+    return nullptr;
+}
 
 
-    NodeOperator *tmp = dynamic_cast<NodeOperator *>(newParams[0]);  // abs(sub becomes dist
-    if(newType == OABS && newParams[0]->type == OSUB)
-        return (new NodeDist())->addParameters(tmp->parameters)->canonize();
+static Node *absToDist(NodeOperator *node) { // abs(sub becomes dist
+    if(node->parameters[0]->type != OSUB)
+        return nullptr;
+    return (new NodeDist())->addParameters(node->parameters[0]->parameters);
+}
 
-    if(newType == ONOT && newParams[0]->type == ONOT)   // NOT(NOT.. becomes ..
-        return tmp->parameters[0]->canonize();
 
-    if(newType == ONEG && newParams[0]->type == ONEG) // neg(neg(...)) becomes ...
-        return tmp->parameters[0]->canonize();
+static Node *doubleNegation(NodeOperator *node) { // not(not(...)) and neg(neg(...)) become ...
+    if(node->parameters[0]->type != node->type)
+        return nullptr;
+    return node->parameters[0]->parameters[0];
+}
 
-    if(newType == ONOT && logicalInversion(newParams[0]->type) != OUNDEF) // not(lt(...)) becomes ge(...), not(eq(...)) becomes ne(...), and
-        return createNodeOperator(operatorToString(logicalInversion(newParams[0]->type)))->addParameters(tmp->parameters)->canonize();
 
+static Node *negatedRelation(NodeOperator *node) { // not(lt(...)) becomes ge(...), not(eq(...)) becomes ne(...)
+    ExpressionType inversion = logicalInversion(node->parameters[0]->type);
+    if(inversion == OUNDEF)
+        return nullptr;
+    return createNodeOperator(inversion)->addParameters(node->parameters[0]->parameters);
+}
 
-    if(newParams.size() == 1 && (newType == OADD || newType == OMUL || newType == OMIN || newType == OMAX || newType == OEQ || newType == OAND
-                                 || newType == OOR || newType == OXOR || newType == OIFF)) // certainly can happen during the canonization process
-        return newParams[0];
 
-    if(newType == OADD || newType == OMUL) {// we merge constant (similar operations possible for MUL, MIN, ...)
-        // They are at the end of the add
-        NodeConstant *c1, *c2;
-        if(newParams.size() >= 2 && (c1 = dynamic_cast<NodeConstant *>(newParams[newParams.size() - 1])) != nullptr &&
-           (c2 = dynamic_cast<NodeConstant *>(newParams[newParams.size() - 2])) != nullptr) {
-            std::vector<Node *> l;
-            l.insert(l.end(), newParams.begin(), newParams.end() - 2);
-            l.push_back(newType == OADD ? new NodeConstant(c1->val + c2->val) : new NodeConstant(c1->val * c2->val));
+static Node *singleParameter(NodeOperator *node) { // certainly can happen during the canonization process
+    return node->parameters.size() == 1 ? node->parameters[0] : nullptr;
+}
 
-            if(newType == OADD)
-                return ((new NodeAdd())->addParameters(l))->canonize();
-            else
-                return ((new NodeMult())->addParameters(l))->canonize();
-        }
-    }
 
+static Node *mergeConstants(NodeOperator *node) { // constants are at the end of add and mul
+    std::vector<Node *> &params = node->parameters;
+    if(params.size() < 2 || params[params.size() - 1]->type != ODECIMAL || params[params.size() - 2]->type != ODECIMAL)
+        return nullptr;
+    int c1 = static_cast<NodeConstant *>(params[params.size() - 1])->val;
+    int c2 = static_cast<NodeConstant *>(params[params.size() - 2])->val;
+    std::vector<Node *> l(params.begin(), params.end() - 2);
+    l.push_back(new NodeConstant(node->type == OADD ? c1 + c2 : c1 * c2));
+    return createNodeOperator(node->type)->addParameters(l);
+}
 
 
+static Node *shiftConstant(NodeOperator *node) {
+    static const CanonizePattern varPlusK("le(add(y[4],5),7)", true);
+    static const CanonizePattern kVarPlusK("le(8,add(y[4],5))", true);
+    static const CanonizePattern kKPlusVar("le(8,add(5,y[4]))", true);
+    std::vector<int> constants;
+    std::vector<std::string> variables;
 
     //le(add(y[4],5),7) -> le(y[4],2)
-    if(pattern(this, "le(add(y[4],5),7)", operators, constants, variables, true)) {
-        if(newType == OEQ || newType == ONE || newType == OLE || newType == OLT)
-            return createNodeOperator(operatorToString(newType))
-                    ->addParameter(new NodeVariable(variables[0]))->addParameter(new NodeConstant(constants[1] - constants[0]))->canonize();
-    }
+    if(varPlusK.match(node, constants, variables))
+        return createNodeOperator(node->type)
+                ->addParameter(new NodeVariable(variables[0]))->addParameter(new NodeConstant(constants[1] - constants[0]));
 
     //le(8,add(5,y[4])) -> le(3, y[4])
-    if(pattern(this, "le(8,add(y[4],5))", operators, constants, variables, true)) {
-        if(newType == OEQ || newType == ONE || newType == OLE || newType == OLT)
-            return createNodeOperator(operatorToString(newType))
-                    ->addParameter(new NodeConstant(constants[0] - constants[1]))->addParameter(new NodeVariable(variables[0]))->canonize();
-    }
+    if(kVarPlusK.match(node, constants, variables) || kKPlusVar.match(node, constants, variables))
+        return createNodeOperator(node->type)
+                ->addParameter(new NodeConstant(constants[0] - constants[1]))->addParameter(new NodeVariable(variables[0]));
+    return nullptr;
+}
 
-    //le(8,add(5,y[4]))->le(3, y[4])
-    if(pattern(this, "le(8,add(5,y[4]))", operators, constants, variables, true)) {
-        if(newType == OEQ || newType == ONE || newType == OLE || newType == OLT)
-            return createNodeOperator(operatorToString(newType))
-                    ->addParameter(new NodeConstant(constants[0] - constants[1]))->addParameter(new NodeVariable(variables[0]))->canonize();
-    }
+
+static Node *divideConstant(NodeOperator *node) {
+    static const CanonizePattern varTimesK("eq(mul(y[0],3),9)", false);
+    static const CanonizePattern kTimesVar("eq(mul(3,x),6)", false);
+    static const CanonizePattern kKTimesVar("eq(9,mul(3,y[0]))", false);
+    static const CanonizePattern kVarTimesK("eq(9,mul(y[0],3))", false);
+    std::vector<int> constants;
+    std::vector<std::string> variables;
 
     // eq(mul(y[0],3),9) -> eq(y[0],3)
-    if(pattern(this, "eq(mul(y[0],3),9)", operators, constants, variables) ||
-            pattern(this, "eq(mul(3,x),6)", operators, constants, variables)) {
+    if(varTimesK.match(node, constants, variables) || kTimesVar.match(node, constants, variables)) {
         if(constants[1] % constants[0] != 0)
             return new NodeConstant(0);
-        return (new NodeEQ())->addParameter(new NodeVariable(variables[0]))->addParameter(new NodeConstant(constants[1] / constants[0]))->canonize();
+        return (new NodeEQ())->addParameter(new NodeVariable(variables[0]))->addParameter(new NodeConstant(constants[1] / constants[0]));
     }
 
     //eq(9,mul(3,y[0]))
-    if(pattern(this, "eq(9,mul(3,y[0]))", operators, constants, variables) ||
-            pattern(this, "eq(9,mul(y[0],3))", operators, constants, variables)) {
+    if(kKTimesVar.match(node, constants, variables) || kVarTimesK.match(node, constants, variables)) {
         if(constants[0] % constants[1] != 0)
             return new NodeConstant(0);
-        return (new NodeEQ())->addParameter(new NodeVariable(variables[0]))->addParameter(new NodeConstant(constants[0] / constants[1]))->canonize();
+        return (new NodeEQ())->addParameter(new NodeVariable(variables[0]))->addParameter(new NodeConstant(constants[0] / constants[1]));
     }
+    return nullptr;
+}
 
-    // Then, we merge operators when possible; for example add(add(x,y),z) becomes add(x,y,z)
-    if(isSymmetricOperator(newType) && newType != OEQ && newType != ODIST && newType != ODJOINT) {
-        for(unsigned int i = 0; i < newParams.size(); i++) {
-            NodeOperator *n;
-            if((n = dynamic_cast<NodeOperator *>(newParams[i])) != nullptr && n->type == newType) {
-                std::vector<Node *> list;
-                for(unsigned int j = 0; j < i; j++)
-                    list.push_back(newParams[j]);
-
-                list.insert(list.end(), n->parameters.begin(), n->parameters.end());
-
-                for(unsigned int j = i + 1; j < newParams.size(); j++)
-                    list.push_back(newParams[j]);
-                return ((createNodeOperator(operatorToString(newType)))->addParameters(list))->canonize();
-            }
+
+static Node *flatten(NodeOperator *node) { // add(add(x,y),z) becomes add(x,y,z)
+    std::vector<Node *> &params = node->parameters;
+    for(unsigned int i = 0; i < params.size(); i++) {
+        if(params[i]->type == node->type) {
+            std::vector<Node *> list(params.begin(), params.begin() + i);
+            list.insert(list.end(), params[i]->parameters.begin(), params[i]->parameters.end());
+            list.insert(list.end(), params.begin() + i + 1, params.end());
+            return createNodeOperator(node->type)->addParameters(list);
         }
     }
-    if(newParams.size() == 2 && isRelationalOperator(type)) {
-        NodeOperator *n0 = dynamic_cast<NodeOperator *>(newParams[0]);
-        NodeOperator *n1 = dynamic_cast<NodeOperator *>(newParams[1]);
-        // First, we replace sub by add when possible
-        if(newParams[0]->type == OSUB && newParams[1]->type == OSUB) {
-            Node *a = (new NodeAdd())->addParameter(n0->parameters[0])->addParameter(n1->parameters[1]);
-            Node *b = (new NodeAdd())->addParameter(n1->parameters[0])->addParameter(n0->parameters[1]);
-            return (createNodeOperator(operatorToString(newType)))->addParameter(a)->addParameter(b)->canonize();
-        } else if(newParams[1]->type == OSUB) {
-            Node *a = (new NodeAdd())->addParameter(newParams[0])->addParameter(n1->parameters[1]);
-            Node *b = n1->parameters[0];
-            return (createNodeOperator(operatorToString(newType)))->addParameter(a)->addParameter(b)->canonize();
-        } else if(n0 != nullptr && n0->op == "sub") {
-            Node *a = n0->parameters[0];
-            Node *b = (new NodeAdd())->addParameter(newParams[1])->addParameter(n0->parameters[1]);
-            return (createNodeOperator(operatorToString(newType)))->addParameter(a)->addParameter(b)->canonize();
-        }
+    return nullptr;
+}
 
-        // next, we remove some add when possible
-        if(newParams[0]->type == OADD && newParams[1]->type == ODECIMAL) {
-            if(n0->parameters.size() == 2 && n0->parameters[0]->type == OVAR && n0->parameters[1]->type == ODECIMAL) {
-                NodeConstant *c1 = dynamic_cast<NodeConstant *>(newParams[1]);
-                NodeConstant *c2 = dynamic_cast<NodeConstant *>(n0->parameters[1]);
-                return (createNodeOperator(operatorToString(newType)))->addParameter(n0->parameters[0])->addParameter(
-                        new NodeConstant(c1->val - c2->val))->canonize();
-            }
-        }
 
-        if(n0 != nullptr && n1 != nullptr && n0->type == OADD && n1->type == OADD) {
-            NodeConstant *c1, *c2;
-            if(n0->parameters.size() == 2 && n1->parameters.size() == 2 &&
-               (c1 = dynamic_cast<NodeConstant *>(n0->parameters[1])) != nullptr &&
-               (c2 = dynamic_cast<NodeConstant *>(n1->parameters[1])) != nullptr) {
-                c1->val = c1->val - c2->val;
-                newParams[1] = n1->parameters[0];
-                return (createNodeOperator(operatorToString(newType)))->addParameters(newParams)->canonize();
-            }
-        }
+static Node *subToAdd(NodeOperator *node) { // we replace sub by add when possible
+    if(node->parameters.size() != 2)
+        return nullptr;
+    Node *n0 = node->parameters[0];
+    Node *n1 = node->parameters[1];
+    Node *a, *b;
+    if(n0->type == OSUB && n1->type == OSUB) {
+        a = (new NodeAdd())->addParameter(n0->parameters[0])->addParameter(n1->parameters[1]);
+        b = (new NodeAdd())->addParameter(n1->parameters[0])->addParameter(n0->parameters[1]);
+    } else if(n1->type == OSUB) {
+        a = (new NodeAdd())->addParameter(n0)->addParameter(n1->parameters[1]);
+        b = n1->parameters[0];
+    } else if(n0->type == OSUB) {
+        a = n0->parameters[0];
+        b = (new NodeAdd())->addParameter(n1)->addParameter(n0->parameters[1]);
+    } else
+        return nullptr;
+    return createNodeOperator(node->type)->addParameter(canonizeRoot(a))->addParameter(canonizeRoot(b));
+}
 
+
+static Node *removeAdd(NodeOperator *node) { // rel(add(x,k1),k2) becomes rel(x,k2-k1)
+    if(node->parameters.size() != 2)
+        return nullptr;
+    Node *n0 = node->parameters[0];
+    if(n0->type != OADD || node->parameters[1]->type != ODECIMAL || n0->parameters.size() != 2 || n0->parameters[0]->type != OVAR ||
+       n0->parameters[1]->type != ODECIMAL)
+        return nullptr;
+    NodeConstant *c1 = static_cast<NodeConstant *>(node->parameters[1]);
+    NodeConstant *c2 = static_cast<NodeConstant *>(n0->parameters[1]);
+    return createNodeOperator(node->type)->addParameter(n0->parameters[0])->addParameter(new NodeConstant(c1->val - c2->val));
+}
+
+
+static Node *cancelConstants(NodeOperator *node) { // rel(add(x,k1),add(y,k2)) becomes rel(add(x,k1-k2),y)
+    if(node->parameters.size() != 2)
+        return nullptr;
+    Node *n0 = node->parameters[0];
+    Node *n1 = node->parameters[1];
+    if(n0->type != OADD || n1->type != OADD || n0->parameters.size() != 2 || n1->parameters.size() != 2 ||
+       n0->parameters[1]->type != ODECIMAL || n1->parameters[1]->type != ODECIMAL)
+        return nullptr;
+    NodeConstant *c1 = static_cast<NodeConstant *>(n0->parameters[1]);
+    NodeConstant *c2 = static_cast<NodeConstant *>(n1->parameters[1]);
+    c1->val = c1->val - c2->val;
+    return createNodeOperator(node->type)->addParameter(n0)->addParameter(n1->parameters[0]);
+}
+
+
+static bool isShiftable(ExpressionType type) {
+    return type == OEQ || type == ONE || type == OLE || type == OLT;
+}
+
+
+static bool isFlattenable(ExpressionType type) {
+    return isSymmetricOperator(type) && type != OEQ && type != ODIST && type != ODJOINT;
+}
+
+
+static bool acceptsOneParameter(ExpressionType type) {
+    return type == OADD || type == OMUL || type == OMIN || type == OMAX || type == OEQ || type == OAND || type == OOR || type == OXOR ||
+           type == OIFF;
+}
+
+
+// The rules in the order they are tried, and the operators they apply to
+static const struct {
+    CanonizeRule rule;
+    bool (*accepts)(ExpressionType);
+} canonizeRuleTable[] = {
+        {invertRelation,  isNonSymmetricRelationalOperator},
+        {strictToLarge,   [](ExpressionType type) { return type == OLT; }},
+        {absToDist,       [](ExpressionType type) { return type == OABS; }},
+        {doubleNegation,  [](ExpressionType type) { return type == ONOT || type == ONEG; }},
+        {negatedRelation, [](ExpressionType type) { return type == ONOT; }},
+        {singleParameter, acceptsOneParameter},
+        {mergeConstants,  [](ExpressionType type) { return type == OADD || type == OMUL; }},
+        {shiftConstant,   isShiftable},
+        {divideConstant,  [](ExpressionType type) { return type == OEQ; }},
+        {flatten,         isFlattenable},
+        {subToAdd,        isRelationalOperator},
+        {removeAdd,       isRelationalOperator},
+        {cancelConstants, isRelationalOperator}
+};
+
+
+static const std::vector<CanonizeRule> &canonizeRules(ExpressionType type) {
+    static const std::vector<std::vector<CanonizeRule> > rules = []() {
+        std::vector<std::vector<CanonizeRule> > tmp(OFAKEOP + 1);
+        for(unsigned int t = 0; t < tmp.size(); t++)
+            for(auto &r : canonizeRuleTable)
+                if(r.accepts(static_cast<ExpressionType>(t)))
+                    tmp[t].push_back(r.rule);
+        return tmp;
+    }();
+    return rules[type];
+}
+
+
+// Apply the rules on a node whose parameters are canonized, until a fixpoint is reached
+static Node *canonizeRoot(Node *node) {
+    while(node->type != ODECIMAL && node->type != OVAR) {
+        NodeOperator *op = static_cast<NodeOperator *>(node);
+        if(isSymmetricOperator(op->type))
+            std::sort(op->parameters.begin(), op->parameters.end(), compareNodes);
+        Node *rewritten = nullptr;
+        for(CanonizeRule rule : canonizeRules(op->type))
+            if((rewritten = rule(op)) != nullptr)
+                break;
+        if(rewritten == nullptr)
+            break;
+        node = rewritten;
     }
+    return node;
+}
 
-    return (createNodeOperator(operatorToString(newType)))->addParameters(newParams);
+
+Node *NodeOperator::canonize() {
+    NodeOperator *canonized = createNodeOperator(type);
+    canonized->parameters.reserve(parameters.size());
+    for(Node *n : parameters)
+        canonized->parameters.push_back(n->canonize());
+    return canonizeRoot(canonized);
 }
 
 
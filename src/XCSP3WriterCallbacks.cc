@@ -0,0 +1,1525 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ * 
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#include "XCSP3WriterCallbacks.h"
+#include "XCSP3Tree.h"
+#include <algorithm>
+#include <unordered_map>
+
+using namespace XCSP3Core;
+
+// Above this number of distinct domains in an array, domains are not shared anymore
+#define MAX_SHARED_DOMAINS 64
+
+static const char digitPairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+static const char *operators[] = {"le", "lt", "ge", "gt", "in", "eq", "ne", "notin"};
+
+static const char *objectives[] = {"expression", "sum", "product", "minimum", "maximum", "nValues", "lex"};
+
+
+/***************************************************************************
+ * The buffered writer
+ **************************************************************************/
+
+char *XCSP3BufferedWriter::format(long long value, char *end) {
+    unsigned long long v = value < 0 ? 0 - (unsigned long long) value : value;
+    while(v >= 100) {
+        int pair = (v % 100) * 2;
+        v /= 100;
+        *--end = digitPairs[pair + 1];
+        *--end = digitPairs[pair];
+    }
+    if(v >= 10) {
+        *--end = digitPairs[v * 2 + 1];
+        *--end = digitPairs[v * 2];
+    } else
+        *--end = '0' + v;
+    if(value < 0)
+        *--end = '-';
+    return end;
+}
+
+
+XCSP3BufferedWriter &XCSP3BufferedWriter::put(long long value) {
+    if(size + 24 > buffer.size())
+        flush();
+    char tmp[24];
+    char *begin = format(value, tmp + 24);
+    std::memcpy(buffer.data() + size, begin, tmp + 24 - begin);
+    size += tmp + 24 - begin;
+    return *this;
+}
+
+
+static void append(string &s, long long value) {
+    char tmp[24];
+    char *begin = XCSP3BufferedWriter::format(value, tmp + 24);
+    s.append(begin, tmp + 24 - begin);
+}
+
+
+// Sorted values with intervals: 1..5 7 9..10 (STAR is written *)
+static void appendRanges(string &s, const vector<int> &values) {
+    for(unsigned int i = 0 ; i < values.size() ; i++) {
+        if(i > 0)
+            s += ' ';
+        if(values[i] == STAR) {
+            s += '*';
+            continue;
+        }
+        unsigned int j = i;
+        while(j + 1 < values.size() && values[j + 1] != STAR && (long long) values[j + 1] <= (long long) values[j] + 1)
+            j++;
+        append(s, values[i]);
+        if(values[j] > values[i] + 1) {
+            s += "..";
+            append(s, values[j]);
+        } else if(values[j] == values[i] + 1) {
+            s += ' ';
+            append(s, values[j]);
+        }
+        i = j;
+    }
+}
+
+
+// x[3][4] -> position of the last [ and 4
+static bool lastIndex(const string &id, size_t &bracket, int &index) {
+    if(id.empty() || id.back() != ']')
+        return false;
+    bracket = id.rfind('[');
+    if(bracket == string::npos || bracket + 2 >= id.size())
+        return false;
+    index = 0;
+    for(size_t i = bracket + 1 ; i + 1 < id.size() ; i++) {
+        if(id[i] < '0' || id[i] > '9')
+            return false;
+        index = index * 10 + id[i] - '0';
+    }
+    return true;
+}
+
+
+// Write the ids separated by spaces, runs of consecutive ids are compressed: x[2][3] x[2][4] x[2][5] -> x[2][3..5]
+// (unless compact is false). id(i) returns nullptr if the element i is not a variable, value(i) writes it
+template<class Id, class Value>
+static void writeRuns(XCSP3BufferedWriter &writer, size_t n, Id id, Value value, bool compact = true) {
+    for(size_t i = 0 ; i < n ; i++) {
+        if(i > 0)
+            writer.put(' ');
+        const string *first = id(i);
+        if(first == nullptr) {
+            value(i);
+            continue;
+        }
+        size_t bracket, other;
+        int index, next;
+        size_t j = i + 1;
+        if(compact && lastIndex(*first, bracket, index)) {
+            while(j < n) {
+                const string *current = id(j);
+                if(current == nullptr || lastIndex(*current, other, next) == false || other != bracket ||
+                   next != index + (int) (j - i) || current->compare(0, bracket, *first, 0, bracket) != 0)
+                    break;
+                j++;
+            }
+        }
+        if(j - i == 1) {
+            writer.put(*first);
+            continue;
+        }
+        writer.put(first->data(), bracket + 1).put((long long) index).put("..", 2).put((long long) (index + j - i - 1)).put(']');
+        i = j - 1;
+    }
+}
+
+
+/***************************************************************************
+ * The callbacks
+ **************************************************************************/
+
+// Constraints written back as the template of a group: the parser unfolds the parameters of all the parts they write
+static const char *templateTags[] = {"intension", "extension", "allDifferent", "allEqual", "sum", "count", "nValues", "ordered"};
+
+
+static bool isTokenDelimiter(char c) {
+    return c == ' ' || c == '(' || c == ')' || c == ',' || c == '<' || c == '>' || c == '"' || c == '{' || c == '}' || c == '\n';
+}
+
+
+// Arguments of a row that are replaced by %i in the template of a group (integers only inside an intension expression)
+static bool isParameter(XVariable *x, bool intension) {
+    return x->kind == VARIABLE_E || (intension && x->kind == INTEGER_E);
+}
+
+
+// The constraint line with the arguments replaced by %i (the first i for an argument given twice).
+// used[i] is set if %i occurs
+static string rowTemplate(const string &line, XSpan<XVariable *> row, bool intension, vector<bool> &used) {
+    std::unordered_map<string, int> parameters;
+    for(size_t i = 0 ; i < row.size() ; i++)
+        if(isParameter(row[i], intension))
+            parameters.emplace(row[i]->id, (int) i);
+
+    size_t body = line.find('>');   // the opening tag is kept
+    if(body == string::npos)
+        return line;
+    string pattern(line, 0, body);
+    for(size_t i = body ; i < line.size() ;) {
+        if(isTokenDelimiter(line[i])) {
+            pattern += line[i++];
+            continue;
+        }
+        size_t j = i;
+        while(j < line.size() && isTokenDelimiter(line[j]) == false)
+            j++;
+        auto parameter = parameters.find(line.substr(i, j - i));
+        if(parameter == parameters.end())
+            pattern.append(line, i, j - i);
+        else {
+            pattern += '%';
+            append(pattern, parameter->second);
+            used[parameter->second] = true;
+        }
+        i = j;
+    }
+    return pattern;
+}
+
+
+// The constraint written for a row from the template (as the parser unfolds it), false if a parameter is missing
+static bool instantiate(const string &pattern, XSpan<XVariable *> row, string &line) {
+    line.clear();
+    for(size_t i = 0 ; i < pattern.size() ;) {
+        if(pattern[i] != '%' || i == 0 || isTokenDelimiter(pattern[i - 1]) == false) {
+            line += pattern[i++];
+            continue;
+        }
+        size_t j = i + 1, number = 0;
+        while(j < pattern.size() && pattern[j] >= '0' && pattern[j] <= '9')
+            number = number * 10 + pattern[j++] - '0';
+        if(j == i + 1 || number >= row.size())
+            return false;
+        line += row[number]->id;
+        i = j;
+    }
+    return true;
+}
+
+
+XCSP3WriterCallbacks::XCSP3WriterCallbacks(std::ostream &out) : writer(out), lastInterval(false), grouping(false), slide(false),
+                                                                slideCircular(false), groupArgs(nullptr) {
+    intensionUsingString = true;
+    recognizeSpecialIntensionCases = false;
+    recognizeSpecialCountCases = false;
+    recognizeNValuesCases = false;
+}
+
+
+void XCSP3WriterCallbacks::open(const char *tag, const string &id, bool attributes) {
+    writer.put("  <", 3).put(tag);
+    if(id.empty() == false)
+        writer.put(" id=\"", 5).put(id).put('"');
+    if(attributes == false)
+        writer.put('>');
+}
+
+
+void XCSP3WriterCallbacks::close(const char *tag) {
+    writer.put(" </", 3).put(tag).put(">\n", 2);
+}
+
+
+void XCSP3WriterCallbacks::writeList(vector<XVariable *> &list) {
+    // Inside a group, each argument must be a token of its own (see rowTemplate)
+    writeRuns(writer, list.size(),
+              [&list](size_t i) { return list[i]->kind == INTEGER_E ? nullptr : &list[i]->id; },
+              [this, &list](size_t i) { writer.put((long long) ((XInteger *) list[i])->value); }, grouping == false);
+}
+
+
+void XCSP3WriterCallbacks::writeArguments(XSpan<XVariable *> list) {
+    writeRuns(writer, list.size(),
+              [&list](size_t i) { return list[i]->kind == INTEGER_E ? nullptr : &list[i]->id; },
+              [this, &list](size_t i) { writer.put((long long) ((XInteger *) list[i])->value); });
+}
+
+
+void XCSP3WriterCallbacks::writeList(vector<Tree *> &list) {
+    for(unsigned int i = 0 ; i < list.size() ; i++) {
+        if(i > 0)
+            writer.put(' ');
+        writeValue(list[i]);
+    }
+}
+
+
+void XCSP3WriterCallbacks::writeList(vector<int> &list) {
+    for(unsigned int i = 0 ; i < list.size() ; i++) {
+        if(i > 0)
+            writer.put(' ');
+        writer.put((long long) list[i]);
+    }
+}
+
+
+void XCSP3WriterCallbacks::writeIds(vector<string> &ids) {
+    writeRuns(writer, ids.size(), [&ids](size_t i) { return &ids[i]; }, [](size_t) {});
+}
+
+
+template<class T>
+void XCSP3WriterCallbacks::writeList(const char *tag, vector<T> &list, int startIndex) {
+    writer.put(" <", 2).put(tag);
+    if(startIndex != 0)
+        writer.put(" startIndex=\"", 13).put((long long) startIndex).put('"');
+    writer.put("> ", 2);
+    writeList(list);
+    writer.put(" </", 3).put(tag).put('>');
+}
+
+
+template<class T>
+void XCSP3WriterCallbacks::writeMatrix(const char *tag, vector<vector<T> > &matrix, const char *attributes) {
+    writer.put(" <", 2).put(tag).put(attributes).put("> ", 2);
+    for(vector<T> &row : matrix) {
+        writer.put('(');
+        for(unsigned int j = 0 ; j < row.size() ; j++) {
+            if(j > 0)
+                writer.put(',');
+            writeValue(row[j]);
+        }
+        writer.put(')');
+    }
+    writer.put(" </", 3).put(tag).put('>');
+}
+
+
+void XCSP3WriterCallbacks::writeValue(XVariable *x) {
+    if(x->kind == INTEGER_E)
+        writer.put((long long) ((XInteger *) x)->value);
+    else
+        writer.put(x->id);
+}
+
+
+void XCSP3WriterCallbacks::writeValue(Tree *tree) {
+    writer.put(tree->toString());
+}
+
+
+void XCSP3WriterCallbacks::writeValue(int value) {
+    writer.put((long long) value);
+}
+
+
+void XCSP3WriterCallbacks::writeRanges(vector<int> &values) {
+    vector<int> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    text.clear();
+    appendRanges(text, sorted);
+    writer.put(text);
+}
+
+
+void XCSP3WriterCallbacks::writeCondition(XCondition &xc) {
+    writer.put(" <condition> (", 14).put(operators[xc.op]).put(',');
+    switch(xc.operandType) {
+        case INTEGER :
+            writer.put((long long) xc.val);
+            break;
+        case INTERVAL :
+            writer.put((long long) xc.min).put("..", 2).put((long long) xc.max);
+            break;
+        case VARIABLE :
+            writer.put(xc.var);
+            break;
+        case SET :
+            writer.put('{');
+            for(unsigned int i = 0 ; i < xc.set.size() ; i++) {
+                if(i > 0)
+                    writer.put(',');
+                writer.put((long long) xc.set[i]);
+            }
+            writer.put('}');
+            break;
+    }
+    writer.put(") </condition>", 14);
+}
+
+
+void XCSP3WriterCallbacks::writeOperator(OrderType op) {
+    writer.put(" <operator> ", 12).put(operators[op]).put(" </operator>", 12);
+}
+
+
+void XCSP3WriterCallbacks::writeIndex(XVariable *index, RankType rank) {
+    writer.put(" <index", 7);
+    if(rank != ANY)
+        writer.put(rank == FIRST ? " rank=\"first\"" : " rank=\"last\"");
+    writer.put("> ", 2);
+    writeValue(index);
+    writer.put(" </index>", 9);
+}
+
+
+void XCSP3WriterCallbacks::writeCardinalityValues(bool closed) {
+    writer.put(closed ? " <values closed=\"true\"> " : " <values> ");
+}
+
+
+void XCSP3WriterCallbacks::writeAutomaton(XAutomaton &automaton) {
+    writer.put(" <transitions> ", 15);
+    for(unsigned int i = 0 ; i < automaton.transitions.size() ; i += 3)
+        writer.put('(').put(automaton.states[automaton.transitions[i]]).put(',').put((long long) automaton.transitions[i + 1])
+                .put(',').put(automaton.states[automaton.transitions[i + 2]]).put(')');
+    writer.put(" </transitions>", 15);
+}
+
+
+template<class T>
+void XCSP3WriterCallbacks::writeObjective(bool minimize, ExpressionObjective type, vector<T> &list) {
+    writer.put(minimize ? "  <minimize type=\"" : "  <maximize type=\"").put(objectives[type]).put("\">", 2);
+    writeList("list", list);
+}
+
+
+//--------------------------------------------------------------------------------------
+// Structure of the instance
+//--------------------------------------------------------------------------------------
+
+void XCSP3WriterCallbacks::beginInstance(InstanceType type) {
+    writer.capture(nullptr);
+    grouping = false;
+    writer.put(type == COP ? "<instance format=\"XCSP3\" type=\"COP\">\n" : "<instance format=\"XCSP3\" type=\"CSP\">\n");
+}
+
+
+void XCSP3WriterCallbacks::endInstance() {
+    writer.put("</instance>\n");
+    writer.flush();
+}
+
+
+void XCSP3WriterCallbacks::beginVariables() {
+    writer.put("<variables>\n");
+}
+
+
+void XCSP3WriterCallbacks::endVariables() {
+    writer.put("</variables>\n");
+}
+
+
+void XCSP3WriterCallbacks::beginConstraints() {
+    writer.put("<constraints>\n");
+}
+
+
+void XCSP3WriterCallbacks::endConstraints() {
+    writer.put("</constraints>\n");
+}
+
+
+void XCSP3WriterCallbacks::beginBlock(string classes) {
+    writer.put("<block");
+    if(classes.empty() == false)
+        writer.put(" class=\"", 8).put(classes).put('"');
+    writer.put(">\n", 2);
+}
+
+
+void XCSP3WriterCallbacks::endBlock() {
+    writer.put("</block>\n");
+}
+
+
+void XCSP3WriterCallbacks::beginGroup(string id) {
+    beginCapture(id, false, false);
+}
+
+
+void XCSP3WriterCallbacks::groupArguments(string, XArguments &args) {
+    groupArgs = &args;
+}
+
+
+void XCSP3WriterCallbacks::endGroup() {
+    endCapture();
+}
+
+
+void XCSP3WriterCallbacks::beginSlide(string id, bool circular) {
+    beginCapture(id, true, circular);
+}
+
+
+void XCSP3WriterCallbacks::endSlide() {
+    endCapture();
+}
+
+
+void XCSP3WriterCallbacks::beginCapture(string &id, bool isSlide, bool isCircular) {
+    groupId = id;
+    slide = isSlide;
+    slideCircular = isCircular;
+    groupArgs = nullptr;
+    groupText.clear();
+    grouping = true;
+    writer.capture(&groupText);
+}
+
+
+// The template shared by all the constraints of the group, false if there is none
+bool XCSP3WriterCallbacks::groupTemplate(string &pattern) {
+    if(groupArgs == nullptr || groupArgs->size() == 0)
+        return false;
+    // One constraint per row
+    vector<size_t> starts(1, 0);
+    for(size_t end = groupText.find('\n') ; end != string::npos ; end = groupText.find('\n', end + 1))
+        starts.push_back(end + 1);
+    if(starts.size() != groupArgs->size() + 1 || starts.back() != groupText.size())
+        return false;
+
+    size_t tag = groupText.find('<'), tagEnd = groupText.find_first_of(" >", tag);
+    if(tag == string::npos || tagEnd == string::npos)
+        return false;
+    bool known = false;
+    for(const char *t : templateTags)
+        known = known || groupText.compare(tag + 1, tagEnd - tag - 1, t) == 0;
+    if(known == false)
+        return false;
+    bool intension = groupText.compare(tag + 1, tagEnd - tag - 1, "intension") == 0;
+
+    // The template comes from the first row whose arguments are all different (an argument given twice is ambiguous)
+    size_t base = 0;
+    for(size_t i = 0 ; i < groupArgs->size() ; i++) {
+        XSpan<XVariable *> row = (*groupArgs)[i];
+        std::unordered_map<string, int> ids;
+        bool different = true;
+        for(XVariable *x : row)
+            if(isParameter(x, intension) && ids.emplace(x->id, 0).second == false) {
+                different = false;
+                break;
+            }
+        if(different) {
+            base = i;
+            break;
+        }
+    }
+    XSpan<XVariable *> baseRow = (*groupArgs)[base];
+    vector<bool> used(baseRow.size(), false);
+    pattern = rowTemplate(groupText.substr(starts[base], starts[base + 1] - starts[base]), baseRow, intension, used);
+
+    // The arity of a slide is given by its template
+    if(slide)
+        for(size_t i = 0 ; i < groupArgs->arity() ; i++)
+            if(i >= used.size() || used[i] == false)
+                return false;
+
+    string line;
+    for(size_t i = 0 ; i < groupArgs->size() ; i++)
+        if(instantiate(pattern, (*groupArgs)[i], line) == false ||
+           groupText.compare(starts[i], starts[i + 1] - starts[i], line) != 0)
+            return false;
+    return true;
+}
+
+
+void XCSP3WriterCallbacks::endCapture() {
+    writer.capture(nullptr);
+    grouping = false;
+    string pattern;
+    if(groupTemplate(pattern) == false) {
+        writer.put(groupText);
+        return;
+    }
+    writer.put(slide ? "  <slide" : "  <group");
+    if(groupId.empty() == false)
+        writer.put(" id=\"", 5).put(groupId).put('"');
+    if(slideCircular)
+        writer.put(" circular=\"true\"");
+    writer.put(">\n", 2);
+    if(slide) {
+        // The list of a circular slide is followed by its first variables (see XArguments::setSlide)
+        XSpan<XVariable *> list = groupArgs->list();
+        size_t n = list.size() - (slideCircular && groupArgs->arity() > 0 ? groupArgs->arity() - 1 : 0);
+        writer.put("    <list offset=\"").put((long long) groupArgs->offset()).put("\"> ");
+        writeArguments(XSpan<XVariable *>(list.data(), n));
+        writer.put(" </list>\n");
+    }
+    writer.put("  ").put(pattern);
+    if(slide == false)
+        for(size_t i = 0 ; i < groupArgs->size() ; i++) {
+            writer.put("    <args> ");
+            writeArguments((*groupArgs)[i]);
+            writer.put(" </args>\n");
+        }
+    writer.put(slide ? "  </slide>\n" : "  </group>\n");
+}
+
+
+void XCSP3WriterCallbacks::beginObjectives() {
+    writer.put("<objectives>\n");
+}
+
+
+void XCSP3WriterCallbacks::endObjectives() {
+    writer.put("</objectives>\n");
+}
+
+
+void XCSP3WriterCallbacks::beginAnnotations() {
+    writer.put("<annotations>\n");
+}
+
+
+void XCSP3WriterCallbacks::endAnnotations() {
+    writer.put("</annotations>\n");
+}
+
+
+//--------------------------------------------------------------------------------------
+// Variables
+//--------------------------------------------------------------------------------------
+
+void XCSP3WriterCallbacks::beginVariableArray(string id) {
+    currentArray = id;
+    arrayVariables.clear();
+    arrayDomains.clear();
+    domains.clear();
+    lastDomain.clear();
+}
+
+
+void XCSP3WriterCallbacks::endVariableArray() {
+    // Sizes of the array from the ids of its variables
+    vector<int> sizes;
+    for(string &id : arrayVariables) {
+        unsigned int d = 0;
+        for(size_t pos = id.find('[', currentArray.size()) ; pos != string::npos ; pos = id.find('[', pos + 1), d++) {
+            int index = std::stoi(id.substr(pos + 1));
+            if(d == sizes.size())
+                sizes.push_back(0);
+            sizes[d] = std::max(sizes[d], index + 1);
+        }
+    }
+    long long nbCells = 1;
+    for(int size : sizes)
+        nbCells *= size;
+
+    writer.put("  <array id=\"", 13).put(currentArray).put("\" size=\"", 8);
+    for(int size : sizes)
+        writer.put('[').put((long long) size).put(']');
+    if(domains.size() == 1 && (long long) arrayVariables.size() == nbCells)
+        writer.put("\"> ", 3).put(domains[0]).put(" </array>\n", 10);
+    else {
+        writer.put("\">\n", 3);
+        vector<string> ids;
+        for(unsigned int d = 0 ; d < domains.size() ; d++) {
+            ids.clear();
+            for(unsigned int i = 0 ; i < arrayVariables.size() ; i++)
+                if(arrayDomains[i] == (int) d)
+                    ids.push_back(arrayVariables[i]);
+            writer.put("    <domain for=\"", 17);
+            writeIds(ids);
+            writer.put("\"> ", 3).put(domains[d]).put(" </domain>\n", 11);
+        }
+        writer.put("  </array>\n", 11);
+    }
+    currentArray.clear();
+    arrayVariables.clear();
+    arrayDomains.clear();
+    domains.clear();
+}
+
+
+void XCSP3WriterCallbacks::variable(string &id, bool interval, vector<int> &values) {
+    if(currentArray.empty()) {
+        text.clear();
+        if(interval) {
+            append(text, values[0]);
+            if(values[1] != values[0]) {
+                text += "..";
+                append(text, values[1]);
+            }
+        } else
+            appendRanges(text, values);
+        writer.put("  <var id=\"", 11).put(id).put("\"> ", 3).put(text).put(" </var>\n", 8);
+        return;
+    }
+
+    arrayVariables.push_back(id);
+    if(domains.empty() == false && interval == lastInterval && values == lastDomain) {  // Same domain as the previous variable
+        arrayDomains.push_back(arrayDomains.back());
+        return;
+    }
+    text.clear();
+    if(interval) {
+        append(text, values[0]);
+        if(values[1] != values[0]) {
+            text += "..";
+            append(text, values[1]);
+        }
+    } else
+        appendRanges(text, values);
+    lastDomain = values;
+    lastInterval = interval;
+    int d = domains.size() > MAX_SHARED_DOMAINS ? domains.size() : std::find(domains.begin(), domains.end(), text) - domains.begin();
+    if(d == (int) domains.size())
+        domains.push_back(text);
+    arrayDomains.push_back(d);
+}
+
+
+void XCSP3WriterCallbacks::buildVariableInteger(string id, int minValue, int maxValue) {
+    vector<int> bounds = {minValue, maxValue};
+    variable(id, true, bounds);
+}
+
+
+void XCSP3WriterCallbacks::buildVariableInteger(string id, vector<int> &values) {
+    vector<int> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+    variable(id, false, sorted);
+}
+
+
+//--------------------------------------------------------------------------------------
+// Generic constraints
+//--------------------------------------------------------------------------------------
+
+void XCSP3WriterCallbacks::buildConstraintExtension(string id, vector<XVariable *> list, vector<vector<int>> &tuples, bool support, bool hasStar) {
+    lastTuples.clear();
+    for(vector<int> &tuple : tuples) {
+        lastTuples += '(';
+        for(unsigned int i = 0 ; i < tuple.size() ; i++) {
+            if(i > 0)
+                lastTuples += ',';
+            if(tuple[i] == STAR)
+                lastTuples += '*';
+            else
+                append(lastTuples, tuple[i]);
+        }
+        lastTuples += ')';
+    }
+    buildConstraintExtensionAs(id, list, support, hasStar);
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintExtension(string id, XVariable *variable, vector<int> &tuples, bool support, bool) {
+    open("extension", id);
+    writer.put(" <list> ", 8).put(variable->id).put(" </list>", 8);
+    writer.put(support ? " <supports> " : " <conflicts> ");
+    writeRanges(tuples);
+    close(support ? "supports> </extension" : "conflicts> </extension");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintExtensionAs(string id, vector<XVariable *> list, bool support, bool) {
+    open("extension", id);
+    writeList("list", list);
+    writer.put(support ? " <supports> " : " <conflicts> ").put(lastTuples);
+    close(support ? "supports> </extension" : "conflicts> </extension");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintIntension(string id, string expr) {
+    open("intension", id);
+    writer.put(' ').put(expr);
+    close("intension");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintIntension(string id, Tree *tree) {
+    buildConstraintIntension(id, tree->toString());
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintInstantiation(string id, vector<XVariable *> &list, vector<int> &values) {
+    open("instantiation", id);
+    writeList("list", list);
+    writeList("values", values);
+    close("instantiation");
+}
+
+
+//--------------------------------------------------------------------------------------
+// Comparison constraints
+//--------------------------------------------------------------------------------------
+
+void XCSP3WriterCallbacks::buildConstraintAlldifferent(string id, vector<XVariable *> &list) {
+    open("allDifferent", id);
+    writer.put(' ');
+    writeList(list);
+    close("allDifferent");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintAlldifferent(string id, vector<Tree *> &list) {
+    open("allDifferent", id);
+    writer.put(' ');
+    writeList(list);
+    close("allDifferent");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintAlldifferentExcept(string id, vector<XVariable *> &list, vector<int> &except) {
+    open("allDifferent", id);
+    writeList("list", list);
+    writeList("except", except);
+    close("allDifferent");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintAlldifferentList(string id, vector<vector<XVariable *>> &lists) {
+    open("allDifferent", id);
+    for(vector<XVariable *> &list : lists)
+        writeList("list", list);
+    close("allDifferent");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintAlldifferentMatrix(string id, vector<vector<XVariable *>> &matrix) {
+    open("allDifferent", id);
+    writeMatrix("matrix", matrix);
+    close("allDifferent");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintAllEqual(string id, vector<XVariable *> &list) {
+    open("allEqual", id);
+    writer.put(' ');
+    writeList(list);
+    close("allEqual");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintAllEqual(string id, vector<Tree *> &list) {
+    open("allEqual", id);
+    writer.put(' ');
+    writeList(list);
+    close("allEqual");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintNotAllEqual(string id, vector<XVariable *> &list) {
+    open("nValues", id);
+    writeList("list", list);
+    writer.put(" <condition> (gt,1) </condition>");
+    close("nValues");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintOrdered(string id, vector<XVariable *> &list, OrderType order) {
+    open("ordered", id);
+    writeList("list", list);
+    writeOperator(order);
+    close("ordered");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintOrdered(string id, vector<XVariable *> &list, vector<int> &lengths, OrderType order) {
+    open("ordered", id);
+    writeList("list", list);
+    writeList("lengths", lengths);
+    writeOperator(order);
+    close("ordered");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintOrdered(string id, vector<XVariable *> &list, vector<XVariable *> &lengths, OrderType order) {
+    open("ordered", id);
+    writeList("list", list);
+    writeList("lengths", lengths);
+    writeOperator(order);
+    close("ordered");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintLex(string id, vector<vector<XVariable *>> &lists, OrderType order) {
+    open("lex", id);
+    for(vector<XVariable *> &list : lists)
+        writeList("list", list);
+    writeOperator(order);
+    close("lex");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintLexMatrix(string id, vector<vector<XVariable *>> &matrix, OrderType order) {
+    open("lex", id);
+    writeMatrix("matrix", matrix);
+    writeOperator(order);
+    close("lex");
+}
+
+
+//--------------------------------------------------------------------------------------
+// Counting and summing constraints
+//--------------------------------------------------------------------------------------
+
+void XCSP3WriterCallbacks::buildConstraintSum(string id, vector<XVariable *> &list, vector<int> &coeffs, XCondition &cond) {
+    open("sum", id);
+    writeList("list", list);
+    writeList("coeffs", coeffs);
+    writeCondition(cond);
+    close("sum");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintSum(string id, vector<XVariable *> &list, XCondition &cond) {
+    open("sum", id);
+    writeList("list", list);
+    writeCondition(cond);
+    close("sum");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintSum(string id, vector<XVariable *> &list, vector<XVariable *> &coeffs, XCondition &cond) {
+    open("sum", id);
+    writeList("list", list);
+    writeList("coeffs", coeffs);
+    writeCondition(cond);
+    close("sum");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintSum(string id, vector<Tree *> &trees, XCondition &cond) {
+    open("sum", id);
+    writeList("list", trees);
+    writeCondition(cond);
+    close("sum");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintSum(string id, vector<Tree *> &trees, vector<int> &coefs, XCondition &cond) {
+    open("sum", id);
+    writeList("list", trees);
+    writeList("coeffs", coefs);
+    writeCondition(cond);
+    close("sum");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCount(string id, vector<XVariable *> &list, vector<int> &values, XCondition &xc) {
+    open("count", id);
+    writeList("list", list);
+    writeList("values", values);
+    writeCondition(xc);
+    close("count");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCount(string id, vector<XVariable *> &list, vector<XVariable *> &values, XCondition &xc) {
+    open("count", id);
+    writeList("list", list);
+    writeList("values", values);
+    writeCondition(xc);
+    close("count");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCount(string id, vector<Tree *> &trees, vector<int> &values, XCondition &xc) {
+    open("count", id);
+    writeList("list", trees);
+    writeList("values", values);
+    writeCondition(xc);
+    close("count");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCount(string id, vector<Tree *> &trees, vector<XVariable *> &values, XCondition &xc) {
+    open("count", id);
+    writeList("list", trees);
+    writeList("values", values);
+    writeCondition(xc);
+    close("count");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintNValues(string id, vector<XVariable *> &list, vector<int> &except, XCondition &xc) {
+    open("nValues", id);
+    writeList("list", list);
+    writeList("except", except);
+    writeCondition(xc);
+    close("nValues");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintNValues(string id, vector<Tree *> &trees, XCondition &xc) {
+    open("nValues", id);
+    writeList("list", trees);
+    writeCondition(xc);
+    close("nValues");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintNValues(string id, vector<XVariable *> &list, XCondition &xc) {
+    open("nValues", id);
+    writeList("list", list);
+    writeCondition(xc);
+    close("nValues");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCardinality(string id, vector<XVariable *> &list, vector<int> values, vector<int> &occurs, bool closed) {
+    open("cardinality", id);
+    writeList("list", list);
+    writeCardinalityValues(closed);
+    writeList(values);
+    writer.put(" </values>");
+    writeList("occurs", occurs);
+    close("cardinality");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCardinality(string id, vector<XVariable *> &list, vector<int> values, vector<XVariable *> &occurs, bool closed) {
+    open("cardinality", id);
+    writeList("list", list);
+    writeCardinalityValues(closed);
+    writeList(values);
+    writer.put(" </values>");
+    writeList("occurs", occurs);
+    close("cardinality");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCardinality(string id, vector<XVariable *> &list, vector<int> values, vector<XInterval> &occurs, bool closed) {
+    open("cardinality", id);
+    writeList("list", list);
+    writeCardinalityValues(closed);
+    writeList(values);
+    writer.put(" </values> <occurs> ");
+    for(unsigned int i = 0 ; i < occurs.size() ; i++)
+        writer.put(i > 0 ? " " : "").put((long long) occurs[i].min).put("..", 2).put((long long) occurs[i].max);
+    writer.put(" </occurs>");
+    close("cardinality");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCardinality(string id, vector<XVariable *> &list, vector<XVariable *> values, vector<int> &occurs, bool closed) {
+    open("cardinality", id);
+    writeList("list", list);
+    writeCardinalityValues(closed);
+    writeList(values);
+    writer.put(" </values>");
+    writeList("occurs", occurs);
+    close("cardinality");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCardinality(string id, vector<XVariable *> &list, vector<XVariable *> values, vector<XVariable *> &occurs, bool closed) {
+    open("cardinality", id);
+    writeList("list", list);
+    writeCardinalityValues(closed);
+    writeList(values);
+    writer.put(" </values>");
+    writeList("occurs", occurs);
+    close("cardinality");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCardinality(string id, vector<XVariable *> &list, vector<XVariable *> values, vector<XInterval> &occurs, bool closed) {
+    open("cardinality", id);
+    writeList("list", list);
+    writeCardinalityValues(closed);
+    writeList(values);
+    writer.put(" </values> <occurs> ");
+    for(unsigned int i = 0 ; i < occurs.size() ; i++)
+        writer.put(i > 0 ? " " : "").put((long long) occurs[i].min).put("..", 2).put((long long) occurs[i].max);
+    writer.put(" </occurs>");
+    close("cardinality");
+}
+
+
+//--------------------------------------------------------------------------------------
+// Connection constraints
+//--------------------------------------------------------------------------------------
+
+void XCSP3WriterCallbacks::buildConstraintMinimum(string id, vector<XVariable *> &list, XCondition &xc) {
+    open("minimum", id);
+    writeList("list", list);
+    writeCondition(xc);
+    close("minimum");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintMinimum(string id, vector<Tree *> &list, XCondition &xc) {
+    open("minimum", id);
+    writeList("list", list);
+    writeCondition(xc);
+    close("minimum");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintMinimum(string id, vector<XVariable *> &list, XVariable *index, int startIndex, RankType rank, XCondition &xc) {
+    open("minimum", id);
+    writeList("list", list, startIndex);
+    writeIndex(index, rank);
+    writeCondition(xc);
+    close("minimum");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintMaximum(string id, vector<XVariable *> &list, XCondition &xc) {
+    open("maximum", id);
+    writeList("list", list);
+    writeCondition(xc);
+    close("maximum");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintMaximum(string id, vector<Tree *> &list, XCondition &xc) {
+    open("maximum", id);
+    writeList("list", list);
+    writeCondition(xc);
+    close("maximum");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintMaximum(string id, vector<XVariable *> &list, XVariable *index, int startIndex, RankType rank, XCondition &xc) {
+    open("maximum", id);
+    writeList("list", list, startIndex);
+    writeIndex(index, rank);
+    writeCondition(xc);
+    close("maximum");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintMaximumArg(string id, vector<XVariable *> &list, RankType rank, XCondition &xc) {
+    open("maximumArg", id, true);
+    writer.put(rank == ANY ? ">" : (rank == FIRST ? " rank=\"first\">" : " rank=\"last\">"));
+    writeList("list", list);
+    writeCondition(xc);
+    close("maximumArg");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintMaximumArg(string id, vector<Tree *> &list, RankType rank, XCondition &xc) {
+    open("maximumArg", id, true);
+    writer.put(rank == ANY ? ">" : (rank == FIRST ? " rank=\"first\">" : " rank=\"last\">"));
+    writeList("list", list);
+    writeCondition(xc);
+    close("maximumArg");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintMinimumArg(string id, vector<XVariable *> &list, RankType rank, XCondition &xc) {
+    open("minimumArg", id, true);
+    writer.put(rank == ANY ? ">" : (rank == FIRST ? " rank=\"first\">" : " rank=\"last\">"));
+    writeList("list", list);
+    writeCondition(xc);
+    close("minimumArg");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintMinimumArg(string id, vector<Tree *> &list, RankType rank, XCondition &xc) {
+    open("minimumArg", id, true);
+    writer.put(rank == ANY ? ">" : (rank == FIRST ? " rank=\"first\">" : " rank=\"last\">"));
+    writeList("list", list);
+    writeCondition(xc);
+    close("minimumArg");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintElement(string id, vector<XVariable *> &list, int value) {
+    open("element", id);
+    writeList("list", list);
+    writer.put(" <value> ", 9).put((long long) value).put(" </value>", 9);
+    close("element");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintElement(string id, vector<XVariable *> &list, XVariable *value) {
+    open("element", id);
+    writeList("list", list);
+    writer.put(" <value> ", 9);
+    writeValue(value);
+    writer.put(" </value>", 9);
+    close("element");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintElement(string id, vector<int> &list, XVariable *index, int startIndex, XCondition &xc) {
+    open("element", id);
+    writeList("list", list, startIndex);
+    writeIndex(index, ANY);
+    writeCondition(xc);
+    close("element");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintElement(string id, vector<XVariable *> &list, XVariable *index, int startIndex, XCondition &xc) {
+    open("element", id);
+    writeList("list", list, startIndex);
+    writeIndex(index, ANY);
+    writeCondition(xc);
+    close("element");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintElement(string id, vector<int> &list, int startIndex, XVariable *index, RankType rank, int value) {
+    open("element", id);
+    writeList("list", list, startIndex);
+    writeIndex(index, rank);
+    writer.put(" <value> ", 9).put((long long) value).put(" </value>", 9);
+    close("element");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintElement(string id, vector<XVariable *> &list, int startIndex, XVariable *index, RankType rank, int value) {
+    open("element", id);
+    writeList("list", list, startIndex);
+    writeIndex(index, rank);
+    writer.put(" <value> ", 9).put((long long) value).put(" </value>", 9);
+    close("element");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintElement(string id, vector<int> &list, int startIndex, XVariable *index, RankType rank, XVariable *value) {
+    open("element", id);
+    writeList("list", list, startIndex);
+    writeIndex(index, rank);
+    writer.put(" <value> ", 9);
+    writeValue(value);
+    writer.put(" </value>", 9);
+    close("element");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintElement(string id, vector<XVariable *> &list, int startIndex, XVariable *index, RankType rank, XVariable *value) {
+    open("element", id);
+    writeList("list", list, startIndex);
+    writeIndex(index, rank);
+    writer.put(" <value> ", 9);
+    writeValue(value);
+    writer.put(" </value>", 9);
+    close("element");
+}
+
+
+// <matrix startRowIndex=".." startColIndex="..">
+static const char *matrixAttributes(string &s, int startRowIndex, int startColIndex) {
+    s.clear();
+    if(startRowIndex != 0) {
+        s += " startRowIndex=\"";
+        append(s, startRowIndex);
+        s += '"';
+    }
+    if(startColIndex != 0) {
+        s += " startColIndex=\"";
+        append(s, startColIndex);
+        s += '"';
+    }
+    return s.c_str();
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintElement(string id, vector<vector<XVariable *> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex,
+                                                  XVariable *colIndex, XVariable *value) {
+    open("element", id);
+    writeMatrix("matrix", matrix, matrixAttributes(text, startRowIndex, startColIndex));
+    writer.put(" <index> ", 9).put(rowIndex->id).put(' ').put(colIndex->id).put(" </index> <value> ", 18);
+    writeValue(value);
+    writer.put(" </value>", 9);
+    close("element");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintElement(string id, vector<vector<XVariable *> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex,
+                                                  XVariable *colIndex, int value) {
+    open("element", id);
+    writeMatrix("matrix", matrix, matrixAttributes(text, startRowIndex, startColIndex));
+    writer.put(" <index> ", 9).put(rowIndex->id).put(' ').put(colIndex->id).put(" </index> <value> ", 18);
+    writer.put((long long) value).put(" </value>", 9);
+    close("element");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintElement(string id, vector<vector<int> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex,
+                                                  XVariable *colIndex, XVariable *value) {
+    open("element", id);
+    writeMatrix("matrix", matrix, matrixAttributes(text, startRowIndex, startColIndex));
+    writer.put(" <index> ", 9).put(rowIndex->id).put(' ').put(colIndex->id).put(" </index> <value> ", 18);
+    writeValue(value);
+    writer.put(" </value>", 9);
+    close("element");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintElement(string id, vector<vector<int> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex,
+                                                  XVariable *colIndex, XCondition &xc) {
+    open("element", id);
+    writeMatrix("matrix", matrix, matrixAttributes(text, startRowIndex, startColIndex));
+    writer.put(" <index> ", 9).put(rowIndex->id).put(' ').put(colIndex->id).put(" </index>", 9);
+    writeCondition(xc);
+    close("element");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintElement(string id, vector<vector<XVariable *> > &matrix, int startRowIndex, XVariable *rowIndex, int startColIndex,
+                                                  XVariable *colIndex, XCondition &xc) {
+    open("element", id);
+    writeMatrix("matrix", matrix, matrixAttributes(text, startRowIndex, startColIndex));
+    writer.put(" <index> ", 9).put(rowIndex->id).put(' ').put(colIndex->id).put(" </index>", 9);
+    writeCondition(xc);
+    close("element");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintChannel(string id, vector<XVariable *> &list, int startIndex) {
+    open("channel", id);
+    writeList("list", list, startIndex);
+    close("channel");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintChannel(string id, vector<XVariable *> &list1, int startIndex1, vector<XVariable *> &list2, int startIndex2) {
+    open("channel", id);
+    writeList("list", list1, startIndex1);
+    writeList("list", list2, startIndex2);
+    close("channel");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintChannel(string id, vector<XVariable *> &list, int startIndex, XVariable *value) {
+    open("channel", id);
+    writeList("list", list, startIndex);
+    writer.put(" <value> ", 9);
+    writeValue(value);
+    writer.put(" </value>", 9);
+    close("channel");
+}
+
+
+//--------------------------------------------------------------------------------------
+// Languages constraints
+//--------------------------------------------------------------------------------------
+
+void XCSP3WriterCallbacks::buildConstraintRegular(string id, vector<XVariable *> &list, int start, vector<int> &final, XAutomaton &automaton) {
+    open("regular", id);
+    writeList("list", list);
+    writeAutomaton(automaton);
+    writer.put(" <start> ", 9).put(automaton.states[start]).put(" </start> <final>", 17);
+    for(int f : final)
+        writer.put(' ').put(automaton.states[f]);
+    close("final> </regular");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintMDD(string id, vector<XVariable *> &list, XAutomaton &automaton) {
+    open("mdd", id);
+    writeList("list", list);
+    writeAutomaton(automaton);
+    close("mdd");
+}
+
+
+//--------------------------------------------------------------------------------------
+// Graph and scheduling constraints
+//--------------------------------------------------------------------------------------
+
+void XCSP3WriterCallbacks::buildConstraintCircuit(string id, vector<XVariable *> &list, int startIndex) {
+    open("circuit", id);
+    writeList("list", list, startIndex);
+    close("circuit");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintNoOverlap(string id, vector<XVariable *> &origins, vector<int> &lengths, bool zeroIgnored) {
+    open("noOverlap", id, true);
+    writer.put(zeroIgnored ? ">" : " zeroIgnored=\"false\">");
+    writeList("origins", origins);
+    writeList("lengths", lengths);
+    close("noOverlap");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintNoOverlap(string id, vector<XVariable *> &origins, vector<XVariable *> &lengths, bool zeroIgnored) {
+    open("noOverlap", id, true);
+    writer.put(zeroIgnored ? ">" : " zeroIgnored=\"false\">");
+    writeList("origins", origins);
+    writeList("lengths", lengths);
+    close("noOverlap");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintNoOverlap(string id, vector<vector<XVariable *>> &origins, vector<vector<int>> &lengths, bool zeroIgnored) {
+    open("noOverlap", id, true);
+    writer.put(zeroIgnored ? ">" : " zeroIgnored=\"false\">");
+    writeMatrix("origins", origins);
+    writeMatrix("lengths", lengths);
+    close("noOverlap");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintNoOverlap(string id, vector<vector<XVariable *>> &origins, vector<vector<XVariable *>> &lengths, bool zeroIgnored) {
+    open("noOverlap", id, true);
+    writer.put(zeroIgnored ? ">" : " zeroIgnored=\"false\">");
+    writeMatrix("origins", origins);
+    writeMatrix("lengths", lengths);
+    close("noOverlap");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<int> &lengths, vector<int> &heights, XCondition &xc) {
+    open("cumulative", id);
+    writeList("origins", origins);
+    writeList("lengths", lengths);
+    writeList("heights", heights);
+    writeCondition(xc);
+    close("cumulative");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<int> &lengths, vector<XVariable *> &varHeights, XCondition &xc) {
+    open("cumulative", id);
+    writeList("origins", origins);
+    writeList("lengths", lengths);
+    writeList("heights", varHeights);
+    writeCondition(xc);
+    close("cumulative");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<XVariable *> &lengths, vector<int> &heights, XCondition &xc) {
+    open("cumulative", id);
+    writeList("origins", origins);
+    writeList("lengths", lengths);
+    writeList("heights", heights);
+    writeCondition(xc);
+    close("cumulative");
+}
+
+
+void XCSP3WriterCallbacks::buildConstraintCumulative(string id, vector<XVariable *> &origins, vector<XVariable *> &lengths, vector<XVariable *> &heights, XCondition &xc) {
+    open("cumulative", id);
+    writeList("origins", origins);
+    writeList("lengths", lengths);
+    writeList("heights", heights);
+    writeCondition(xc);
+    close("cumulative");
+}
+
+
+//--------------------------------------------------------------------------------------
+// Objectives and annotations
+//--------------------------------------------------------------------------------------
+
+void XCSP3WriterCallbacks::buildObjectiveMinimizeExpression(string expr) {
+    writer.put("  <minimize> ", 13).put(expr).put(" </minimize>\n", 13);
+}
+
+
+void XCSP3WriterCallbacks::buildObjectiveMaximizeExpression(string expr) {
+    writer.put("  <maximize> ", 13).put(expr).put(" </maximize>\n", 13);
+}
+
+
+void XCSP3WriterCallbacks::buildObjectiveMinimizeVariable(XVariable *x) {
+    writer.put("  <minimize> ", 13).put(x->id).put(" </minimize>\n", 13);
+}
+
+
+void XCSP3WriterCallbacks::buildObjectiveMaximizeVariable(XVariable *x) {
+    writer.put("  <maximize> ", 13).put(x->id).put(" </maximize>\n", 13);
+}
+
+
+void XCSP3WriterCallbacks::buildObjectiveMinimize(ExpressionObjective type, vector<XVariable *> &list, vector<int> &coefs) {
+    writeObjective(true, type, list);
+    writeList("coeffs", coefs);
+    close("minimize");
+}
+
+
+void XCSP3WriterCallbacks::buildObjectiveMaximize(ExpressionObjective type, vector<XVariable *> &list, vector<int> &coefs) {
+    writeObjective(false, type, list);
+    writeList("coeffs", coefs);
+    close("maximize");
+}
+
+
+void XCSP3WriterCallbacks::buildObjectiveMinimize(ExpressionObjective type, vector<XVariable *> &list, vector<XVariable *> &coefs) {
+    writeObjective(true, type, list);
+    writeList("coeffs", coefs);
+    close("minimize");
+}
+
+
+void XCSP3WriterCallbacks::buildObjectiveMaximize(ExpressionObjective type, vector<XVariable *> &list, vector<XVariable *> &coefs) {
+    writeObjective(false, type, list);
+    writeList("coeffs", coefs);
+    close("maximize");
+}
+
+
+void XCSP3WriterCallbacks::buildObjectiveMinimize(ExpressionObjective type, vector<XVariable *> &list) {
+    writeObjective(true, type, list);
+    close("minimize");
+}
+
+
+void XCSP3WriterCallbacks::buildObjectiveMaximize(ExpressionObjective type, vector<XVariable *> &list) {
+    writeObjective(false, type, list);
+    close("maximize");
+}
+
+
+void XCSP3WriterCallbacks::buildObjectiveMinimize(ExpressionObjective type, vector<Tree *> &trees, vector<int> &coefs) {
+    writeObjective(true, type, trees);
+    writeList("coeffs", coefs);
+    close("minimize");
+}
+
+
+void XCSP3WriterCallbacks::buildObjectiveMaximize(ExpressionObjective type, vector<Tree *> &trees, vector<int> &coefs) {
+    writeObjective(false, type, trees);
+    writeList("coeffs", coefs);
+    close("maximize");
+}
+
+
+void XCSP3WriterCallbacks::buildObjectiveMinimize(ExpressionObjective type, vector<Tree *> &trees) {
+    writeObjective(true, type, trees);
+    close("minimize");
+}
+
+
+void XCSP3WriterCallbacks::buildObjectiveMaximize(ExpressionObjective type, vector<Tree *> &trees) {
+    writeObjective(false, type, trees);
+    close("maximize");
+}
+
+
+void XCSP3WriterCallbacks::buildAnnotationDecision(vector<XVariable *> &list) {
+    writer.put("  <decision> ", 13);
+    writeList(list);
+    writer.put(" </decision>\n", 13);
+}
@@ -27,6 +27,7 @@
 #include "XCSP3Variable.h"
 #include "XCSP3Constraint.h"
 #include "XMLParser.h"
+#include "XCSP3Profiler.h"
 
 using namespace XCSP3Core;
 
@@ -44,6 +45,37 @@ void XMLParser::startElement(UTF8String name, const AttributeList &attributes) {
         textLeft.clear();
     }
 
+    if(skipDepth > 0) {
+        // Inside a skipped section: only the constraints are reported, blocks are entered
+        skipDepth++;
+        if(skippedLevel == 0 && strcmp(actionStack.front()->getTagName(), "constraints") == 0 && name != "block") {
+            skippedLevel = skipDepth;
+            skippedBytes = 0;
+            name.to(skippedType);
+            skippedId.clear();
+            if(!attributes["id"].isNull())
+                attributes["id"].to(skippedId);
+        }
+        return;
+    }
+
+    if(discardedDepth > 0) {
+        discardedDepth++;
+        return;
+    }
+
+    // An element of the constraints section with a discarded class is not parsed
+    // (the constraint of a group is still read: the group needs it)
+    if(!actionStack.empty() && attributes["class"].isNull() == false &&
+       (strcmp(actionStack.front()->getTagName(), "constraints") == 0 || strcmp(actionStack.front()->getTagName(), "block") == 0)) {
+        string classes;
+        attributes["class"].to(classes);
+        if(manager->callback->discardedClasses(classes)) {
+            discardedDepth = 1;
+            return;
+        }
+    }
+
     if(!stateStack.empty() && !stateStack.front().subtagAllowed)
         throw runtime_error("this element must not contain any element");
 
@@ -66,7 +98,20 @@ void XMLParser::startElement(UTF8String name, const AttributeList &attributes) {
 
     stateStack.push_front(State());
     actionStack.push_front(action);
+    XCSP3_PROFILE_SCOPE(PROFILE_TAG, string("<") + action->getTagName() + ">");
+    // abort() is only called once beginTag is done: the actions allocate what abort() frees after
+    // anything that may throw in beginTag (the callbacks included), so a failed beginTag owns nothing
     action->beginTag(attributes);
+    stateStack.front().begun = true;
+}
+
+
+void XMLParser::abort() {
+    // The top of the stacks is freed first: a constraint of a group is owned by the group
+    for(unsigned int i = 0 ; i < actionStack.size() ; i++)
+        if(stateStack[i].begun)
+            actionStack[i]->abort();
+    clearStacks();
 }
 
 
@@ -77,10 +122,27 @@ void XMLParser::endElement(UTF8String name) {
         textLeft.clear();
     }
 
+    if(discardedDepth > 0) {
+        discardedDepth--;
+        return;
+    }
+
+    if(skipDepth > 1) {
+        if(skipDepth == skippedLevel) {
+            manager->callback->skippedConstraint(skippedId, skippedType, -1, skippedBytes);
+            skippedLevel = 0;
+        }
+        skipDepth--;
+        return;
+    }
+    skipDepth = 0;
+
     TagActionList::iterator iAction = tagList.find(name);
 
-    if(iAction != tagList.end())
+    if(iAction != tagList.end()) {
+        XCSP3_PROFILE_SCOPE(PROFILE_TAG, string("</") + (*iAction).second->getTagName() + ">");
         (*iAction).second->endTag();
+    }
 
     actionStack.pop_front();
     stateStack.pop_front();
@@ -97,6 +159,19 @@ void XMLParser::characters(UTF8String chars) {
             throw runtime_error("Text found outside any tag");
     }
 
+    if(discardedDepth > 0)
+        return;
+
+    if(skipText || skipDepth > 0) {
+        skippedBytes += chars.byteLength();
+        return;
+    }
+
+    if(chars.isAscii()) { // the same, with bytes
+        asciiCharacters(chars);
+        return;
+    }
+
     if(!textLeft.empty()) {
         // break at first space, concatenate with textLeft and call
         // text()
@@ -150,6 +225,42 @@ void XMLParser::characters(UTF8String chars) {
 }
 
 
+void XMLParser::asciiCharacters(UTF8String chars) {
+    typedef UTF8String::Byte Byte;
+    const Byte *p = chars.begin().getPointer(), *end = chars.end().getPointer();
+
+    if(!textLeft.empty()) {
+        // break at first space, concatenate with textLeft and call
+        // text()
+        bool tuples = dynamic_cast<ConflictOrSupportTagAction *>(actionStack.front()) != nullptr;
+        while(p != end && !UTF8String::isSpace(*p) && (tuples == false || *p != ')')) {
+            textLeft.append(*p);
+            ++p;
+        }
+        while(p != end && UTF8String::isSpace(*p)) {
+            textLeft.append(*p);
+            ++p;
+        }
+
+        handleAbridgedNotation(textLeft, false);
+        textLeft.clear();
+    }
+
+    // break after last space, call text() with the first part and
+    // store the last part in textLeft
+    const Byte *brk = end;
+    while(brk != p && !UTF8String::isSpace(brk[-1]))
+        --brk;
+
+    for(const Byte *q = brk ; q != end ; ++q)
+        textLeft.append(*q);
+
+    UTF8String text(p, brk);
+    if(!text.empty())
+        handleAbridgedNotation(text, false);
+}
+
+
 void XMLParser::handleAbridgedNotation(UTF8String chars, bool lastChunk) {
     UTF8String::iterator it, beg, end;
 
@@ -157,6 +268,10 @@ void XMLParser::handleAbridgedNotation(UTF8String chars, bool lastChunk) {
     beg = chars.begin();
     end = chars.end();
 
+    // only checks the UTF8 encoding, there is nothing to check in ASCII
+    if(chars.isAscii())
+        it = end;
+
     while(it != end) {
         // skip spaces
         while(it != end && it.isWhiteSpace())
@@ -171,8 +286,11 @@ void XMLParser::handleAbridgedNotation(UTF8String chars, bool lastChunk) {
             ++it;
     }
 
-    if(beg != end)
+    if(beg != end) {
+        XCSP3_PROFILE_SCOPE(PROFILE_TAG, string("<") + actionStack.front()->getTagName() + "> text");
+        XCSP3_PROFILE_BYTES(PROFILE_TAG, string("<") + actionStack.front()->getTagName() + "> text", chars.byteLength());
         actionStack.front()->text(chars.substr(beg, end), lastChunk);
+    }
 
 }
 
@@ -189,14 +307,15 @@ void XMLParser::parseSequence(const UTF8String &txt, vector<XVariable *> &list,
     for(char c : delimiters)
         tokenizer.addSeparator(c);
 
+    string current;
     while(tokenizer.hasMoreTokens()) {
 
         UTF8String token = tokenizer.nextToken();
+        token.to(current);
+        current = trim(current);
         bool isSep = false;
         for(unsigned int i = 0 ; i < delimiters.size() ; i++) {
-            string tt;
-            token.to(tt);
-            if(tt.size() == 1 && tt[0] == delimiters[i]) {
+            if(current.size() == 1 && current[0] == delimiters[i]) {
                 if(i == 0)
                     list.push_back(NULL);
                 isSep = true;
@@ -205,81 +324,62 @@ void XMLParser::parseSequence(const UTF8String &txt, vector<XVariable *> &list,
         if(isSep)
             continue;
 
-
-        string current, compactForm;
-        token.to(current);
-        current = trim(current);
-        size_t tree = current.find('(');
-        if(tree != string::npos) { // Tree expressions
-            list.push_back(new XTree(current));
-            continue;
-        }
-        if (current[0] == '{') {
-            list.push_back(new XSet(current));
-            continue;
-        }
-        size_t percent = current.find('%');
-        if(percent == string::npos) { // Normal variable
-            int pos = static_cast<int>(current.find('['));
-            if(pos == string::npos) { // Not an array
-                size_t dotdot = current.find('.');
-                if(dotdot == string::npos) {
-                    int nb;
-                    try { // An integer
-                        vector<string> compact;
-                        split(current, 'x', compact);
-                        if(compact.size() == 2) {
-                            nb = compact[0] == "*" ? STAR : std::stoi(compact[0]);
-                            int sz;
-                            sz = std::stoi(compact[1]);
-                            for(int k = 0; k < sz; k++) {
-                                XInteger *xi = new XInteger(compact[0], nb);
-                                list.push_back(xi);
-                            }
-                        } else {
-                            nb = std::stoi(current);
-                            XInteger *xi = new XInteger(current, nb);
-                            list.push_back(xi);
-                            toFree.push_back(xi);
-                        }
-                    } catch(invalid_argument &) {
-                        if(current == "*")
-                            list.push_back(new XInteger(current, STAR));
-                        else {
-                            if (variablesList[current] != NULL)
-                                list.push_back((XVariable *) variablesList[current]);
-                            else
-                                throw runtime_error("unknown variable: " + current);
-                        }
-                    }
-                } else { // A range
-                    int first = std::stoi(current.substr(0, dotdot));
-                    int last = std::stoi(current.substr(dotdot + 2));
-                    if(keepIntervals) {
-                        list.push_back(new XEInterval(current, first, last));
-                    } else {
-                        for(int i = first ; i <= last ; i++) {
-                            XInteger *xi = new XInteger(to_string(i), i);
-                            list.push_back(xi);
-                            toFree.push_back(xi);
-                        }
+        int first, second;
+        switch(classifyToken(current, first, second)) {
+            case TOKEN_TREE: // Tree expressions
+                list.push_back(constraintArena.make<XTree>(current));
+                break;
+            case TOKEN_SET:
+                list.push_back(constraintArena.make<XSet>(current));
+                break;
+            case TOKEN_PARAMETER: { // Parameter Variable form group template
+                XParameterVariable *xpv = constraintArena.make<XParameterVariable>(current);
+                if(xpv->number == -1) nbParameters = -1; else nbParameters++;
+                list.push_back(xpv);
+                break;
+            }
+            case TOKEN_ARRAY: {
+                size_t pos = current.find('[');
+                string name = current.substr(0, pos);
+                auto it = variablesList.find(name);
+                if(it == variablesList.end() || it->second == NULL)
+                    throw runtime_error("unknown variable: " + name);
+                ((XVariableArray *) it->second)->getVarsFor(list, current.data() + pos, current.size() - pos);
+                break;
+            }
+            case TOKEN_RANGE:
+                if(keepIntervals) {
+                    list.push_back(constraintArena.make<XEInterval>(current, first, second));
+                } else {
+                    for(int i = first ; i <= second ; i++) {
+                        XInteger *xi = XInteger::constant(i);
+                        list.push_back(xi != nullptr ? xi : constraintArena.make<XInteger>(to_string(i), i));
                     }
                 }
-            } else {
-                string name;
-                token.substr(0, pos).to(name);
-                token.substr(pos).to(compactForm);
-
-                if(variablesList[name] == NULL)
-                    throw runtime_error("unknown variable: " + name);
-                ((XVariableArray *) variablesList[name])->getVarsFor(list, compactForm);
+                break;
+            case TOKEN_COMPACT: { // first x second
+                string value = current.substr(0, current.find('x'));
+                XInteger *xi = XInteger::constant(first);
+                if(xi == nullptr || xi->id != value)
+                    xi = constraintArena.make<XInteger>(value, first);
+                list.insert(list.end(), second, xi);
+                break;
+            }
+            case TOKEN_INTEGER: {
+                XInteger *xi = XInteger::constant(first);
+                list.push_back(xi != nullptr && xi->id == current ? xi : constraintArena.make<XInteger>(current, first));
+                break;
+            }
+            case TOKEN_STAR:
+                list.push_back(constraintArena.make<XInteger>(current, STAR));
+                break;
+            case TOKEN_VARIABLE: { // Normal variable
+                auto it = variablesList.find(current);
+                if(it == variablesList.end() || it->second == NULL)
+                    throw runtime_error("unknown variable: " + current);
+                list.push_back((XVariable *) it->second);
+                break;
             }
-        } else {
-            // Parameter Variable form group template
-            XParameterVariable *xpv = new XParameterVariable(current);
-            if(xpv->number == -1) nbParameters = -1; else nbParameters++;
-            list.push_back(xpv);
-            toFree.push_back(xpv);
         }
     }
 
@@ -317,29 +417,39 @@ bool XMLParser::parseTuples(const UTF8String &txt, vector<vector<int> > &tuples)
 
 
 void XMLParser::parseDomain(const UTF8String &txt, XDomainInteger &domain) {
-    UTF8String::Tokenizer tokenizer(txt);
-    UTF8String dotdot("..");
-    while(tokenizer.hasMoreTokens()) {
-        UTF8String token = tokenizer.nextToken();
-        int pos = token.find(dotdot);
+    typedef UTF8String::Byte Byte;
+    // One pass on the bytes: integer (.. integer)? separated by spaces
+    const Byte *p = txt.begin().getPointer(), *end = txt.end().getPointer();
+    while(true) {
+        while(p != end && *p && UTF8String::isSpace(*p))
+            ++p;
+        if(p == end || *p == 0)
+            return;
 
-        if(pos == UTF8String::npos) {
-            int val;
-            if(false == token.to(val)) {
-                std::string ds;
-                txt.to(ds);
-                throw std::runtime_error("Integer expected: " + ds);
-            }
-            domain.addValue(val);
-        } else {
-            int first, last;
-            if((false == token.substr(0, pos).to(first)) || (false == token.substr(pos + 2).to(last))) {
-                std::string ds;
-                txt.to(ds);
-                throw std::runtime_error("Integer expected: " + ds);
+        const Byte *token = p;
+        while(p != end && *p && !UTF8String::isSpace(*p) && *p != '.')
+            ++p;
+        int first, last;
+        bool valid = parseInteger((const char *) token, (const char *) p, first);
+        if(valid && p != end && *p == '.') { // an interval
+            if(p + 1 != end && p[1] == '.') {
+                token = p += 2;
+                while(p != end && *p && !UTF8String::isSpace(*p))
+                    ++p;
+                valid = parseInteger((const char *) token, (const char *) p, last);
+            } else
+                valid = false;
+            if(valid) {
+                domain.addInterval(first, last);
+                continue;
             }
-            domain.addInterval(first, last);
         }
+        if(valid == false) {
+            std::string ds;
+            txt.to(ds);
+            throw std::runtime_error("Integer expected: " + ds);
+        }
+        domain.addValue(first);
     }
 }
 
@@ -358,9 +468,7 @@ void XMLParser::parseListOfIntegerOrInterval(const UTF8String &txt, vector<XInte
                 txt.to(ds);
                 throw std::runtime_error("Integer expected: " + ds);
             }
-            XIntegerValue *xv = new XIntegerValue(val);
-            listToFill.push_back(xv);
-            toFreeEntity.push_back(xv);
+            listToFill.push_back(constraintArena.make<XIntegerValue>(val));
         } else {
             int first, last;
             if((false == token.substr(0, pos).to(first)) || (false == token.substr(pos + 2).to(last))) {
@@ -368,9 +476,7 @@ void XMLParser::parseListOfIntegerOrInterval(const UTF8String &txt, vector<XInte
                 txt.to(ds);
                 throw std::runtime_error("Integer expected: " + ds);
             }
-            XIntegerInterval *xi = new XIntegerInterval(first, last);
-            listToFill.push_back(xi);
-            toFreeEntity.push_back(xi);
+            listToFill.push_back(constraintArena.make<XIntegerInterval>(first, last));
         }
     }
 }
@@ -383,6 +489,9 @@ void XMLParser::parseListOfIntegerOrInterval(const UTF8String &txt, vector<XInte
 
 XMLParser::XMLParser(XCSP3CoreCallbacks *cb) {
     keepIntervals = false;
+    skipText = false;
+    skipDepth = skippedLevel = discardedDepth = 0;
+    skippedBytes = 0;
     this->manager = new XCSP3Manager(cb, variablesList);
     unknownTagHandler = new UnknownTagAction(this, "unknown");
 
@@ -433,7 +542,7 @@ XMLParser::XMLParser(XCSP3CoreCallbacks *cb) {
     registerTagAction(tagList, new InstantiationTagAction(this, "instantiation"));
 
 
-    registerTagAction(tagList, new GroupTagAction(this, "group"));
+    registerTagAction(tagList, this->groupTag = new GroupTagAction(this, "group"));
     registerTagAction(tagList, new ArgsTagAction(this, "args"));
 
     registerTagAction(tagList, new MinMaxTagAction(this, "minimum"));
@@ -480,7 +589,7 @@ XMLParser::XMLParser(XCSP3CoreCallbacks *cb) {
     registerTagAction(tagList, new MatrixTagAction(this, "matrix"));
 
     registerTagAction(tagList, new BlockTagAction(this, "block"));
-    registerTagAction(tagList, new SlideTagAction(this, "slide"));
+    registerTagAction(tagList, this->slideTag = new SlideTagAction(this, "slide"));
 
     registerTagAction(tagList, new CircuitTagAction(this, "circuit"));
     registerTagAction(tagList, new ListOfVariablesOrIntegerTagAction(this, "size", this->values));
@@ -53,8 +53,6 @@ void XMLParser::InstanceTagAction::endTag() {
     this->parser->manager->endInstance();
     /*for(XEntity *xe : this->parser->toFree)
         delete xe;
-    for(XIntegerEntity *xe : this->parser->toFreeEntity)
-        delete xe;
     this->parser->toFree.clear();
     for(XDomainInteger *xdomain :this->parser->allDomains) {
         delete xdomain;
@@ -192,7 +190,6 @@ void XMLParser::ArrayTagAction::beginTag(const AttributeList &attributes) {
             continue;
         sizes.push_back(std::stoi(stringSize.substr(0, stringSize.size() - 1)));
     }
-    varArray = new XVariableArray(id, sizes);
 
 
 
@@ -212,6 +209,7 @@ void XMLParser::ArrayTagAction::beginTag(const AttributeList &attributes) {
     }
 
     this->parser->manager->beginVariableArray(id);
+    varArray = new XVariableArray(id, sizes);  // after anything that may throw (see XMLParser::startElement)
     varArray->classes = classes;
 }
 
@@ -278,38 +276,44 @@ void XMLParser::BasicConstraintTagAction::beginTag(const AttributeList &attribut
     group = nullptr;
     this->parser->star = false;
 
+    // The group or slide is found by comparing the parent tag actions (no string comparison)
+    TagAction *parent = this->parser->getParentTagAction();
+    TagAction *parent2 = this->parser->getParentTagAction(2);
+    TagAction *parent3 = this->parser->getParentTagAction(3);
+
     // Classic group
-    if(strcmp(this->parser->getParentTagAction()->getTagName(), "group") == 0)
-        group = ((XMLParser::GroupTagAction *) this->parser->getParentTagAction())->group;
+    if(parent == this->parser->groupTag)
+        group = ((XMLParser::GroupTagAction *) parent)->group;
 
     // Group with meta constraint not or block
-    if(strcmp(this->parser->getParentTagAction(2)->getTagName(), "group") == 0) {
-        group = ((XMLParser::GroupTagAction *) this->parser->getParentTagAction(2))->group;
+    if(parent2 == this->parser->groupTag) {
+        group = ((XMLParser::GroupTagAction *) parent2)->group;
         exit(1);
     }
 
     // Group with not and block
-    if(this->parser->getParentTagAction(3) != nullptr &&
-       strcmp(this->parser->getParentTagAction(3)->getTagName(), "group") == 0)
-        group = ((XMLParser::GroupTagAction *) this->parser->getParentTagAction(3))->group;
+    if(parent3 == this->parser->groupTag)
+        group = ((XMLParser::GroupTagAction *) parent3)->group;
 
 
     // Slide constraint (special cases of group without args)
-    if(strcmp(this->parser->getParentTagAction()->getTagName(), "slide") == 0)
-        group = ((XMLParser::SlideTagAction *) this->parser->getParentTagAction())->group;
+    if(parent == this->parser->slideTag)
+        group = ((XMLParser::SlideTagAction *) parent)->group;
 
     // Group with meta constraint not or block
-    if(strcmp(this->parser->getParentTagAction(2)->getTagName(), "slide") == 0) {
-        group = ((XMLParser::SlideTagAction *) this->parser->getParentTagAction(2))->group;
+    if(parent2 == this->parser->slideTag) {
+        group = ((XMLParser::SlideTagAction *) parent2)->group;
         exit(1);
     }
 
     // Group with not and block
-    if(this->parser->getParentTagAction(3) != nullptr &&
-       strcmp(this->parser->getParentTagAction(3)->getTagName(), "slide") == 0)
-        group = ((XMLParser::SlideTagAction *)
-                this->parser->getParentTagAction(3))->group;
+    if(parent3 == this->parser->slideTag)
+        group = ((XMLParser::SlideTagAction *) parent3)->group;
 
+    // Entities of the previous constraint are no longer used.
+    // Inside a group/slide, they must be kept: they may be part of its arguments
+    if(group == nullptr)
+        this->parser->constraintArena.reset();
 
     attributes["id"].to(id);
 
@@ -331,7 +335,7 @@ void XMLParser::BasicConstraintTagAction::beginTag(const AttributeList &attribut
     this->parser->widths.clear();
     this->parser->lengths.clear();
     this->parser->origins.clear();
-    this->parser->transitions.clear();
+    this->parser->automaton.clear();
     this->parser->nbParameters = 0;
     this->parser->occurs.clear();
     this->parser->limits.clear();
@@ -459,8 +463,7 @@ void XMLParser::RegularTagAction::endTag() {
     constraint->start = this->parser->start;
     constraint->final.clear();
     split(this->parser->final, ' ', constraint->final);
-
-    constraint->transitions.assign(this->parser->transitions.begin(), this->parser->transitions.end());
+    constraint->automaton = &this->parser->automaton;
 
     if(this->group == nullptr) {
         this->parser->manager->newConstraintRegular(constraint);
@@ -491,11 +494,7 @@ void XMLParser::MDDTagAction::beginTag(const AttributeList &attributes) {
 
 void XMLParser::MDDTagAction::endTag() {
     constraint->list.assign(this->parser->lists[0].begin(), this->parser->lists[0].end());
-    constraint->transitions.clear();
-    for(unsigned int i = 0 ; i < this->parser->transitions.size() ; i++) {
-        XTransition &xt = this->parser->transitions[i];
-        constraint->transitions.push_back(XTransition(xt.from, xt.val, xt.to));
-    }
+    constraint->automaton = &this->parser->automaton;
 
     if(this->group == nullptr) {
         this->parser->manager->newConstraintMDD(constraint);
@@ -914,6 +913,8 @@ void XMLParser::ElementTagAction::endTag() {
 
     XConstraintElementMatrix *c  = nullptr;
     if(this->parser->matrix.size() > 0) {
+        if(this->parser->index2 == nullptr)
+            throw runtime_error("<index> tag should have two values in element matrix");
         c = new XConstraintElementMatrix(this->id, this->parser->classes, this->parser->matrix);
         c->value = nullptr;
         if(this->parser->values.size() == 0)
@@ -922,8 +923,6 @@ void XMLParser::ElementTagAction::endTag() {
             c->value = this->parser->values[0];
         c->index = this->parser->index;
         c->rank = this->parser->rank;
-        if(this->parser->index2 == nullptr)
-            throw runtime_error("<index> tag should have two values in element matrix");
         c->index2 = this->parser->index2;
         c->startRowIndex = this->parser->startRowIndex;
         c->startColIndex = this->parser->startColIndex;
@@ -932,6 +931,7 @@ void XMLParser::ElementTagAction::endTag() {
             this->group->constraint = c;
         }
         delete constraint;
+        constraint = nullptr;
     }
 
 
@@ -1316,7 +1316,6 @@ void XMLParser::KnapsackTagAction::endTag() {
 
 // AttributeList &attributes
 void XMLParser::ObjectivesTagAction::beginTag(const AttributeList &) {
-    objective = new XObjective();
     this->parser->expr = "";
     this->checkParentTag("instance");
     this->parser->lists.clear();
@@ -1325,10 +1324,19 @@ void XMLParser::ObjectivesTagAction::beginTag(const AttributeList &) {
     this->parser->values.clear();
     this->parser->lists.push_back(vector<XVariable *>());
     this->parser->manager->beginObjectives();
+    objective = new XObjective();   // after anything that may throw (see XMLParser::startElement)
+    if(this->parser->manager->callback->skip & SKIP_OBJECTIVES)
+        this->parser->skipDepth = 1;
 }
 
 
 void XMLParser::ObjectivesTagAction::endTag() {
+    if(this->parser->manager->callback->skip & SKIP_OBJECTIVES) {
+        delete objective;
+        objective = nullptr;
+        this->parser->manager->endObjectives();
+        return;
+    }
     if(this->parser->expr != "")
         objective->expression = this->parser->expr;
 
@@ -1337,10 +1345,11 @@ void XMLParser::ObjectivesTagAction::endTag() {
     if(this->parser->values.size() > 0) {
         objective->coeffs.assign(this->parser->values.begin(), this->parser->values.end());
     } else if(objective->type != EXPRESSION_O) {
-        objective->coeffs.assign(objective->list.size(), new XInteger("1", 1));
+        objective->coeffs.assign(objective->list.size(), this->parser->documentArena.make<XInteger>("1", 1));
     }
     this->parser->manager->addObjective(objective);
     delete objective;
+    objective = nullptr;
     this->parser->manager->endObjectives();
 }
 
@@ -1491,7 +1500,7 @@ void XMLParser::ArgsTagAction::text(const UTF8String txt, bool) {
 void XMLParser::ArgsTagAction::endTag() {
     XConstraintGroup *group = ((GroupTagAction * )
     this->parser->getParentTagAction())->group;
-    group->arguments.push_back(vector<XVariable *>(this->parser->args.begin(), this->parser->args.end()));
+    group->arguments.addRow(this->parser->args);
 }
 
 
@@ -1666,6 +1675,18 @@ void XMLParser::ConflictOrSupportTagAction::beginTag(const AttributeList &) {
         support = false;
 
     ((XMLParser::ExtensionTagAction *) this->parser->getParentTagAction())->constraint->isSupport = support;
+    if(this->parser->manager->callback->skip & SKIP_TUPLES) {
+        this->parser->skipText = true;
+        this->parser->skippedBytes = 0;
+    }
+}
+
+
+void XMLParser::ConflictOrSupportTagAction::endTag() {
+    if(this->parser->skipText) {
+        ((XMLParser::ExtensionTagAction *) this->parser->getParentTagAction())->constraint->skippedBytes += this->parser->skippedBytes;
+        this->parser->skipText = false;
+    }
 }
 
 
@@ -1699,8 +1720,8 @@ void XMLParser::GroupTagAction::beginTag(const AttributeList &attributes) {
         attributes["class"].to(tmp);
 
 
-    group = new XConstraintGroup(lid, tmp);
     this->parser->manager->beginGroup(lid);
+    group = new XConstraintGroup(lid, tmp);     // after anything that may throw (see XMLParser::startElement)
     XParameterVariable::max = -1;
 }
 
@@ -1733,12 +1754,12 @@ void XMLParser::SlideTagAction::beginTag(const AttributeList &attributes) {
         attributes["class"].to(tmp);
 
 
-    group = new XConstraintGroup(lid, tmp);
     this->parser->lists.clear();
     this->parser->listTag->nbCallsToList = 0;
     this->parser->lists.push_back(vector<XVariable *>()); // Be careful, why not ?? see after revision e32b7f8
     list.clear();
     this->parser->manager->beginSlide(lid, circular);
+    group = new XConstraintGroup(lid, tmp);     // after anything that may throw (see XMLParser::startElement)
 }
 
 
@@ -1763,13 +1784,9 @@ void XMLParser::SlideTagAction::endTag() {
     } else
         arity = this->parser->nbParameters;
 
-    decltype(list.size()) end = circular ? list.size() - arity + 2 : list.size() - arity + 1;
-    for(decltype(end) i = 0 ; i < end ; i += offset) {
-        group->arguments.push_back(vector<XVariable *>());
-        for(unsigned int j = 0 ; j < arity ; j++) {
-            group->arguments.back().push_back(list[(i + j) % list.size()]);
-        }
-    }
+    if(offset < 1)
+        throw runtime_error("The offset of a slide must be positive");
+    group->arguments.setSlide(list, arity, offset, circular);
 
     this->parser->manager->newConstraintGroup(group);
 
@@ -1950,41 +1967,68 @@ void XMLParser::MatrixTagAction::endTag() {
 
 // AttributeList &attributes
 void XMLParser::TransitionsTagAction::beginTag(const AttributeList &) {
-    nb = 0;
-    transitions.clear();
+    nb = -1;
+    token.clear();
+}
+
+
+// Transitions are scanned byte per byte as they arrive: states are interned on the fly
+// and a transition may be split between two chunks.
+void XMLParser::TransitionsTagAction::text(const UTF8String txt, bool) {
+    XAutomaton &automaton = this->parser->automaton;
+    buffer.clear();
+    txt.appendTo(buffer);
+    for(char c : buffer) {
+        switch(c) {
+            case ' ' :
+            case '\t' :
+            case '\n' :
+            case '\r' :
+                break;
+            case '(' :
+                if(nb != -1)
+                    throw runtime_error("<transitions> tag is malformed");
+                nb = 0;
+                break;
+            case ',' :
+                if(nb == 0)
+                    from = automaton.state(token);
+                else if(nb == 1) {
+                    size_t pos = (!token.empty() && (token[0] == '-' || token[0] == '+')) ? 1 : 0;
+                    if(pos == token.size())
+                        throw runtime_error("<transitions> tag is malformed: " + token + " is not a value");
+                    val = 0;
+                    for(; pos < token.size() ; pos++) {
+                        if(token[pos] < '0' || token[pos] > '9')
+                            throw runtime_error("<transitions> tag is malformed: " + token + " is not a value");
+                        val = val * 10 + (token[pos] - '0');
+                    }
+                    if(token[0] == '-')
+                        val = -val;
+                } else
+                    throw runtime_error("<transitions> tag is malformed");
+                nb++;
+                token.clear();
+                break;
+            case ')' :
+                if(nb != 2 || token.empty())
+                    throw runtime_error("<transitions> tag is malformed");
+                automaton.addTransition(from, val, automaton.state(token));
+                nb = -1;
+                token.clear();
+                break;
+            default :
+                if(nb == -1)
+                    throw runtime_error("<transitions> tag is malformed");
+                token += c;
+        }
+    }
 }
 
-void XMLParser::TransitionsTagAction::text(const UTF8String txt, bool last) {
-    if(txt.isWhiteSpace())
-        return;
-    transitions.append(txt);
-}
 
-// UTF8String txt, bool last
 void XMLParser::TransitionsTagAction::endTag() {
-    UTF8String::Tokenizer tokenizer(transitions);
-    tokenizer.addSeparator(')');
-    tokenizer.addSeparator(',');
-    tokenizer.addSeparator('(');
-    // nb = 0 : from nb=1 : val nb=2 to
-    while(tokenizer.hasMoreTokens()) {
-        UTF8String token = tokenizer.nextToken();
-        if(token == UTF8String(",")) continue;
-        if(token == UTF8String("(")) {
-            nb = 0; //Start
-            continue;
-        }
-        if(token == UTF8String(")")) {
-            assert(from != "");
-            this->parser->transitions.push_back(XTransition(from, val, to));
-            continue;
-        }
-        if(nb == 0) token.to(from);
-        if(nb == 1) token.to(val);
-        if(nb == 2) token.to(to);
-        if(nb > 2) throw runtime_error("<transitions> tag is malformed");
-        nb++;
-    }
+    if(nb != -1)
+        throw runtime_error("<transitions> tag is malformed");
 }
 
 